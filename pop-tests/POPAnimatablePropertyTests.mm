@@ -9,11 +9,81 @@
 
 #import <XCTest/XCTest.h>
 
+#import <atomic>
+#import <vector>
+
 #import <pop/POPAnimatableProperty.h>
+#import <pop/POPBasicAnimation.h>
+
+#import "TransformationMatrix.h"
+
+using namespace WebCore;
 
 static const CGFloat epsilon = 0.0001f;
 static NSArray *properties = @[@"name", @"readBlock", @"writeBlock", @"threshold"];
 
+static const NSUInteger kTransformSampleCount = 10000;
+
+// random 2D affine matrices, a fifth of them singular, mirrored or built from components; deterministic. Singular
+// matrices have a zero row, as the determinant of dependent rows need not round to zero under FMA contraction
+static TransformationMatrix randomAffineMatrix(unsigned short seed[3])
+{
+  double a = erand48(seed) * 6 - 3, b = erand48(seed) * 6 - 3, c = erand48(seed) * 6 - 3, d = erand48(seed) * 6 - 3;
+  double tx = erand48(seed) * 600 - 300, ty = erand48(seed) * 600 - 300;
+  switch (nrand48(seed) % 5) {
+    case 0:
+      return TransformationMatrix(a, b, 0, 0, tx, ty);
+    case 1:
+      return TransformationMatrix(a, b, c, d, tx, ty).scaleNonUniform(-1, 1);
+    case 2: {
+      TransformationMatrix m;
+      m.translate(tx, ty).rotate3d(0, 0, 1, a * 60).scaleNonUniform(c, d);
+      return m;
+    }
+    default:
+      return TransformationMatrix(a, b, c, d, tx, ty);
+  }
+}
+
+static void assertDecompositionEqual(id self, const TransformationMatrix::DecomposedType &d1, const TransformationMatrix::DecomposedType &d2)
+{
+  const double *f1 = (const double *)&d1;
+  const double *f2 = (const double *)&d2;
+  for (size_t idx = 0; idx < sizeof(d1) / sizeof(double); idx++) {
+    XCTAssertEqualWithAccuracy(f1[idx], f2[idx], 1e-12, @"unexpected decomposition field %zu", idx);
+  }
+}
+
+static void assertMatrixEqual(id self, const TransformationMatrix &m1, const TransformationMatrix &m2)
+{
+  CATransform3D t1 = m1.transform3d();
+  CATransform3D t2 = m2.transform3d();
+  const CGFloat *f1 = (const CGFloat *)&t1;
+  const CGFloat *f2 = (const CGFloat *)&t2;
+  for (size_t idx = 0; idx < 16; idx++) {
+    XCTAssertEqualWithAccuracy(f1[idx], f2[idx], 1e-5 * MAX(fabs(f1[idx]), 1.), @"unexpected matrix element %zu", idx);
+  }
+}
+
+// random 4x4 matrices, including perspective; deterministic
+static void randomMatrix4(unsigned short seed[3], TransformationMatrix::Matrix4 &m)
+{
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 4; j++) {
+      m[i][j] = erand48(seed) * 4 - 2;
+    }
+  }
+}
+
+static void assertMatrix4Equal(id self, const TransformationMatrix::Matrix4 &m1, const TransformationMatrix::Matrix4 &m2, double accuracy)
+{
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 4; j++) {
+      XCTAssertEqualWithAccuracy(m1[i][j], m2[i][j], accuracy * MAX(fabs(m2[i][j]), 1.), @"unexpected matrix element %d%d", i, j);
+    }
+  }
+}
+
 static void assertPropertyEqual(id self, POPAnimatableProperty *prop1, POPAnimatableProperty *prop2)
 {
   for (NSString *property in properties) {
@@ -88,6 +158,22 @@ static void assertPropertyEqual(id self, POPAnimatableProperty *prop1, POPAnimat
   }
 }
 
+- (void)testStaticLookup
+{
+  NSArray *names = @[kPOPLayerBounds, kPOPLayerPosition, kPOPLayerRotation, kPOPLayerRotationX, kPOPLayerRotationY, kPOPLayerScaleX, kPOPLayerScaleY, kPOPLayerScaleXY, kPOPShapeLayerStrokeEnd];
+  for (NSString *name in names) {
+    // equal names built at runtime find the same property
+    POPAnimatableProperty *prop = [POPAnimatableProperty propertyWithName:[NSMutableString stringWithString:name]];
+    XCTAssertEqualObjects(prop.name, name);
+    XCTAssertEqual(prop, [POPAnimatableProperty propertyWithName:name]);
+  }
+
+  // names outside the table, including prefixes and extensions of static names, are not found
+  for (NSString *name in @[@"", @"layer", @"layer.position.", @"layer.positio", @"view.unknown"]) {
+    XCTAssertNil([POPAnimatableProperty propertyWithName:name], @"unexpected property %@", name);
+  }
+}
+
 - (void)testUserCreation
 {
   static NSString *name = @"lalalala";
@@ -104,6 +190,118 @@ static void assertPropertyEqual(id self, POPAnimatableProperty *prop1, POPAnimat
   XCTAssertEqualWithAccuracy(threshold, prop.threshold, epsilon, @"property threshold %f should equal %f", prop.threshold, threshold);
 }
 
+- (void)testCustomPropertyCaching
+{
+  __block NSUInteger initializerCount = 0;
+  void (^initializer)(POPMutableAnimatableProperty *) = ^(POPMutableAnimatableProperty *p){
+    initializerCount++;
+    p.threshold = 0.5;
+  };
+
+  POPAnimatableProperty *prop = [POPAnimatableProperty propertyWithName:@"com.facebook.pop.test.cached" initializer:initializer];
+  XCTAssertTrue(prop == [POPAnimatableProperty propertyWithName:@"com.facebook.pop.test.cached" initializer:initializer]);
+  XCTAssertTrue(prop == [POPAnimatableProperty propertyWithName:@"com.facebook.pop.test.cached"]);
+  XCTAssertEqual(initializerCount, (NSUInteger)1);
+  XCTAssertEqualWithAccuracy(prop.threshold, 0.5, epsilon);
+}
+
+- (void)testCustomPropertyAnimationsKeepTheirBlocks
+{
+  // animations of equally named custom properties each write through their own block
+  __block CGFloat value1 = 0;
+  __block CGFloat value2 = 0;
+  POPPropertyAnimation *anim1 = [POPBasicAnimation animationWithCustomPropertyNamed:@"com.facebook.pop.test.custom" readBlock:^(id obj, CGFloat values[]) {
+    values[0] = value1;
+  } writeBlock:^(id obj, const CGFloat values[]) {
+    value1 = values[0];
+  }];
+  POPPropertyAnimation *anim2 = [POPBasicAnimation animationWithCustomPropertyNamed:@"com.facebook.pop.test.custom" readBlock:^(id obj, CGFloat values[]) {
+    values[0] = value2;
+  } writeBlock:^(id obj, const CGFloat values[]) {
+    value2 = values[0];
+  }];
+  XCTAssertFalse(anim1.property == anim2.property);
+
+  CGFloat values[1] = {1};
+  anim1.property.writeBlock(nil, values);
+  values[0] = 2;
+  anim2.property.writeBlock(nil, values);
+  XCTAssertEqual(value1, (CGFloat)1);
+  XCTAssertEqual(value2, (CGFloat)2);
+
+  // neither named nor anonymous custom properties are cached
+  POPPropertyAnimation *anonymous = [POPBasicAnimation animationWithCustomPropertyReadBlock:^(id obj, CGFloat values[]) {
+  } writeBlock:^(id obj, const CGFloat values[]) {
+  }];
+  XCTAssertNil([POPAnimatableProperty propertyWithName:@"com.facebook.pop.test.custom"]);
+  XCTAssertNil([POPAnimatableProperty propertyWithName:anonymous.property.name]);
+
+  // common properties are still shared
+  POPPropertyAnimation *common = [POPBasicAnimation animationWithCustomPropertyNamed:kPOPLayerOpacity readBlock:NULL writeBlock:NULL];
+  XCTAssertTrue(common.property == [POPAnimatableProperty propertyWithName:kPOPLayerOpacity]);
+}
+
+- (void)testConcurrentPropertyLookup
+{
+  // static and custom properties, first looked up from many threads at once, grow the cache as they race
+  NSString *prefix = [NSString stringWithFormat:@"com.facebook.pop.test.%@.", [NSUUID UUID].UUIDString];
+  NSMutableArray *names = [NSMutableArray arrayWithArray:@[kPOPLayerBounds, kPOPLayerOpacity, kPOPLayerPosition, kPOPLayerRotation, kPOPLayerScaleXY]];
+  for (NSUInteger idx = 0; idx < 500; idx++) {
+    [names addObject:[prefix stringByAppendingFormat:@"%lu", (unsigned long)idx]];
+  }
+
+  const NSUInteger count = names.count;
+  std::vector<std::atomic<void *>> first(count);
+  for (std::atomic<void *> &p : first) {
+    p = NULL;
+  }
+  std::atomic<NSUInteger> mismatches(0);
+  std::vector<std::atomic<void *>> *firstRef = &first;
+  std::atomic<NSUInteger> *mismatchesRef = &mismatches;
+
+  dispatch_apply(16, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t thread) {
+    for (NSUInteger pass = 0; pass < 20; pass++) {
+      for (NSUInteger idx = 0; idx < count; idx++) {
+        NSUInteger nameIdx = (idx * 7 + thread * 31) % count;
+        NSString *name = names[nameIdx];
+        POPAnimatableProperty *prop = [POPAnimatableProperty propertyWithName:name initializer:^(POPMutableAnimatableProperty *p){
+          p.threshold = 0.25;
+        }];
+
+        // every thread sees one property per name
+        void *expected = NULL;
+        if (![prop.name isEqualToString:name] || (!(*firstRef)[nameIdx].compare_exchange_strong(expected, (__bridge void *)prop) && expected != (__bridge void *)prop)) {
+          (*mismatchesRef)++;
+        }
+      }
+    }
+  });
+
+  XCTAssertEqual(mismatches.load(), (NSUInteger)0);
+  for (NSUInteger idx = 0; idx < count; idx++) {
+    XCTAssertEqual((__bridge void *)[POPAnimatableProperty propertyWithName:names[idx]], first[idx].load());
+  }
+}
+
+- (void)testPropertyLookupPerformance
+{
+  // 100k cached lookups per iteration, split across threads; lookups per second is 100k over the reported time
+  NSArray *names = @[kPOPLayerBounds, kPOPLayerOpacity, kPOPLayerPosition, kPOPLayerRotation, kPOPLayerScaleXY, @"com.facebook.pop.test.lookup"];
+  for (NSString *name in names) {
+    [POPAnimatableProperty propertyWithName:name initializer:^(POPMutableAnimatableProperty *p){}];
+  }
+
+  [self measureBlock:^{
+    dispatch_apply(4, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t thread) {
+      NSUInteger found = 0;
+      for (NSUInteger idx = 0; idx < 25000; idx++) {
+        found += nil != [POPAnimatableProperty propertyWithName:names[idx % names.count]];
+      }
+      XCTAssertEqual(found, (NSUInteger)25000);
+    });
+  }];
+}
+
 - (void)testClassCluster
 {
   POPAnimatableProperty *instance1 = [[POPAnimatableProperty alloc] init];
@@ -115,6 +313,134 @@ static void assertPropertyEqual(id self, POPAnimatableProperty *prop1, POPAnimat
   }
 }
 
+- (void)testAffineDecompositionMatchesGeneral
+{
+  unsigned short seed[3] = {1, 2, 3};
+  for (NSUInteger idx = 0; idx < kTransformSampleCount; idx++) {
+    TransformationMatrix m = randomAffineMatrix(seed);
+    XCTAssertTrue(m.isAffine());
+
+    TransformationMatrix::DecomposedType affine, general;
+    bool decomposed = m.decompose(affine);
+    XCTAssertEqual(decomposed, m.decomposeGeneral(general));
+    if (!decomposed) {
+      continue;
+    }
+    assertDecompositionEqual(self, affine, general);
+
+    // both rotation forms recompose as the general path does, and round trip
+    for (int useEulerAngle = 0; useEulerAngle < 2; useEulerAngle++) {
+      TransformationMatrix r1, r2;
+      r1.recompose(affine, useEulerAngle);
+      r2.recomposeGeneral(affine, useEulerAngle);
+      assertMatrixEqual(self, r1, r2);
+    }
+    TransformationMatrix r;
+    r.recompose(affine);
+    assertMatrixEqual(self, r, m);
+  }
+
+  // perspective and 3D decompositions take the general path
+  TransformationMatrix p;
+  p.applyPerspective(500).rotate3d(1, 0, 0, 30);
+  XCTAssertFalse(p.isAffine());
+  TransformationMatrix::DecomposedType d1, d2;
+  XCTAssertTrue(p.decompose(d1) && p.decomposeGeneral(d2));
+  assertDecompositionEqual(self, d1, d2);
+  TransformationMatrix r1, r2;
+  r1.recompose(d1);
+  r2.recomposeGeneral(d1);
+  assertMatrixEqual(self, r1, r2);
+}
+
+- (void)testAffineDecompositionPerformance
+{
+  // decompose and recompose of layer transforms; compare against decomposeGeneral and recomposeGeneral
+  unsigned short seed[3] = {1, 2, 3};
+  std::vector<TransformationMatrix> matrices;
+  for (NSUInteger idx = 0; idx < 1000; idx++) {
+    TransformationMatrix m;
+    m.translate(erand48(seed) * 100, erand48(seed) * 100).rotate3d(0, 0, 1, erand48(seed) * 360).scaleNonUniform(0.5 + erand48(seed), 0.5 + erand48(seed));
+    matrices.push_back(m);
+  }
+
+  [self measureBlock:^{
+    double sum = 0;
+    for (NSUInteger pass = 0; pass < 100; pass++) {
+      for (const TransformationMatrix &m : matrices) {
+        TransformationMatrix::DecomposedType d;
+        m.decompose(d);
+        d.scaleX *= 1.01;
+        TransformationMatrix r;
+        r.recompose(d);
+        sum += r.m11();
+      }
+    }
+    XCTAssertTrue(isfinite(sum));
+  }];
+}
+
+- (void)testMatrixKernelsMatchScalar
+{
+  unsigned short seed[3] = {1, 2, 3};
+  for (NSUInteger idx = 0; idx < kTransformSampleCount; idx++) {
+    TransformationMatrix::Matrix4 a, b, r1, r2;
+    randomMatrix4(seed, a);
+    randomMatrix4(seed, b);
+
+    // products and maps sum in the scalar order, up to contraction of the scalar code; transposes move elements
+    TransformationMatrix::multiplyMatrix4(a, b, r1);
+    TransformationMatrix::multiplyMatrix4Scalar(a, b, r2);
+    assertMatrix4Equal(self, r1, r2, 1e-12);
+
+    TransformationMatrix::transposeMatrix4(a, r1);
+    TransformationMatrix::transposeMatrix4Scalar(a, r2);
+    assertMatrix4Equal(self, r1, r2, 0);
+
+    double p[4] = {erand48(seed) * 100, erand48(seed) * 100, erand48(seed) * 100, 1}, q1[4], q2[4];
+    TransformationMatrix::mapPoint4(p, a, q1);
+    TransformationMatrix::mapPoint4Scalar(p, a, q2);
+    for (int i = 0; i < 4; i++) {
+      XCTAssertEqualWithAccuracy(q1[i], q2[i], 1e-12 * MAX(fabs(q2[i]), 1.));
+    }
+
+    // inverses round differently, by up to about 1e-10 relative over many samples
+    bool inverted = TransformationMatrix::inverseMatrix4(a, r1);
+    XCTAssertEqual(inverted, TransformationMatrix::inverseMatrix4Scalar(a, r2));
+    if (inverted) {
+      assertMatrix4Equal(self, r1, r2, 1e-6);
+    }
+  }
+
+  // singular matrices report as the scalar version does
+  TransformationMatrix::Matrix4 s = {{1, 2, 3, 4}, {2, 4, 6, 8}, {0, 0, 1, 0}, {0, 0, 0, 1}}, r1, r2;
+  XCTAssertFalse(TransformationMatrix::inverseMatrix4(s, r1));
+  XCTAssertFalse(TransformationMatrix::inverseMatrix4Scalar(s, r2));
+  assertMatrix4Equal(self, r1, r2, 0);
+}
+
+- (void)testMatrixKernelPerformance
+{
+  // products and inverses of 4x4 matrices; build with POP_TRANSFORM_NO_SIMD to compare against the scalar kernels
+  unsigned short seed[3] = {1, 2, 3};
+  std::vector<TransformationMatrix> matrices(1000);
+  for (TransformationMatrix &m : matrices) {
+    m.applyPerspective(500).rotate3d(erand48(seed), erand48(seed), erand48(seed), erand48(seed) * 360).translate3d(erand48(seed) * 100, erand48(seed) * 100, erand48(seed) * 100);
+  }
+
+  [self measureBlock:^{
+    double sum = 0;
+    for (NSUInteger pass = 0; pass < 100; pass++) {
+      TransformationMatrix product;
+      for (const TransformationMatrix &m : matrices) {
+        product = m.inverse().multiply(m);
+        sum += product.m11();
+      }
+    }
+    XCTAssertTrue(isfinite(sum));
+  }];
+}
+
 - (void)testCopying
 {
   // instance
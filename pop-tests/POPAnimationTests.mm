@@ -23,9 +23,78 @@
 #import "POPBaseAnimationTests.h"
 #import "POPCGUtils.h"
 #import "POPAnimationInternal.h"
+#import "POPKeyframeTrack.h"
+
+#import <atomic>
+#import <new>
+
+#import <dlfcn.h>
+#import <execinfo.h>
+#import <pthread.h>
 
 using namespace POP;
 
+// malloc stack logging hook of libmalloc, called for every allocation while set
+typedef void (malloc_logger_t)(uint32_t type, uintptr_t arg1, uintptr_t arg2, uintptr_t arg3, uintptr_t result, uint32_t num_hot_frames_to_skip);
+extern "C" malloc_logger_t *malloc_logger;
+static const uint32_t kPOPMallocLogTypeAllocate = 2;
+
+static std::atomic<size_t> _allocationCount(0);
+static pthread_t _allocationThread;
+static const void *_allocationImages[4];
+
+static const void *imageBase(const void *address)
+{
+  Dl_info info;
+  return 0 != dladdr(address, &info) ? info.dli_fbase : NULL;
+}
+
+static void countAllocation(uint32_t type, uintptr_t arg1, uintptr_t arg2, uintptr_t arg3, uintptr_t result, uint32_t num_hot_frames_to_skip)
+{
+  static __thread bool counting = false;
+  if (0 == (type & kPOPMallocLogTypeAllocate) || counting || !pthread_equal(pthread_self(), _allocationThread)) {
+    return;
+  }
+  counting = true;
+
+  // attribute the allocation to its first caller outside malloc and operator new
+  void *frames[16];
+  int frameCount = backtrace(frames, POP_ARRAY_COUNT(frames));
+  for (int idx = 1; idx < frameCount; idx++) {
+    const void *image = imageBase(frames[idx]);
+    if (image == _allocationImages[1] || image == _allocationImages[2] || image == _allocationImages[3]) {
+      continue;
+    }
+    if (image == _allocationImages[0]) {
+      _allocationCount++;
+    }
+    break;
+  }
+  counting = false;
+}
+
+/**
+ Counts heap allocations made directly by pop code on the calling thread until the matching end call: malloc,
+ calloc, realloc and every form of operator new. Objects allocated through the Objective-C runtime or system
+ frameworks are not attributed to pop, nor is anything allocated before the call or on other threads.
+ */
+static void POPBeginCountingAllocations()
+{
+  _allocationImages[0] = imageBase((__bridge void *)[POPAnimator class]);
+  _allocationImages[1] = imageBase((void *)&malloc);
+  _allocationImages[2] = imageBase((void *)static_cast<void *(*)(size_t)>(&::operator new));
+  _allocationImages[3] = imageBase((void *)static_cast<void *(*)(size_t)>(&::operator new[]));
+  _allocationThread = pthread_self();
+  _allocationCount = 0;
+  malloc_logger = countAllocation;
+}
+
+static size_t POPEndCountingAllocations()
+{
+  malloc_logger = NULL;
+  return _allocationCount;
+}
+
 @interface POPAnimation (TestExtensions)
 @property (strong, nonatomic) NSString *sampleKey;
 @end
@@ -82,6 +151,50 @@ using namespace POP;
   XCTAssertTrue(1 == [layer2 pop_animationKeys].count);
 }
 
+- (void)testKeyLookupAndAnonymousKeys
+{
+  CALayer *layer1 = self.layer1;
+  [layer1 pop_removeAllAnimations];
+
+  // keys match by value, not pointer
+  POPAnimation *anim = FBTestLinearPositionAnimation(self.beginTime);
+  [layer1 pop_addAnimation:anim forKey:[NSMutableString stringWithString:@"hello"]];
+  XCTAssertTrue(anim == [layer1 pop_animationForKey:@"hello"]);
+  XCTAssertTrue(anim == [layer1 pop_animationForKey:[@"hel" stringByAppendingString:@"lo"]]);
+  XCTAssertNil([layer1 pop_animationForKey:@"world"]);
+
+  // mutated keys match by their new value
+  NSMutableString *key = [NSMutableString stringWithString:@"hello"];
+  XCTAssertTrue(anim == [layer1 pop_animationForKey:key]);
+  [key setString:@"world"];
+  XCTAssertNil([layer1 pop_animationForKey:key]);
+  XCTAssertTrue(anim == [layer1 pop_animationForKey:@"hello"]);
+
+  // nil keys are distinct, named on request and removable by name
+  for (NSUInteger idx = 0; idx < 10; idx++) {
+    [layer1 pop_addAnimation:FBTestLinearPositionAnimation(self.beginTime) forKey:nil];
+  }
+  NSArray *keys = [layer1 pop_animationKeys];
+  XCTAssertEqual([NSSet setWithArray:keys].count, (NSUInteger)11);
+  XCTAssertEqualObjects(keys, [layer1 pop_animationKeys]);
+
+  for (NSString *key in keys) {
+    if (![key isEqualToString:@"hello"]) {
+      XCTAssertNotNil([layer1 pop_animationForKey:key]);
+      [layer1 pop_removeAnimationForKey:key];
+    }
+  }
+  XCTAssertEqualObjects([layer1 pop_animationKeys], @[@"hello"]);
+
+  // released keys are reused without confusing lookups
+  [layer1 pop_removeAnimationForKey:@"hello"];
+  XCTAssertNil([layer1 pop_animationForKey:@"hello"]);
+  [layer1 pop_addAnimation:anim forKey:@"world"];
+  XCTAssertNil([layer1 pop_animationForKey:@"hello"]);
+  XCTAssertTrue(anim == [layer1 pop_animationForKey:@"world"]);
+  [layer1 pop_removeAllAnimations];
+}
+
 - (void)testStartStopDelegation
 {
   CALayer *layer1 = self.layer1;
@@ -888,4 +1001,918 @@ using namespace POP;
   XCTAssertEqualObjects(copy.timingFunction, anim.timingFunction, @"expected equality; value1:%@ value2:%@", copy.timingFunction, anim.timingFunction);
 }
 
+
+- (void)testBakedKeyframesWithinMaxError
+{
+  const CGFloat from[2] = {0, 10}, to[2] = {100, -20}, velocity[2] = {50, 0};
+  const CGFloat maxError = 0.05;
+
+  POP::KeyframeTrack samples = POP::bake_spring(2, from, to, velocity, 300, 10, 1, 0.01, 600, 0);
+  POP::KeyframeTrack track = POP::bake_spring(2, from, to, velocity, 300, 10, 1, 0.01, 600, maxError);
+
+  // reduced to a fraction of the samples
+  XCTAssertTrue(track.size() * 4 < samples.size(), @"unexpected keyframes:%zu samples:%zu", track.size(), samples.size());
+
+  // every sample within max error of the keyframes
+  for (size_t idx = 0; idx < samples.size(); idx++) {
+    CGFloat value[2];
+    track.evaluate(samples.times[idx], value);
+    XCTAssertEqualWithAccuracy(value[0], samples.value(idx)[0], maxError);
+    XCTAssertEqualWithAccuracy(value[1], samples.value(idx)[1], maxError);
+  }
+
+  // ends at rest at the to value
+  XCTAssertEqual(track.times.back(), samples.times.back());
+  XCTAssertEqual(track.value(track.size() - 1)[0], to[0]);
+  XCTAssertEqual(track.value(track.size() - 1)[1], to[1]);
+}
+
+- (void)testBakedKeyframesEdgeCases
+{
+  const CGFloat from[1] = {0}, to[1] = {100};
+
+  // zero max error keeps every sample, even collinear ones
+  const double linear[4] = {0, 0, 1, 1};
+  POP::KeyframeTrack basic = POP::bake_basic(1, from, to, linear, 1, 60, 0);
+  XCTAssertEqual(basic.size(), (size_t)61);
+
+  // an undamped spring stops at the time bound, its last sample snapping to the to value at one key time
+  POP::KeyframeTrack spring = POP::bake_spring(1, from, to, NULL, 300, 0, 1, 0.01, 60, 0);
+  XCTAssertTrue(spring.times.back() >= 59, @"unexpected last key time %f", spring.times.back());
+  for (size_t idx = 1; idx < spring.size(); idx++) {
+    XCTAssertTrue(spring.times[idx] > spring.times[idx - 1], @"unexpected key time %f at %zu", spring.times[idx], idx);
+  }
+  XCTAssertEqual(spring.value(spring.size() - 1)[0], to[0]);
+}
+
+- (void)testBakeAnimations
+{
+  NSArray *keyTimes = nil;
+  NSArray *values = nil;
+
+  POPSpringAnimation *spring = [POPSpringAnimation animationWithPropertyNamed:kPOPLayerPosition];
+  spring.fromValue = [NSValue valueWithCGPoint:CGPointMake(0, 0)];
+  spring.toValue = [NSValue valueWithCGPoint:CGPointMake(100, 50)];
+  XCTAssertTrue([spring pop_bakeWithRate:60 maxError:0.5 keyTimes:&keyTimes values:&values]);
+  XCTAssertEqual(keyTimes.count, values.count);
+  XCTAssertTrue(keyTimes.count > 2, @"unexpected key times %@", keyTimes);
+  XCTAssertEqualObjects(values.firstObject, spring.fromValue);
+  XCTAssertEqualObjects(values.lastObject, spring.toValue);
+
+  POPDecayAnimation *decay = [POPDecayAnimation animationWithPropertyNamed:kPOPLayerPositionX];
+  decay.fromValue = @(0);
+  decay.velocity = @(1000);
+  XCTAssertTrue([decay pop_bakeWithRate:60 maxError:0.5 keyTimes:&keyTimes values:&values]);
+  XCTAssertEqualWithAccuracy([keyTimes.lastObject doubleValue], decay.duration, 1e-6);
+  XCTAssertEqualWithAccuracy([values.lastObject doubleValue], [decay.toValue doubleValue], 0.5);
+
+  POPBasicAnimation *basic = [POPBasicAnimation animationWithPropertyNamed:kPOPLayerOpacity];
+  basic.fromValue = @(0);
+  basic.toValue = @(1);
+  XCTAssertTrue([basic pop_bakeWithRate:60 maxError:0.01 keyTimes:&keyTimes values:&values]);
+  XCTAssertEqualWithAccuracy([keyTimes.lastObject doubleValue], basic.duration, 1e-6);
+  XCTAssertEqualObjects(values.lastObject, basic.toValue);
+  XCTAssertNil(basic.timingFunction, @"unexpected timing function %@", basic.timingFunction);
+
+  // animations missing values do not bake
+  POPBasicAnimation *incomplete = [POPBasicAnimation animationWithPropertyNamed:kPOPLayerOpacity];
+  XCTAssertFalse([incomplete pop_bakeWithRate:60 maxError:0.01 keyTimes:&keyTimes values:&values]);
+}
+
+- (void)testRenderLoopDoesNotAllocate
+{
+  POPAnimatable *spring = [POPAnimatable new];
+  POPAnimatable *decay = [POPAnimatable new];
+  POPAnimatable *basic = [POPAnimatable new];
+
+  POPSpringAnimation *springAnim = [POPSpringAnimation animation];
+  springAnim.property = self.radiusProperty;
+  springAnim.fromValue = @(0);
+  springAnim.toValue = @(100);
+  springAnim.springBounciness = 20;
+  [spring pop_addAnimation:springAnim forKey:@"radius"];
+
+  POPDecayAnimation *decayAnim = [POPDecayAnimation animation];
+  decayAnim.property = self.radiusProperty;
+  decayAnim.fromValue = @(0);
+  decayAnim.velocity = @(1000);
+  [decay pop_addAnimation:decayAnim forKey:@"radius"];
+
+  POPBasicAnimation *basicAnim = [POPBasicAnimation animation];
+  basicAnim.property = self.radiusProperty;
+  basicAnim.fromValue = @(0);
+  basicAnim.toValue = @(100);
+  basicAnim.duration = 1;
+  [basic pop_addAnimation:basicAnim forKey:@"radius"];
+
+  // start animations, sizing reused storage
+  POPAnimatorRenderDuration(self.animator, self.beginTime, 0.1, 1/60.);
+
+  // steady state frames allocate nothing
+  POPBeginCountingAllocations();
+  for (NSUInteger idx = 1; idx <= 12; idx++) {
+    [self.animator renderTime:self.beginTime + 0.1 + idx / 60.];
+  }
+  XCTAssertEqual(POPEndCountingAllocations(), (size_t)0);
+
+  // animations are still running
+  XCTAssertNotNil([spring pop_animationForKey:@"radius"]);
+  XCTAssertNotNil([decay pop_animationForKey:@"radius"]);
+  XCTAssertNotNil([basic pop_animationForKey:@"radius"]);
+}
+
+- (void)testRegistryRemovalAndReAddition
+{
+  static const NSUInteger count = 64;
+  NSMutableArray *objects = [NSMutableArray array];
+  NSMutableArray *animations = [NSMutableArray array];
+
+  for (NSUInteger idx = 0; idx < count; idx++) {
+    POPAnimatable *obj = [POPAnimatable new];
+    POPBasicAnimation *anim = [POPBasicAnimation animation];
+    anim.property = self.radiusProperty;
+    anim.fromValue = @(0);
+    anim.toValue = @(100);
+    anim.duration = 1;
+    [obj pop_addAnimation:anim forKey:@"radius"];
+    [objects addObject:obj];
+    [animations addObject:anim];
+  }
+
+  // remove every other animation, freeing slots for reuse
+  for (NSUInteger idx = 0; idx < count; idx += 2) {
+    [objects[idx] pop_removeAnimationForKey:@"radius"];
+  }
+
+  // removing twice is harmless
+  [objects[0] pop_removeAnimationForKey:@"radius"];
+
+  // re-add a removed animation to another object, reusing a freed slot
+  POPAnimatable *readded = [POPAnimatable new];
+  [readded pop_addAnimation:animations[0] forKey:@"radius"];
+
+  POPAnimatorRenderDuration(self.animator, self.beginTime, 0.5, 1/60.);
+
+  for (NSUInteger idx = 0; idx < count; idx++) {
+    POPAnimatable *obj = objects[idx];
+    if (0 == idx % 2) {
+      XCTAssertNil([obj pop_animationForKey:@"radius"]);
+      XCTAssertEqual(obj.radius, 0.f);
+    } else {
+      XCTAssertNotNil([obj pop_animationForKey:@"radius"]);
+      XCTAssertTrue(obj.radius > 0);
+    }
+  }
+  XCTAssertNotNil([readded pop_animationForKey:@"radius"]);
+  XCTAssertTrue(readded.radius > 0);
+
+  // removing all animations of an object leaves others running
+  [readded pop_removeAllAnimations];
+  XCTAssertNil([readded pop_animationForKey:@"radius"]);
+  XCTAssertNotNil([objects[1] pop_animationForKey:@"radius"]);
+}
+
+- (void)testWriteOrderSurvivesRemoval
+{
+  // animations of one property write in the order they were added, the last one winning
+  POPAnimatable *obj = [POPAnimatable new];
+  NSArray *toValues = @[@50, @10, @1000];
+  NSArray *keys = @[@"a", @"b", @"c"];
+  for (NSUInteger idx = 0; idx < keys.count; idx++) {
+    POPBasicAnimation *anim = [POPBasicAnimation animation];
+    anim.property = self.radiusProperty;
+    anim.fromValue = @(0);
+    anim.toValue = toValues[idx];
+    anim.duration = 1;
+    [obj pop_addAnimation:anim forKey:keys[idx]];
+  }
+
+  POPAnimatorRenderDuration(self.animator, self.beginTime, 0.1, 1/60.);
+  XCTAssertTrue(obj.radius > 10, @"unexpected radius %f", obj.radius);
+
+  // removing the first animation keeps the order of the others
+  [obj pop_removeAnimationForKey:@"a"];
+  POPAnimatorRenderDuration(self.animator, self.beginTime + 0.1, 0.4, 1/60.);
+  XCTAssertTrue(obj.radius > 100, @"unexpected radius %f", obj.radius);
+}
+
+- (void)testChangesDuringFrameApplyAtFrameEnd
+{
+  POPAnimatable *first = [POPAnimatable new];
+  POPAnimatable *second = [POPAnimatable new];
+  POPAnimatable *third = [POPAnimatable new];
+
+  POPBasicAnimation *thirdAnim = [POPBasicAnimation animation];
+  thirdAnim.property = self.radiusProperty;
+  thirdAnim.fromValue = @(0);
+  thirdAnim.toValue = @(100);
+  thirdAnim.duration = 1;
+
+  POPBasicAnimation *secondAnim = [POPBasicAnimation animation];
+  secondAnim.property = self.radiusProperty;
+  secondAnim.fromValue = @(0);
+  secondAnim.toValue = @(100);
+  secondAnim.duration = 1;
+  [second pop_addAnimation:secondAnim forKey:@"radius"];
+
+  // on completion, remove the second animation and add the third, mid frame
+  POPBasicAnimation *firstAnim = [POPBasicAnimation animation];
+  firstAnim.property = self.radiusProperty;
+  firstAnim.fromValue = @(0);
+  firstAnim.toValue = @(100);
+  firstAnim.duration = 0.1;
+  firstAnim.completionBlock = ^(POPAnimation *anim, BOOL finished) {
+    [second pop_removeAnimationForKey:@"radius"];
+    [third pop_addAnimation:thirdAnim forKey:@"radius"];
+  };
+  [first pop_addAnimation:firstAnim forKey:@"radius"];
+
+  POPAnimatorRenderDuration(self.animator, self.beginTime, 0.2, 1/60.);
+  XCTAssertEqual(first.radius, 100.f);
+  XCTAssertNil([second pop_animationForKey:@"radius"]);
+  XCTAssertNotNil([third pop_animationForKey:@"radius"]);
+
+  // removed animation no longer applies, added animation runs
+  float secondRadius = second.radius;
+  float thirdRadius = third.radius;
+  POPAnimatorRenderDuration(self.animator, self.beginTime + 0.2, 0.2, 1/60.);
+  XCTAssertEqual(second.radius, secondRadius);
+  XCTAssertTrue(third.radius > thirdRadius);
+}
+
+- (void)testPausedAnimationResumes
+{
+  POPAnimatable *obj = [POPAnimatable new];
+
+  POPSpringAnimation *anim = [POPSpringAnimation animation];
+  anim.property = self.radiusProperty;
+  anim.fromValue = @(0);
+  anim.toValue = @(100);
+  [obj pop_addAnimation:anim forKey:@"radius"];
+
+  POPAnimatorRenderDuration(self.animator, self.beginTime, 0.1, 1/60.);
+
+  // paused animations are parked, leaving the value untouched
+  anim.paused = YES;
+  POPAnimatorRenderDuration(self.animator, self.beginTime + 0.1, 0.1, 1/60.);
+  float radius = obj.radius;
+  POPAnimatorRenderDuration(self.animator, self.beginTime + 0.2, 0.5, 1/60.);
+  XCTAssertEqual(obj.radius, radius);
+
+  // unpausing returns the animation to the running animations
+  anim.paused = NO;
+  POPAnimatorRenderDuration(self.animator, self.beginTime + 0.7, 3, 1/60.);
+  XCTAssertEqualWithAccuracy(obj.radius, 100.f, 0.1);
+}
+
+- (void)testPausedAnimationOfDeallocatedObjectIsRemoved
+{
+  __block NSUInteger stopCount = 0;
+  __weak POPAnimation *weakAnim;
+  __weak POPAnimatable *weakObj;
+
+  @autoreleasepool {
+    POPAnimatable *obj = [POPAnimatable new];
+    POPSpringAnimation *anim = [POPSpringAnimation animation];
+    anim.property = self.radiusProperty;
+    anim.fromValue = @(0);
+    anim.toValue = @(100);
+    anim.completionBlock = ^(POPAnimation *a, BOOL finished) {
+      XCTAssertFalse(finished);
+      stopCount++;
+    };
+    [obj pop_addAnimation:anim forKey:@"radius"];
+    POPAnimatorRenderDuration(self.animator, self.beginTime, 0.1, 1/60.);
+
+    // park, then release the object
+    anim.paused = YES;
+    POPAnimatorRenderDuration(self.animator, self.beginTime + 0.1, 0.1, 1/60.);
+    weakAnim = anim;
+    weakObj = obj;
+  }
+  XCTAssertNil(weakObj);
+
+  // the parked animation is stopped and released along with its index entry
+  POPAnimatorRenderDuration(self.animator, self.beginTime + 0.2, 2, 1/60.);
+  XCTAssertEqual(stopCount, (NSUInteger)1);
+  XCTAssertNil(weakAnim);
+}
+
+- (void)testPausedAnimationResumesOnOwnAnimator
+{
+  POPVirtualFrameSource *source = [[POPVirtualFrameSource alloc] initWithTime:100 frameInterval:1/60.];
+  POPAnimator *animator = [[POPAnimator alloc] initWithFrameSource:source];
+
+  POPAnimatable *obj = [POPAnimatable new];
+  POPBasicAnimation *anim = [POPBasicAnimation linearAnimation];
+  anim.property = self.radiusProperty;
+  anim.fromValue = @(0);
+  anim.toValue = @(100);
+  anim.duration = 0.5;
+  [animator addAnimation:anim forObject:obj key:@"radius"];
+  [source advanceTime:0.1];
+
+  // parked on the animator that added it, not the shared one
+  anim.paused = YES;
+  [source advanceTime:0.1];
+  float radius = obj.radius;
+  [source advanceTime:1];
+  XCTAssertEqual(obj.radius, radius);
+  XCTAssertTrue(radius < 100.f);
+
+  anim.paused = NO;
+  [source advanceTime:2];
+  XCTAssertEqualWithAccuracy(obj.radius, 100.f, 1e-3);
+  XCTAssertNil([animator animationForObject:obj key:@"radius"]);
+}
+
+- (void)testUnparkWhileGoingIdleStress
+{
+  static const NSUInteger iterations = 500;
+  dispatch_queue_t queue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0);
+
+  for (NSUInteger idx = 0; idx < iterations; idx++) {
+    POPVirtualFrameSource *source = [[POPVirtualFrameSource alloc] initWithTime:100 frameInterval:1/60.];
+    POPAnimator *animator = [[POPAnimator alloc] initWithFrameSource:source];
+
+    POPAnimatable *obj = [POPAnimatable new];
+    POPBasicAnimation *parked = [POPBasicAnimation linearAnimation];
+    parked.property = self.radiusProperty;
+    parked.fromValue = @(0);
+    parked.toValue = @(100);
+    parked.duration = 0.1;
+    [animator addAnimation:parked forObject:obj key:@"radius"];
+    [source advanceTime:1/60.];
+    parked.paused = YES;
+    [source advanceTime:1/60.];
+    XCTAssertTrue(source.paused);
+
+    // the last running animation completes as another thread unparks
+    POPAnimatable *other = [POPAnimatable new];
+    POPBasicAnimation *last = [POPBasicAnimation linearAnimation];
+    last.property = self.radiusProperty;
+    last.fromValue = @(0);
+    last.toValue = @(1);
+    last.duration = 1/60.;
+    [animator addAnimation:last forObject:other key:@"radius"];
+
+    dispatch_group_t group = dispatch_group_create();
+    dispatch_group_async(group, queue, ^{
+      parked.paused = NO;
+    });
+    [source advanceTime:0.05];
+    dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
+
+    // the unpark command wakes the animator rather than waiting forever
+    [source advanceTime:1];
+    XCTAssertEqualWithAccuracy(obj.radius, 100.f, 1e-3, @"iteration:%lu", (unsigned long)idx);
+    XCTAssertNil([animator animationForObject:obj key:@"radius"], @"iteration:%lu", (unsigned long)idx);
+  }
+}
+
+- (void)testDelayedAnimationsStartWhenDue
+{
+  static const NSUInteger count = 20;
+  NSMutableArray *objects = [NSMutableArray array];
+
+  // staggered begin times between frames, added out of order
+  for (NSUInteger idx = 0; idx < count; idx++) {
+    POPAnimatable *obj = [POPAnimatable new];
+    [objects addObject:obj];
+
+    POPBasicAnimation *anim = [POPBasicAnimation linearAnimation];
+    anim.property = self.radiusProperty;
+    anim.fromValue = @(1);
+    anim.toValue = @(2);
+    anim.duration = 0.05;
+    anim.beginTime = self.beginTime + 0.05 * ((idx * 7) % count) + 1/120.;
+    [obj pop_addAnimation:anim forKey:@"radius"];
+  }
+
+  // values change only once due
+  for (CFTimeInterval t = 0; t < 0.05 * count + 0.1; t += 1/60.) {
+    POPAnimatorRenderTime(self.animator, self.beginTime, t);
+    for (NSUInteger idx = 0; idx < count; idx++) {
+      POPAnimatable *obj = objects[idx];
+      CFTimeInterval begin = 0.05 * ((idx * 7) % count) + 1/120.;
+      if (t < begin) {
+        XCTAssertEqual(obj.radius, 0.f, @"started early idx:%lu t:%f", (unsigned long)idx, t);
+      } else {
+        XCTAssertTrue(obj.radius >= 1.f, @"not started idx:%lu t:%f", (unsigned long)idx, t);
+      }
+    }
+  }
+
+  // all complete
+  for (POPAnimatable *obj in objects) {
+    XCTAssertEqualWithAccuracy(obj.radius, 2.f, 1e-3);
+    XCTAssertNil([obj pop_animationForKey:@"radius"]);
+  }
+}
+
+- (void)testVirtualFrameSourceDrivesAnimator
+{
+  POPVirtualFrameSource *source = [[POPVirtualFrameSource alloc] initWithTime:100 frameInterval:1/60.];
+  POPAnimator *animator = [[POPAnimator alloc] initWithFrameSource:source];
+  XCTAssertTrue(source.animator == animator);
+  XCTAssertTrue(source.paused);
+
+  POPAnimatable *obj = [POPAnimatable new];
+  POPBasicAnimation *anim = [POPBasicAnimation linearAnimation];
+  anim.property = self.radiusProperty;
+  anim.fromValue = @(0);
+  anim.toValue = @(100);
+  anim.duration = 0.25;
+
+  // adding runs frames until completion, then pauses the source
+  [animator addAnimation:anim forObject:obj key:@"radius"];
+  XCTAssertFalse(source.paused);
+  [source advanceTime:1];
+  XCTAssertEqualWithAccuracy(obj.radius, 100.f, 1e-3);
+  XCTAssertTrue(source.paused);
+  XCTAssertTrue(source.frameCount <= 20, @"frames:%lu", (unsigned long)source.frameCount);
+
+  NSUInteger frameCount = source.frameCount;
+  [source advanceTime:1];
+  XCTAssertEqual(source.frameCount, frameCount);
+
+  // delayed animations sleep until due
+  POPBasicAnimation *delayed = [POPBasicAnimation linearAnimation];
+  delayed.property = self.radiusProperty;
+  delayed.fromValue = @(100);
+  delayed.toValue = @(0);
+  delayed.duration = 0.25;
+  delayed.beginTime = source.currentTime + 10;
+  [animator addAnimation:delayed forObject:obj key:@"radius"];
+
+  [source advanceTime:9.9];
+  XCTAssertEqual(obj.radius, 100.f);
+  XCTAssertTrue(source.paused);
+  XCTAssertTrue(source.frameCount - frameCount <= 2, @"frames:%lu", (unsigned long)(source.frameCount - frameCount));
+
+  [source advanceTime:1];
+  XCTAssertEqualWithAccuracy(obj.radius, 0.f, 1e-3);
+  XCTAssertTrue(source.frameCount - frameCount <= 22, @"frames:%lu", (unsigned long)(source.frameCount - frameCount));
+  XCTAssertNil([animator animationForObject:obj key:@"radius"]);
+}
+
+- (void)testMetricsRecordFrames
+{
+  POPAnimator *animator = self.animator;
+  [animator resetMetrics];
+  animator.metricsEnabled = YES;
+
+  POPAnimatable *obj = [POPAnimatable new];
+  POPSpringAnimation *anim = [POPSpringAnimation animation];
+  anim.property = self.radiusProperty;
+  anim.fromValue = @(0);
+  anim.toValue = @(100);
+  [obj pop_addAnimation:anim forKey:@"radius"];
+
+  NSUInteger frameCount = 30;
+  for (NSUInteger idx = 1; idx <= frameCount; idx++) {
+    [animator renderTime:self.beginTime + idx / 60.];
+  }
+  animator.metricsEnabled = NO;
+  [animator renderTime:self.beginTime + (frameCount + 1) / 60.];
+
+  NSDictionary *metrics = animator.metrics;
+  XCTAssertEqualObjects(metrics[@"frames"], @(frameCount));
+  XCTAssertEqualObjects(metrics[@"last"][@"springs"], @1);
+  XCTAssertTrue([metrics[@"writes"] unsignedIntegerValue] > 0);
+  XCTAssertTrue([metrics[@"solverSteps"] unsignedIntegerValue] > 0);
+
+  NSDictionary *total = metrics[@"phases"][@"total"];
+  XCTAssertTrue([total[@"p50"] doubleValue] <= [total[@"p95"] doubleValue]);
+  XCTAssertTrue([total[@"p95"] doubleValue] <= [total[@"p99"] doubleValue]);
+  XCTAssertTrue([total[@"p99"] doubleValue] <= [total[@"max"] doubleValue]);
+  XCTAssertNotNil(metrics[@"phases"][@"compute"]);
+  XCTAssertNotNil(metrics[@"phases"][@"write"]);
+  XCTAssertNotNil(metrics[@"phases"][@"callback"]);
+
+  [animator resetMetrics];
+  XCTAssertEqualObjects(animator.metrics[@"frames"], @0);
+  [obj pop_removeAllAnimations];
+}
+
+- (void)testTraceRecordsAnimationEvents
+{
+  POPAnimator *animator = self.animator;
+  animator.traceCapacity = 1000;
+  XCTAssertEqual(animator.traceCapacity, (NSUInteger)1024);
+
+  POPAnimatable *obj = [POPAnimatable new];
+  POPBasicAnimation *anim = [POPBasicAnimation animation];
+  anim.property = self.radiusProperty;
+  anim.fromValue = @(0);
+  anim.toValue = @(100);
+  anim.duration = 0.25;
+  [obj pop_addAnimation:anim forKey:@"radius"];
+
+  for (NSUInteger idx = 1; idx <= 30; idx++) {
+    [animator renderTime:self.beginTime + idx / 60.];
+  }
+  animator.traceCapacity = 0;
+  XCTAssertEqual(animator.traceCapacity, (NSUInteger)0);
+
+  NSData *data = [[animator traceJSON] dataUsingEncoding:NSUTF8StringEncoding];
+  NSDictionary *trace = [NSJSONSerialization JSONObjectWithData:data options:0 error:NULL];
+  NSArray *events = trace[@"traceEvents"];
+  XCTAssertTrue(events.count > 0);
+
+  NSCountedSet *names = [NSCountedSet set];
+  for (NSDictionary *event in events) {
+    [names addObject:[NSString stringWithFormat:@"%@:%@", event[@"name"], event[@"ph"]]];
+  }
+  XCTAssertEqual([names countForObject:@"add:i"], (NSUInteger)1);
+  XCTAssertEqual([names countForObject:@"basic:b"], (NSUInteger)1);
+  XCTAssertEqual([names countForObject:@"basic:e"], (NSUInteger)1);
+  XCTAssertTrue([names countForObject:@"frame:X"] >= 30);
+  XCTAssertTrue([names countForObject:@"write:i"] > 0);
+
+  NSDictionary *stop = nil;
+  for (NSDictionary *event in events) {
+    if ([event[@"ph"] isEqual:@"e"]) {
+      stop = event;
+    }
+  }
+  XCTAssertEqualObjects(stop[@"args"][@"finished"], @YES);
+}
+
+- (void)testLayerTransformBatchWritesOnce
+{
+  CALayer *layer = [CALayer layer];
+
+  POPLayerBeginTransformBatch();
+  POPLayerSetScaleXY(layer, CGPointMake(2, 3));
+  POPLayerSetRotationZ(layer, M_PI_4);
+  POPLayerSetTranslationX(layer, 10);
+
+  // components read back from the batch before the layer is written
+  XCTAssertTrue(CATransform3DIsIdentity(layer.transform));
+  XCTAssertEqualWithAccuracy(POPLayerGetScaleX(layer), 2, 1e-6);
+  XCTAssertEqualWithAccuracy(POPLayerGetRotationZ(layer), M_PI_4, 1e-6);
+  POPLayerEndTransformBatch();
+
+  XCTAssertEqualWithAccuracy(POPLayerGetScaleX(layer), 2, 1e-6);
+  XCTAssertEqualWithAccuracy(POPLayerGetScaleY(layer), 3, 1e-6);
+  XCTAssertEqualWithAccuracy(POPLayerGetRotationZ(layer), M_PI_4, 1e-6);
+  XCTAssertEqualWithAccuracy(POPLayerGetTranslationX(layer), 10, 1e-6);
+
+  // transforms set directly while batching win over components batched before
+  POPLayerBeginTransformBatch();
+  POPLayerSetTranslationY(layer, 20);
+  layer.transform = CATransform3DMakeScale(4, 4, 1);
+  POPLayerEndTransformBatch();
+  XCTAssertTrue(CATransform3DEqualToTransform(layer.transform, CATransform3DMakeScale(4, 4, 1)));
+
+  // and lie beneath components batched after
+  POPLayerBeginTransformBatch();
+  POPLayerSetTranslationY(layer, 20);
+  layer.transform = CATransform3DMakeScale(5, 5, 1);
+  POPLayerSetTranslationX(layer, 30);
+  POPLayerEndTransformBatch();
+
+  XCTAssertEqualWithAccuracy(POPLayerGetScaleX(layer), 5, 1e-6);
+  XCTAssertEqualWithAccuracy(POPLayerGetRotationZ(layer), 0, 1e-6);
+  XCTAssertEqualWithAccuracy(POPLayerGetTranslationX(layer), 30, 1e-6);
+  XCTAssertEqualWithAccuracy(POPLayerGetTranslationY(layer), 0, 1e-6);
+
+  // flushing writes the layer and keeps batching
+  POPLayerBeginTransformBatch();
+  POPLayerSetTranslationY(layer, 40);
+  POPLayerFlushTransformBatch();
+  XCTAssertEqualWithAccuracy(layer.transform.m42, 40, 1e-6);
+  POPLayerSetTranslationY(layer, 50);
+  XCTAssertEqualWithAccuracy(layer.transform.m42, 40, 1e-6);
+  POPLayerEndTransformBatch();
+  XCTAssertEqualWithAccuracy(layer.transform.m42, 50, 1e-6);
+
+  // animations of several components compose
+  layer.transform = CATransform3DIdentity;
+  POPBasicAnimation *scale = [POPBasicAnimation animationWithPropertyNamed:kPOPLayerScaleXY];
+  scale.toValue = [NSValue valueWithCGPoint:CGPointMake(0.5, 0.5)];
+  POPBasicAnimation *rotation = [POPBasicAnimation animationWithPropertyNamed:kPOPLayerRotation];
+  rotation.toValue = @(M_PI_2);
+  POPBasicAnimation *translation = [POPBasicAnimation animationWithPropertyNamed:kPOPLayerTranslationX];
+  translation.toValue = @(50);
+  [layer pop_addAnimation:scale forKey:@"scale"];
+  [layer pop_addAnimation:rotation forKey:@"rotation"];
+  [layer pop_addAnimation:translation forKey:@"translation"];
+
+  POPAnimatorRenderDuration(self.animator, self.beginTime, 1, 1.0/60.0);
+  XCTAssertEqualWithAccuracy(POPLayerGetScaleX(layer), 0.5, 1e-6);
+  XCTAssertEqualWithAccuracy(POPLayerGetRotationZ(layer), M_PI_2, 1e-6);
+  XCTAssertEqualWithAccuracy(POPLayerGetTranslationX(layer), 50, 1e-6);
+}
+
+- (void)testLayerTransformCalloutsSeeCurrentTransform
+{
+  CALayer *layer = [CALayer layer];
+
+  POPBasicAnimation *scale = [POPBasicAnimation linearAnimation];
+  scale.property = [POPAnimatableProperty propertyWithName:kPOPLayerScaleXY];
+  scale.fromValue = [NSValue valueWithCGPoint:CGPointMake(1, 1)];
+  scale.toValue = [NSValue valueWithCGPoint:CGPointMake(2, 2)];
+  scale.duration = 0.5;
+  POPBasicAnimation *translation = [POPBasicAnimation linearAnimation];
+  translation.property = [POPAnimatableProperty propertyWithName:kPOPLayerTranslationX];
+  translation.fromValue = @(0);
+  translation.toValue = @(50);
+  translation.duration = 0.5;
+
+  // apply callouts read the transform as written so far this frame
+  __block NSUInteger mismatches = 0;
+  scale.animationDidApplyBlock = ^(POPAnimation *a) {
+    if (fabs(layer.transform.m11 - POPLayerGetScaleX(layer)) > 1e-6) {
+      mismatches++;
+    }
+  };
+
+  // a transform set on completion is not overwritten by the batch
+  __block BOOL completed = NO;
+  translation.completionBlock = ^(POPAnimation *a, BOOL finished) {
+    layer.transform = CATransform3DIdentity;
+    completed = finished;
+  };
+
+  [layer pop_addAnimation:scale forKey:@"scale"];
+  [layer pop_addAnimation:translation forKey:@"translation"];
+  POPAnimatorRenderDuration(self.animator, self.beginTime, 1, 1.0/60.0);
+
+  XCTAssertTrue(completed);
+  XCTAssertEqual(mismatches, (NSUInteger)0);
+  XCTAssertTrue(CATransform3DIsIdentity(layer.transform));
+}
+
+- (void)testMixedAnimationTypesAnimateTogether
+{
+  POPAnimatable *spring = [POPAnimatable new];
+  POPAnimatable *decay = [POPAnimatable new];
+  POPAnimatable *basic = [POPAnimatable new];
+  POPAnimatable *custom = [POPAnimatable new];
+
+  POPSpringAnimation *springAnim = [POPSpringAnimation animation];
+  springAnim.property = self.radiusProperty;
+  springAnim.fromValue = @(0);
+  springAnim.toValue = @(100);
+  [spring pop_addAnimation:springAnim forKey:@"radius"];
+
+  POPDecayAnimation *decayAnim = [POPDecayAnimation animation];
+  decayAnim.property = self.radiusProperty;
+  decayAnim.fromValue = @(0);
+  decayAnim.velocity = @(1000);
+  [decay pop_addAnimation:decayAnim forKey:@"radius"];
+
+  POPBasicAnimation *basicAnim = [POPBasicAnimation linearAnimation];
+  basicAnim.property = self.radiusProperty;
+  basicAnim.fromValue = @(0);
+  basicAnim.toValue = @(100);
+  basicAnim.duration = 0.5;
+  [basic pop_addAnimation:basicAnim forKey:@"radius"];
+
+  __block NSUInteger customCount = 0;
+  POPCustomAnimation *customAnim = [POPCustomAnimation animationWithBlock:^BOOL(id target, POPCustomAnimation *animation) {
+    ((POPAnimatable *)target).radius = ++customCount;
+    return customCount < 10;
+  }];
+  [custom pop_addAnimation:customAnim forKey:@"radius"];
+
+  POPAnimatorRenderDuration(self.animator, self.beginTime, 0.25, 1/60.);
+
+  // every type advances within the same frames
+  XCTAssertTrue(spring.radius > 0);
+  XCTAssertTrue(decay.radius > 0);
+  XCTAssertEqualWithAccuracy(basic.radius, 50.f, 5.f);
+  XCTAssertEqual(custom.radius, 10.f);
+
+  // finished custom animation was removed, others still run
+  XCTAssertNil([custom pop_animationForKey:@"radius"]);
+  XCTAssertNotNil([spring pop_animationForKey:@"radius"]);
+  XCTAssertNotNil([basic pop_animationForKey:@"radius"]);
+}
+
+- (void)testConcurrentComputeMatchesSerial
+{
+  static const NSUInteger count = 300;
+  NSUInteger threshold = self.animator.concurrentComputeThreshold;
+  NSMutableArray *results = [NSMutableArray array];
+
+  for (NSUInteger concurrentThreshold : {(NSUInteger)NSUIntegerMax, (NSUInteger)1}) {
+    self.animator.concurrentComputeThreshold = concurrentThreshold;
+
+    NSMutableArray *objects = [NSMutableArray array];
+    NSMutableArray *applied = [NSMutableArray array];
+    for (NSUInteger idx = 0; idx < count; idx++) {
+      POPAnimatable *obj = [POPAnimatable new];
+      [objects addObject:obj];
+
+      POPPropertyAnimation *anim;
+      if (0 == idx % 3) {
+        POPSpringAnimation *spring = [POPSpringAnimation animation];
+        spring.springBounciness = idx % 20;
+        spring.toValue = @(idx);
+        anim = spring;
+      } else if (1 == idx % 3) {
+        POPDecayAnimation *decay = [POPDecayAnimation animation];
+        decay.velocity = @(idx * 10.);
+        anim = decay;
+      } else {
+        POPBasicAnimation *basic = [POPBasicAnimation easeInEaseOutAnimation];
+        basic.toValue = @(idx);
+        basic.duration = 0.1 + idx / 1000.;
+        anim = basic;
+      }
+      anim.property = self.radiusProperty;
+      anim.fromValue = @(0);
+      anim.animationDidApplyBlock = ^(POPAnimation *a) {
+        [applied addObject:@(idx)];
+      };
+      [obj pop_addAnimation:anim forKey:@"radius"];
+    }
+
+    POPAnimatorRenderDuration(self.animator, self.beginTime, 0.5, 1/60.);
+
+    NSMutableArray *radii = [NSMutableArray array];
+    for (POPAnimatable *obj in objects) {
+      [radii addObject:@(obj.radius)];
+      [obj pop_removeAllAnimations];
+    }
+    [results addObject:@[radii, applied]];
+  }
+  self.animator.concurrentComputeThreshold = threshold;
+
+  // identical values, and callouts in identical order
+  XCTAssertEqualObjects(results[0][0], results[1][0]);
+  XCTAssertEqualObjects(results[0][1], results[1][1]);
+}
+
+- (void)testConcurrentComputeDefersCalloutChanges
+{
+  NSUInteger threshold = self.animator.concurrentComputeThreshold;
+  NSMutableArray *radii = [NSMutableArray array];
+
+  for (NSUInteger concurrentThreshold : {(NSUInteger)NSUIntegerMax, (NSUInteger)2}) {
+    self.animator.concurrentComputeThreshold = concurrentThreshold;
+
+    POPAnimatable *first = [POPAnimatable new];
+    POPAnimatable *second = [POPAnimatable new];
+    POPBasicAnimation *firstAnim = [POPBasicAnimation linearAnimation];
+    POPBasicAnimation *secondAnim = [POPBasicAnimation linearAnimation];
+    for (POPBasicAnimation *anim in @[firstAnim, secondAnim]) {
+      anim.property = self.radiusProperty;
+      anim.fromValue = @(0);
+      anim.toValue = @(100);
+      anim.duration = 1;
+    }
+
+    // the first animation retargets the later one of its bucket mid frame
+    __block BOOL retarget = NO;
+    firstAnim.animationDidApplyBlock = ^(POPAnimation *a) {
+      if (retarget) {
+        secondAnim.toValue = @(200);
+        retarget = NO;
+      }
+    };
+    [first pop_addAnimation:firstAnim forKey:@"radius"];
+    [second pop_addAnimation:secondAnim forKey:@"radius"];
+
+    POPAnimatorRenderTime(self.animator, self.beginTime, 0);
+    retarget = YES;
+    POPAnimatorRenderTime(self.animator, self.beginTime, 0.5);
+    [radii addObject:@(second.radius)];
+    POPAnimatorRenderTime(self.animator, self.beginTime, 0.75);
+    [radii addObject:@(second.radius)];
+
+    [first pop_removeAllAnimations];
+    [second pop_removeAllAnimations];
+  }
+  self.animator.concurrentComputeThreshold = threshold;
+
+  // serially the change applies the same frame, concurrently the next one
+  XCTAssertEqualWithAccuracy([radii[0] floatValue], 100.f, 1e-3);
+  XCTAssertEqualWithAccuracy([radii[2] floatValue], 50.f, 1e-3);
+  XCTAssertEqualWithAccuracy([radii[1] floatValue], 150.f, 1e-3);
+  XCTAssertEqualWithAccuracy([radii[3] floatValue], 150.f, 1e-3);
+}
+
+- (void)testConcurrentComputeSkipsCalloutStoppedItems
+{
+  NSUInteger threshold = self.animator.concurrentComputeThreshold;
+
+  for (NSUInteger concurrentThreshold : {(NSUInteger)NSUIntegerMax, (NSUInteger)2}) {
+    self.animator.concurrentComputeThreshold = concurrentThreshold;
+
+    POPAnimatable *first = [POPAnimatable new];
+    POPAnimatable *second = [POPAnimatable new];
+    POPBasicAnimation *firstAnim = [POPBasicAnimation linearAnimation];
+    POPBasicAnimation *secondAnim = [POPBasicAnimation linearAnimation];
+    for (POPBasicAnimation *anim in @[firstAnim, secondAnim]) {
+      anim.property = self.radiusProperty;
+      anim.fromValue = @(0);
+      anim.toValue = @(100);
+      anim.duration = 1;
+    }
+
+    // the progress callout of the first animation stops the later one of its bucket
+    id delegate = [OCMockObject niceMockForProtocol:@protocol(POPAnimationDelegate)];
+    [[[delegate stub] andDo:^(NSInvocation *invocation) {
+      [second pop_removeAnimationForKey:@"radius"];
+    }] pop_animation:firstAnim didReachProgress:0.5];
+    firstAnim.delegate = delegate;
+    firstAnim.progressMarkers = @[@0.5];
+
+    __block NSUInteger stopCount = 0;
+    __block NSUInteger calloutsAfterStop = 0;
+    secondAnim.animationDidApplyBlock = ^(POPAnimation *a) {
+      calloutsAfterStop += stopCount;
+    };
+    secondAnim.completionBlock = ^(POPAnimation *a, BOOL finished) {
+      XCTAssertFalse(finished);
+      calloutsAfterStop += stopCount;
+      stopCount++;
+    };
+
+    [first pop_addAnimation:firstAnim forKey:@"radius"];
+    [second pop_addAnimation:secondAnim forKey:@"radius"];
+    POPAnimatorRenderDuration(self.animator, self.beginTime, 1.5, 1/60.);
+
+    XCTAssertEqual(stopCount, (NSUInteger)1, @"threshold:%lu", (unsigned long)concurrentThreshold);
+    XCTAssertEqual(calloutsAfterStop, (NSUInteger)0, @"threshold:%lu", (unsigned long)concurrentThreshold);
+    XCTAssertTrue(second.radius < 100.f);
+    XCTAssertEqualWithAccuracy(first.radius, 100.f, 1e-3);
+  }
+  self.animator.concurrentComputeThreshold = threshold;
+}
+
+- (void)testConcurrentProducersStress
+{
+  static const NSUInteger producerCount = 8;
+  static const NSUInteger iterations = 1000;
+  static const NSUInteger keyCount = 8;
+
+  NSMutableArray *objects = [NSMutableArray array];
+  for (NSUInteger idx = 0; idx < producerCount; idx++) {
+    [objects addObject:[POPAnimatable new]];
+  }
+
+  // producers add, replace and remove animations of their own object
+  POPAnimatableProperty *property = self.radiusProperty;
+  dispatch_group_t group = dispatch_group_create();
+  dispatch_queue_t queue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0);
+  for (POPAnimatable *obj in objects) {
+    dispatch_group_async(group, queue, ^{
+      for (NSUInteger idx = 0; idx < iterations; idx++) {
+        POPBasicAnimation *anim = [POPBasicAnimation linearAnimation];
+        anim.property = property;
+        anim.fromValue = @(1);
+        anim.toValue = @(100);
+        anim.duration = 1000;
+
+        NSString *key = [NSString stringWithFormat:@"%lu", (unsigned long)(idx % keyCount)];
+        [obj pop_addAnimation:anim forKey:key];
+        if (0 == idx % 3) {
+          [obj pop_removeAnimationForKey:key];
+        }
+      }
+    });
+  }
+
+  // render concurrently until producers finish
+  CFTimeInterval time = self.beginTime;
+  while (0 != dispatch_group_wait(group, DISPATCH_TIME_NOW)) {
+    [self.animator renderTime:time];
+    time += 1/60.;
+  }
+  [self.animator renderTime:time];
+
+  // each key holds the animation of its last iteration, unless removed
+  NSUInteger expectedCount = 0;
+  for (NSUInteger idx = iterations - keyCount; idx < iterations; idx++) {
+    expectedCount += (0 != idx % 3) ? 1 : 0;
+  }
+
+  for (POPAnimatable *obj in objects) {
+    XCTAssertEqual([obj pop_animationKeys].count, expectedCount);
+
+    // surviving animations run
+    obj.radius = 0;
+  }
+  [self.animator renderTime:time + 1/60.];
+  for (POPAnimatable *obj in objects) {
+    XCTAssertTrue(obj.radius > 0);
+    [obj pop_removeAllAnimations];
+  }
+
+  // removed animations stop applying
+  [self.animator renderTime:time + 2/60.];
+  for (POPAnimatable *obj in objects) {
+    obj.radius = 0;
+  }
+  [self.animator renderTime:time + 3/60.];
+  for (POPAnimatable *obj in objects) {
+    XCTAssertEqual(obj.radius, 0.f);
+  }
+}
+
 @end
@@ -91,6 +91,32 @@ static const CGFloat epsilon = 0.0001f;
   XCTAssertTrue(toValueFrameCount <= kPOPAnimationConvergenceMaxFrameCount, @"unexpected convergence; toValueFrameCount: %lu", (unsigned long)toValueFrameCount);
 }
 
+- (void)testLargeTimeGap
+{
+  // decay is evaluated in closed form; a hitch lands where regular frames would
+  static const CFTimeInterval duration = 0.6;
+  NSMutableArray *times = [NSMutableArray array];
+  for (CFTimeInterval time = 0; time < duration; time += 1.0/60.0) {
+    [times addObject:@(time)];
+  }
+  [times addObject:@(duration)];
+
+  CALayer *layer = [CALayer layer];
+  [layer pop_addAnimation:self._positionXAnimation forKey:animationKey];
+  POPAnimatorRenderTimes(self.animator, self.beginTime, times);
+  CGFloat value = layer.position.x;
+  [layer pop_removeAllAnimations];
+
+  CALayer *hitchedLayer = [CALayer layer];
+  [hitchedLayer pop_addAnimation:self._positionXAnimation forKey:animationKey];
+  POPAnimatorRenderTimes(self.animator, self.beginTime, @[@0.0, @(1.0/60.0), @(duration)]);
+  CGFloat hitchedValue = hitchedLayer.position.x;
+  [hitchedLayer pop_removeAllAnimations];
+
+  XCTAssertTrue(value > 0, @"unexpected value %f", value);
+  XCTAssertEqualWithAccuracy(value, hitchedValue, 0.1, @"unexpected value after time gap");
+}
+
 - (void)testConvergenceNegativeVelocity
 {
   POPAnimatable *circle = [POPAnimatable new];
@@ -24,6 +24,8 @@
 #import "POPAnimationTestsExtras.h"
 #import "POPBaseAnimationTests.h"
 #import "POPCGUtils.h"
+#import "POPSpringBatch.h"
+#import "POPSpringResponseCache.h"
 
 @interface POPSpringAnimationTests : POPBaseAnimationTests
 @end
@@ -640,6 +642,95 @@ static BOOL _floatingPointEqual(CGFloat a, CGFloat b)
   XCTAssertEqualObjects(writeEvent.value, anim.toValue, @"unexpected last write event %@", writeEvent);
 }
 
+- (void)testBoundedCatchUpMatchesIntegration
+{
+  static const NSUInteger maxSteps = 100;
+  static const double gaps[] = {0.5, 5, 20};
+
+  for (size_t idx = 0; idx < POP_ARRAY_COUNT(gaps); idx++) {
+    SpringSolver4d integrated(342, 30, 1);
+    SpringSolver4d bounded(342, 30, 1);
+    bounded.setMaxSteps(maxSteps);
+
+    SSState4d integratedState, boundedState;
+    integratedState.p = boundedState.p = Vector4d(100, -50, 10, 0);
+    integratedState.v = boundedState.v = Vector4d(-200, 400, 0, 1000);
+
+    // one frame, a hitch, then frames
+    CFTimeInterval t = 0;
+    for (NSUInteger frame = 0; frame < 10; frame++) {
+      CFTimeInterval dt = 1 == frame ? gaps[idx] : 1.0/60.0;
+      integrated.advance(integratedState, t, dt);
+      bounded.advance(boundedState, t, dt);
+      t += dt;
+
+      XCTAssertTrue(bounded.stepCount() <= maxSteps, @"unexpected step count gap:%f frame:%lu steps:%lu", gaps[idx], (unsigned long)frame, (unsigned long)bounded.stepCount());
+      for (size_t i = 0; i < 4; i++) {
+        XCTAssertEqualWithAccuracy(integratedState.p[i], boundedState.p[i], 1e-6 * 100, @"unexpected position gap:%f frame:%lu", gaps[idx], (unsigned long)frame);
+      }
+    }
+  }
+}
+
+- (void)testBoundedCatchUpStaysStableWithLargeFriction
+{
+  // friction only, no closed form; coarse steps over a long gap would exceed the RK4 stability limit
+  static const NSUInteger maxSteps = 100;
+  static const double gaps[] = {2, 5, 20};
+
+  for (size_t idx = 0; idx < POP_ARRAY_COUNT(gaps); idx++) {
+    SpringSolver4d solver(0, 500, 1);
+    solver.setMaxSteps(maxSteps);
+    XCTAssertTrue(solver.maxStableDt() * 500 <= 2.5 + 1e-9, @"unexpected stable step %f", solver.maxStableDt());
+
+    SSState4d state;
+    state.p = Vector4d(100, -50, 10, 0);
+    state.v = Vector4d(-200, 400, 0, 1000);
+
+    // velocity decays, coming to rest at p + v * m / b
+    CFTimeInterval t = 0;
+    for (NSUInteger frame = 0; frame < 120; frame++) {
+      CFTimeInterval dt = 1 == frame ? gaps[idx] : 1.0/60.0;
+      solver.advance(state, t, dt);
+      t += dt;
+      XCTAssertTrue(solver.stepCount() <= maxSteps, @"unexpected step count gap:%f frame:%lu", gaps[idx], (unsigned long)frame);
+    }
+    Vector4d rest(99.6, -49.2, 10, 2);
+    for (size_t i = 0; i < 4; i++) {
+      XCTAssertEqualWithAccuracy(state.p[i], rest[i], 1e-6, @"unexpected position gap:%f", gaps[idx]);
+      XCTAssertEqualWithAccuracy(state.v[i], 0., 1e-6, @"unexpected velocity gap:%f", gaps[idx]);
+    }
+  }
+}
+
+- (void)testMaxSolverStepsPerFrame
+{
+  POPAnimator *animator = self.animator;
+  NSUInteger maxSteps = animator.maxSolverStepsPerFrame;
+  XCTAssertTrue(0 != maxSteps, @"unexpected default budget");
+
+  POPSpringAnimation *anim = self._positionAnimation;
+  anim.toValue = @1000.0;
+  anim.springBounciness = 20;
+
+  CALayer *layer = [CALayer layer];
+  [layer pop_addAnimation:anim forKey:animationKey];
+
+  // hitch of half a second
+  POPAnimatorRenderTimes(animator, self.beginTime, @[@0.0, @(1.0/60.0), @0.5]);
+  XCTAssertTrue(anim.solverStepCount <= maxSteps, @"unexpected step count %lu", (unsigned long)anim.solverStepCount);
+
+  // unbounded integration
+  animator.maxSolverStepsPerFrame = 0;
+  POPAnimatorRenderTimes(animator, self.beginTime, @[@1.0]);
+  XCTAssertTrue(anim.solverStepCount > maxSteps, @"unexpected step count %lu", (unsigned long)anim.solverStepCount);
+  animator.maxSolverStepsPerFrame = maxSteps;
+
+  // completes on to value
+  POPAnimatorRenderDuration(animator, self.beginTime + 1.0, 5, 1.0/60.0);
+  XCTAssertEqual(layer.position.x, 1000.0, @"unexpected value %@", anim);
+}
+
 - (void)testEquivalentFromToValues
 {
   POPSpringAnimation *anim = [POPSpringAnimation animationWithPropertyNamed:kPOPLayerPosition];
@@ -673,6 +764,8 @@ static BOOL _floatingPointEqual(CGFloat a, CGFloat b)
   anim.dynamicsTension = 0.83;
   anim.dynamicsFriction = 0.97;
   anim.dynamicsMass = 100;
+  anim.solverMode = kPOPSpringSolverModeAnalytic;
+  anim.solverTolerance = 0.5;
   
   POPSpringAnimation *copy = [anim copy];
   
@@ -682,6 +775,445 @@ static BOOL _floatingPointEqual(CGFloat a, CGFloat b)
   XCTAssertEqual(copy.dynamicsTension, anim.dynamicsTension, @"expected equality; value1:%@ value2:%@", @(copy.dynamicsTension), @(anim.dynamicsTension));
   XCTAssertEqual(copy.dynamicsFriction, anim.dynamicsFriction, @"expected equality; value1:%@ value2:%@", @(copy.dynamicsFriction), @(anim.dynamicsFriction));
   XCTAssertEqual(copy.dynamicsMass, anim.dynamicsMass, @"expected equality; value1:%@ value2:%@", @(copy.dynamicsMass), @(anim.dynamicsMass));
+  XCTAssertEqual(copy.solverMode, anim.solverMode, @"expected equality; value1:%@ value2:%@", @(copy.solverMode), @(anim.solverMode));
+  XCTAssertEqual(copy.solverTolerance, anim.solverTolerance, @"expected equality; value1:%@ value2:%@", @(copy.solverTolerance), @(anim.solverTolerance));
+}
+
+- (void)testAdaptiveSolverMatchesIntegratedSolver
+{
+  // underdamped, critically damped and overdamped springs
+  static const double constants[][3] = {{342, 30, 1}, {200, 10, 1}, {100, 20, 1}, {990, 230, 1}};
+
+  for (size_t idx = 0; idx < POP_ARRAY_COUNT(constants); idx++) {
+    SpringSolver4d integrated(constants[idx][0], constants[idx][1], constants[idx][2]);
+    SpringSolver4d adaptive(constants[idx][0], constants[idx][1], constants[idx][2]);
+    adaptive.setMode(kSpringSolverModeAdaptive);
+    integrated.setThreshold(0.01);
+    adaptive.setThreshold(0.01);
+
+    SSState4d integratedState, adaptiveState;
+    integratedState.p = adaptiveState.p = Vector4d(100, -50, 10, 0);
+    integratedState.v = adaptiveState.v = Vector4d(-200, 400, 0, 1000);
+
+    NSUInteger integratedSteps = 0, adaptiveSteps = 0;
+    CFTimeInterval t = 0;
+    for (NSUInteger frame = 0; frame < 240 && !integrated.hasConverged(); frame++) {
+      integrated.advance(integratedState, t, 1.0/60.0);
+      adaptive.advance(adaptiveState, t, 1.0/60.0);
+      integratedSteps += integrated.stepCount();
+      adaptiveSteps += adaptive.stepCount();
+      t += 1.0/60.0;
+
+      // differences stay well below the convergence threshold of a point
+      for (size_t i = 0; i < 4; i++) {
+        XCTAssertEqualWithAccuracy(integratedState.p[i], adaptiveState.p[i], 0.1, @"unexpected position constants:%zu frame:%lu", idx, (unsigned long)frame);
+      }
+    }
+
+    XCTAssertTrue(adaptive.hasConverged(), @"unexpected convergence constants:%zu", idx);
+    XCTAssertTrue(adaptiveSteps * 5 <= integratedSteps, @"unexpected step count constants:%zu adaptive:%lu integrated:%lu", idx, (unsigned long)adaptiveSteps, (unsigned long)integratedSteps);
+  }
+}
+
+- (void)testAnalyticSolverMatchesIntegratedSolver
+{
+  // underdamped, critically damped and overdamped springs
+  static const double constants[][3] = {{342, 30, 1}, {1000, 5, 1}, {100, 20, 1}, {100, 40, 1}, {990, 230, 1}};
+
+  for (size_t idx = 0; idx < POP_ARRAY_COUNT(constants); idx++) {
+    SpringSolver4d integrated(constants[idx][0], constants[idx][1], constants[idx][2]);
+    SpringSolver4d analytic(constants[idx][0], constants[idx][1], constants[idx][2]);
+    analytic.setMode(kSpringSolverModeAnalytic);
+
+    SSState4d integratedState, analyticState;
+    integratedState.p = analyticState.p = Vector4d(100, -50, 10, 0);
+    integratedState.v = analyticState.v = Vector4d(-200, 400, 0, 1000);
+
+    // documented tolerance, relative to spring displacement
+    const double epsilon = 1e-6 * 100;
+
+    CFTimeInterval t = 0;
+    for (NSUInteger frame = 0; frame < 240; frame++) {
+      CFTimeInterval dt = (0 == frame % 7) ? 1.0/30.0 : 1.0/60.0;
+      integrated.advance(integratedState, t, dt);
+      analytic.advance(analyticState, t, dt);
+      t += dt;
+
+      for (size_t i = 0; i < 4; i++) {
+        XCTAssertEqualWithAccuracy(integratedState.p[i], analyticState.p[i], epsilon, @"unexpected position constants:%zu frame:%lu", idx, (unsigned long)frame);
+      }
+    }
+
+    XCTAssertEqual(integrated.hasConverged(), analytic.hasConverged(), @"unexpected convergence constants:%zu", idx);
+  }
+}
+
+- (void)testSpringBatchMatchesSolver
+{
+  static const NSUInteger count = 64;
+  std::vector<SpringSolver4d *> solvers, batchSolvers;
+  std::vector<SSState4d> states(count), batchStates(count);
+
+  for (NSUInteger idx = 0; idx < count; idx++) {
+    double k = 100 + (idx % 8) * 50, b = 10 + (idx % 5) * 4;
+    solvers.push_back(new SpringSolver4d(k, b, 1));
+    batchSolvers.push_back(new SpringSolver4d(k, b, 1));
+    states[idx].p = Vector4d(100 + idx, -50, 10, 0);
+    states[idx].v = Vector4d(-200, 400, 0, idx);
+    batchStates[idx] = states[idx];
+  }
+
+  SpringBatch batch;
+  CFTimeInterval t = 0;
+  for (NSUInteger frame = 0; frame < 120; frame++) {
+    CFTimeInterval dt = (0 == frame % 5) ? 1.0/30.0 : 1.0/60.0;
+
+    batch.clear();
+    for (NSUInteger idx = 0; idx < count; idx++) {
+      solvers[idx]->advance(states[idx], t, dt);
+
+      SSTransition tr = batchSolvers[idx]->integratedTransition(solverDt);
+      for (size_t i = 0; i < 4; i++) {
+        batch.addLane(batchStates[idx].p[i], batchStates[idx].v[i], batchSolvers[idx]->lastDv()[i], batchSolvers[idx]->accumulatedTime(), dt, tr.pp, tr.pv, tr.vp, tr.vv);
+      }
+    }
+    batch.advance(solverDt);
+
+    for (NSUInteger idx = 0; idx < count; idx++) {
+      Vector4d dv;
+      for (size_t i = 0; i < 4; i++) {
+        batchStates[idx].p[i] = batch.position(idx * 4 + i);
+        batchStates[idx].v[i] = batch.velocity(idx * 4 + i);
+        dv[i] = batch.acceleration(idx * 4 + i);
+        XCTAssertEqualWithAccuracy(states[idx].p[i], batchStates[idx].p[i], 1e-6, @"unexpected position spring:%lu frame:%lu", (unsigned long)idx, (unsigned long)frame);
+      }
+      NSUInteger steps = (NSUInteger)llround((batchSolvers[idx]->accumulatedTime() + dt - batch.accumulatedTime(idx * 4)) / solverDt);
+      batchSolvers[idx]->didAdvance(batchStates[idx], dv, batch.accumulatedTime(idx * 4), steps);
+      XCTAssertEqual(solvers[idx]->stepCount(), batchSolvers[idx]->stepCount(), @"unexpected step count spring:%lu frame:%lu", (unsigned long)idx, (unsigned long)frame);
+      XCTAssertEqual(solvers[idx]->hasConverged(), batchSolvers[idx]->hasConverged(), @"unexpected convergence spring:%lu frame:%lu", (unsigned long)idx, (unsigned long)frame);
+    }
+    t += dt;
+  }
+
+  for (NSUInteger idx = 0; idx < count; idx++) {
+    delete solvers[idx];
+    delete batchSolvers[idx];
+  }
+}
+
+- (void)testManyConcurrentSprings
+{
+  static const NSUInteger count = 200;
+  NSMutableArray *layers = [NSMutableArray arrayWithCapacity:count];
+  NSMutableArray *anims = [NSMutableArray arrayWithCapacity:count];
+
+  for (NSUInteger idx = 0; idx < count; idx++) {
+    POPSpringAnimation *anim = [POPSpringAnimation animationWithPropertyNamed:(idx % 2) ? kPOPLayerPosition : kPOPLayerOpacity];
+    anim.fromValue = (idx % 2) ? [NSValue valueWithCGPoint:CGPointZero] : @0.0;
+    anim.toValue = (idx % 2) ? [NSValue valueWithCGPoint:CGPointMake(idx, 2 * idx)] : @1.0;
+    anim.springBounciness = idx % 20;
+
+    CALayer *layer = [CALayer layer];
+    [layer pop_addAnimation:anim forKey:animationKey];
+    [layers addObject:layer];
+    [anims addObject:anim];
+  }
+
+  POPAnimatorRenderDuration(self.animator, self.beginTime, 5, 1.0/60.0);
+
+  // all springs settled on their to value
+  [layers enumerateObjectsUsingBlock:^(CALayer *layer, NSUInteger idx, BOOL *stop) {
+    XCTAssertNil([layer pop_animationForKey:animationKey], @"unexpected running animation %@", anims[idx]);
+    if (idx % 2) {
+      XCTAssertTrue(CGPointEqualToPoint(layer.position, CGPointMake(idx, 2 * idx)), @"unexpected value:%@ %@", layer, anims[idx]);
+    } else {
+      XCTAssertEqualWithAccuracy(layer.opacity, 1.0, 1e-6, @"unexpected value:%@ %@", layer, anims[idx]);
+    }
+  }];
+}
+
+- (void)testSpecializedSolverStateMatchesVector4d
+{
+  static const SpringSolverMode modes[] = {kSpringSolverModeIntegrated, kSpringSolverModeAnalytic, kSpringSolverModeAdaptive};
+
+  for (size_t idx = 0; idx < POP_ARRAY_COUNT(modes); idx++) {
+    SpringSolver4d solver(342, 30, 1);
+    SpringSolver4d scalarSolver(342, 30, 1);
+    SpringSolver4d solver1d(342, 30, 1);
+    SpringSolver4d solver2d(342, 30, 1);
+    solver.setMode(modes[idx]);
+    scalarSolver.setMode(modes[idx]);
+    solver1d.setMode(modes[idx]);
+    solver2d.setMode(modes[idx]);
+
+    // adaptive step sizes depend on all components, compare states of equal values
+    SSState4d state;
+    state.p = Vector4d(100, -50, 0, 0);
+    state.v = Vector4d(-200, 400, 0, 0);
+
+    SSState4d scalarState;
+    scalarState.p = Vector4d(100, 0, 0, 0);
+    scalarState.v = Vector4d(-200, 0, 0, 0);
+
+    SSState1d state1d;
+    state1d.p = Vector1d(100);
+    state1d.v = Vector1d(-200);
+
+    SSState2d state2d;
+    state2d.p = Vector2d(100, -50);
+    state2d.v = Vector2d(-200, 400);
+
+    // advancing fewer components is exact, including convergence
+    CFTimeInterval t = 0;
+    for (NSUInteger frame = 0; frame < 120; frame++) {
+      solver.advance(state, t, 1.0/60.0);
+      scalarSolver.advance(scalarState, t, 1.0/60.0);
+      solver1d.advance(state1d, t, 1.0/60.0);
+      solver2d.advance(state2d, t, 1.0/60.0);
+      t += 1.0/60.0;
+
+      XCTAssertEqual(scalarState.p.x, state1d.p.x, @"unexpected position mode:%d frame:%lu", modes[idx], (unsigned long)frame);
+      XCTAssertEqual(scalarState.v.x, state1d.v.x, @"unexpected velocity mode:%d frame:%lu", modes[idx], (unsigned long)frame);
+      XCTAssertTrue(state.p.x == state2d.p.x && state.p.y == state2d.p.y, @"unexpected position mode:%d frame:%lu", modes[idx], (unsigned long)frame);
+      XCTAssertTrue(state.v.x == state2d.v.x && state.v.y == state2d.v.y, @"unexpected velocity mode:%d frame:%lu", modes[idx], (unsigned long)frame);
+      XCTAssertEqual(solver.lastDv().y, solver2d.lastDv().y, @"unexpected acceleration mode:%d frame:%lu", modes[idx], (unsigned long)frame);
+      XCTAssertEqual(solver1d.lastDv().y, 0., @"unexpected acceleration mode:%d frame:%lu", modes[idx], (unsigned long)frame);
+      XCTAssertEqual(scalarSolver.hasConverged(), solver1d.hasConverged(), @"unexpected convergence mode:%d frame:%lu", modes[idx], (unsigned long)frame);
+    }
+  }
+}
+
+- (void)testPredictedSettleTime
+{
+  // tension, friction, mass, position, velocity
+  static const double springs[][5] = {
+    {342, 30, 1, 100, 0},     // underdamped
+    {342, 30, 1, 100, -2000},
+    {342, 5, 1, 0, 500},
+    {100, 20, 1, 100, -3000}, // critically damped
+    {100, 40, 1, 100, 0},     // overdamped
+    {1000, 10, 2, 1, 0},
+  };
+
+  for (size_t idx = 0; idx < POP_ARRAY_COUNT(springs); idx++) {
+    const double *c = springs[idx];
+    SpringSolver1d solver(c[0], c[1], c[2]);
+    solver.setThreshold(0.01);
+
+    SSState1d state;
+    state.p = Vector1d(c[3]);
+    state.v = Vector1d(c[4]);
+
+    double settleTime = solver.settleTime(state);
+    XCTAssertTrue(settleTime > 0 && settleTime < 5, @"unexpected settle time:%f spring:%lu", settleTime, (unsigned long)idx);
+
+    // converged on every frame from the predicted time on
+    CFTimeInterval t = 0;
+    while (t < settleTime + 5) {
+      solver.advance(state, t, 1.0/60.0);
+      t += 1.0/60.0;
+      if (t >= settleTime) {
+        XCTAssertTrue(solver.hasConverged(), @"unexpected convergence time:%f settle time:%f spring:%lu", t, settleTime, (unsigned long)idx);
+      }
+    }
+  }
+
+  // undamped springs never settle, springs without a closed form are not predicted
+  SSState1d state;
+  state.p = Vector1d(100);
+  state.v = Vector1d(0);
+  SpringSolver1d undamped(342, 0, 1);
+  XCTAssertTrue(isinf(undamped.settleTime(state)), @"unexpected settle time");
+  SpringSolver1d massless(342, 30, 0);
+  XCTAssertTrue(massless.settleTime(state) < 0, @"unexpected settle time");
+}
+
+- (void)testPredictedOvershoot
+{
+  // tension, friction, mass, position, velocity, overshoot
+  static const double springs[][6] = {
+    {342, 30, 1, 100, 0, 1.28218},
+    {342, 30, 1, 100, -2000, 5.59265},
+    {342, 30, 1, 100, 2000, 1.61834},
+    {342, 5, 1, 0, 500, 14.47975},
+    {100, 20, 1, 100, 0, 0},         // critically damped, no overshoot
+    {100, 20, 1, 100, -3000, 44.62603},
+    {100, 40, 1, 100, -3000, 0},     // overdamped, no overshoot
+    {200, 14, 1, 300, 50, 50.11083},
+  };
+
+  for (size_t idx = 0; idx < POP_ARRAY_COUNT(springs); idx++) {
+    const double *c = springs[idx];
+    SpringSolver2d solver(c[0], c[1], c[2]);
+
+    // overshoot is independent per component and symmetric
+    SSState2d state;
+    state.p = Vector2d(c[3], -c[3]);
+    state.v = Vector2d(c[4], -c[4]);
+    Vector2d overshoot = solver.peakOvershoot(state);
+    XCTAssertEqualWithAccuracy(overshoot.x, c[5], 1e-3, @"unexpected overshoot spring:%lu", (unsigned long)idx);
+    XCTAssertEqualWithAccuracy(overshoot.y, c[5], 1e-3, @"unexpected overshoot spring:%lu", (unsigned long)idx);
+  }
+}
+
+- (void)testPredictedSettleDuration
+{
+  POPSpringAnimation *anim = self._positionAnimation;
+  anim.toValue = @100.0;
+  anim.springBounciness = 12;
+
+  CFTimeInterval settleDuration = anim.predictedSettleDuration;
+  XCTAssertTrue(settleDuration > 0, @"unexpected settle duration %f", settleDuration);
+  XCTAssertTrue([anim.predictedOvershoot floatValue] > 0, @"unexpected overshoot %@", anim.predictedOvershoot);
+
+  // completes no later than predicted
+  CALayer *layer = [CALayer layer];
+  [layer pop_addAnimation:anim forKey:animationKey];
+  POPAnimatorRenderDuration(self.animator, self.beginTime, settleDuration + 1.0/60.0, 1.0/60.0);
+  XCTAssertNil([layer pop_animationForKey:animationKey], @"unexpected running animation %@", anim);
+  XCTAssertEqual(layer.position.x, 100.0, @"unexpected value %@", anim);
+}
+
+- (void)testCachedSolverMatchesIntegratedSolver
+{
+  SpringResponseCache &cache = SpringResponseCache::sharedCache();
+
+  SpringSolver4d integrated(342, 30, 1);
+  SpringSolver4d cached(342, 30, 1);
+  cached.setMode(kSpringSolverModeCached);
+  cached.setTransitionTable(cache.response(342, 30, 1));
+  XCTAssertTrue(NULL != cached.transitionTable(), @"expected response");
+
+  SSState4d integratedState, cachedState;
+  integratedState.p = cachedState.p = Vector4d(100, -50, 10, 0);
+  integratedState.v = cachedState.v = Vector4d(-200, 400, 0, 1000);
+
+  // frames of varying duration, including one beyond the cached steps
+  CFTimeInterval t = 0;
+  for (NSUInteger frame = 0; frame < 300; frame++) {
+    CFTimeInterval dt = 5 == frame ? 0.2 : (0 == frame % 7 ? 1.0/30.0 : 1.0/60.0);
+    integrated.advance(integratedState, t, dt);
+    cached.advance(cachedState, t, dt);
+    t += dt;
+
+    for (size_t i = 0; i < 4; i++) {
+      XCTAssertEqualWithAccuracy(integratedState.p[i], cachedState.p[i], 1e-6 * 100, @"unexpected position frame:%lu", (unsigned long)frame);
+    }
+    XCTAssertEqual(integrated.hasConverged(), cached.hasConverged(), @"unexpected convergence frame:%lu", (unsigned long)frame);
+  }
+
+  // springs without a closed form are not cached
+  XCTAssertTrue(NULL == cache.response(0, 30, 1), @"unexpected response");
+}
+
+- (void)testResponseCache
+{
+  NSUInteger memoryLimit = [POPSpringAnimation responseCacheMemoryLimit];
+  NSUInteger hitCount = [POPSpringAnimation responseCacheHitCount];
+  NSUInteger missCount = [POPSpringAnimation responseCacheMissCount];
+
+  // identical springs share one response
+  CALayer *layer = [CALayer layer];
+  NSMutableArray *anims = [NSMutableArray array];
+  for (NSUInteger idx = 0; idx < 10; idx++) {
+    POPSpringAnimation *anim = self._positionAnimation;
+    anim.toValue = @100.0;
+    anim.dynamicsTension = 313.37;
+    anim.dynamicsFriction = 27.1828;
+    anim.dynamicsMass = 1;
+    anim.solverMode = kPOPSpringSolverModeCached;
+    [layer pop_addAnimation:anim forKey:[NSString stringWithFormat:@"%@%lu", animationKey, (unsigned long)idx]];
+    [anims addObject:anim];
+  }
+  XCTAssertEqual([POPSpringAnimation responseCacheMissCount] - missCount, (NSUInteger)1, @"unexpected miss count");
+  XCTAssertTrue([POPSpringAnimation responseCacheHitCount] - hitCount >= 9, @"unexpected hit count");
+  XCTAssertTrue([POPSpringAnimation responseCacheMemoryUsage] > 0, @"unexpected memory usage");
+
+  // cached springs complete like integrated ones
+  POPAnimatorRenderDuration(self.animator, self.beginTime, 3, 1.0/60.0);
+  XCTAssertEqual(layer.position.x, 100.0, @"unexpected value %@", anims.lastObject);
+  XCTAssertEqual([layer pop_animationKeys].count, (NSUInteger)0, @"unexpected running animations");
+
+  // memory limit evicts responses
+  [POPSpringAnimation setResponseCacheMemoryLimit:0];
+  XCTAssertEqual([POPSpringAnimation responseCacheMemoryUsage], (NSUInteger)0, @"unexpected memory usage");
+  [POPSpringAnimation setResponseCacheMemoryLimit:memoryLimit];
+}
+
+- (void)testAnalyticSolverMode
+{
+  POPSpringAnimation *anim = self._positionAnimation;
+  anim.toValue = @100.0;
+  anim.velocity = @100.0;
+  anim.solverMode = kPOPSpringSolverModeAnalytic;
+
+  id delegate = [OCMockObject niceMockForProtocol:@protocol(POPAnimationDelegate)];
+  anim.delegate = delegate;
+
+  // expect start and stop to be called
+  [[delegate expect] pop_animationDidStart:anim];
+  [[delegate expect] pop_animationDidStop:anim finished:YES];
+
+  POPAnimationTracer *tracer = anim.tracer;
+  [tracer start];
+
+  CALayer *layer = [CALayer layer];
+  [layer pop_addAnimation:anim forKey:animationKey];
+  POPAnimatorRenderDuration(self.animator, self.beginTime, 3, 1.0/60.0);
+
+  // verify start stop
+  [delegate verify];
+
+  // verify interpolation and last write event value
+  NSArray *writeEvents = [tracer eventsWithType:kPOPAnimationEventPropertyWrite];
+  XCTAssertTrue(writeEvents.count > 5, @"unexpected frame count %@", writeEvents);
+  POPAnimationValueEvent *writeEvent = [writeEvents lastObject];
+  XCTAssertEqualObjects(writeEvent.value, anim.toValue, @"unexpected last write event %@", writeEvent);
+}
+
+
+- (void)testVector4ArithmeticMatchesComponents
+{
+  const Vector4d a(1.5, -2.25, 1e-3, 7), b(0.1, 3, -4e5, 1. / 3);
+  const double s = 0.3;
+
+  // vectorized arithmetic is exact per component
+  for (size_t idx = 0; idx < 4; idx++) {
+    XCTAssertEqual((a + b)[idx], a[idx] + b[idx]);
+    XCTAssertEqual((a - b)[idx], a[idx] - b[idx]);
+    XCTAssertEqual((a + s)[idx], a[idx] + s);
+    XCTAssertEqual((a - s)[idx], a[idx] - s);
+    XCTAssertEqual((a * s)[idx], a[idx] * s);
+    XCTAssertEqual((a / s)[idx], a[idx] / s);
+  }
+  XCTAssertEqual(a.squaredNorm(), (a.x * a.x + a.y * a.y) + (a.z * a.z + a.w * a.w));
+
+  const Vector4f f(1.5f, -2.25f, 1e-3f, 7.f);
+  Vector4f g = f;
+  g *= 0.3f;
+  g += f;
+  for (size_t idx = 0; idx < 4; idx++) {
+    XCTAssertEqual(g[idx], f[idx] * 0.3f + f[idx]);
+  }
+  XCTAssertEqual(f.squaredNorm(), (CGFloat)((f.x * f.x + f.y * f.y) + (f.z * f.z + f.w * f.w)));
+
+  // components are contiguous
+  XCTAssertEqual(a.data() + 3, &a.w);
+}
+
+- (void)testIntegrationPerformance
+{
+  // RK4 steps of a four component spring; build with POP_VECTOR_NO_SIMD to compare against scalar vectors
+  [self measureBlock:^{
+    SpringSolver4d solver(300, 10, 1);
+    SSState4d state;
+    state.p = Vector4d(100, -50, 20, 3);
+    state.v = Vector4d(10, 0, -5, 1);
+    for (NSUInteger idx = 0; idx < 100000; idx++) {
+      solver.integrate(state, idx * solverDt, solverDt);
+    }
+    XCTAssertTrue(state.p.squaredNorm() < 1);
+  }];
 }
 
 @end
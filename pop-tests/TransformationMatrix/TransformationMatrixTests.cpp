@@ -0,0 +1,289 @@
+/**
+ Copyright (c) 2014-present, Facebook, Inc.
+ All rights reserved.
+
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree. An additional grant
+ of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+/**
+ Checks of TransformationMatrix that need no Apple SDK, mirroring those of POPAnimatablePropertyTests: the 2D
+ affine decompose and recompose match the general ones, and the 4x4 kernels match their scalar versions. Run with
+ --benchmark to also time them. Built against the stub headers in stubs/; see the Makefile.
+ */
+
+#include "TransformationMatrix.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace WebCore;
+
+static const size_t kTransformSampleCount = 10000;
+
+static unsigned _failures = 0;
+
+static void check(bool condition, const char *what, size_t idx)
+{
+  if (!condition) {
+    if (_failures < 20) {
+      fprintf(stderr, "FAIL: %s (sample %zu)\n", what, idx);
+    }
+    _failures++;
+  }
+}
+
+// relative difference, absolute below one
+static double difference(double v1, double v2)
+{
+  return fabs(v1 - v2) / std::max(fabs(v2), 1.);
+}
+
+// random 2D affine matrices, a fifth of them singular, mirrored or built from components; deterministic. Singular
+// matrices have a zero row, as the determinant of dependent rows need not round to zero under FMA contraction
+static TransformationMatrix randomAffineMatrix(unsigned short seed[3])
+{
+  double a = erand48(seed) * 6 - 3, b = erand48(seed) * 6 - 3, c = erand48(seed) * 6 - 3, d = erand48(seed) * 6 - 3;
+  double tx = erand48(seed) * 600 - 300, ty = erand48(seed) * 600 - 300;
+  switch (nrand48(seed) % 5) {
+    case 0:
+      return TransformationMatrix(a, b, 0, 0, tx, ty);
+    case 1:
+      return TransformationMatrix(a, b, c, d, tx, ty).scaleNonUniform(-1, 1);
+    case 2: {
+      TransformationMatrix m;
+      m.translate(tx, ty).rotate3d(0, 0, 1, a * 60).scaleNonUniform(c, d);
+      return m;
+    }
+    default:
+      return TransformationMatrix(a, b, c, d, tx, ty);
+  }
+}
+
+// random 4x4 matrices, including perspective; deterministic
+static void randomMatrix4(unsigned short seed[3], TransformationMatrix::Matrix4 &m)
+{
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 4; j++) {
+      m[i][j] = erand48(seed) * 4 - 2;
+    }
+  }
+}
+
+static double decompositionDifference(const TransformationMatrix::DecomposedType &d1, const TransformationMatrix::DecomposedType &d2)
+{
+  const double *f1 = (const double *)&d1;
+  const double *f2 = (const double *)&d2;
+  double diff = 0;
+  for (size_t idx = 0; idx < sizeof(d1) / sizeof(double); idx++) {
+    diff = std::max(diff, fabs(f1[idx] - f2[idx]));
+  }
+  return diff;
+}
+
+static double matrixDifference(const TransformationMatrix &m1, const TransformationMatrix &m2)
+{
+  CATransform3D t1 = m1.transform3d();
+  CATransform3D t2 = m2.transform3d();
+  const CGFloat *f1 = (const CGFloat *)&t1;
+  const CGFloat *f2 = (const CGFloat *)&t2;
+  double diff = 0;
+  for (size_t idx = 0; idx < 16; idx++) {
+    diff = std::max(diff, difference(f1[idx], f2[idx]));
+  }
+  return diff;
+}
+
+static double matrix4Difference(const TransformationMatrix::Matrix4 &m1, const TransformationMatrix::Matrix4 &m2)
+{
+  double diff = 0;
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 4; j++) {
+      diff = std::max(diff, difference(m1[i][j], m2[i][j]));
+    }
+  }
+  return diff;
+}
+
+static void testAffineDecompositionMatchesGeneral()
+{
+  double decomposeDiff = 0;
+  double recomposeDiff = 0;
+  double roundTripDiff = 0;
+
+  unsigned short seed[3] = {1, 2, 3};
+  for (size_t idx = 0; idx < kTransformSampleCount; idx++) {
+    TransformationMatrix m = randomAffineMatrix(seed);
+    check(m.isAffine(), "affine", idx);
+
+    TransformationMatrix::DecomposedType affine, general;
+    bool decomposed = m.decompose(affine);
+    check(decomposed == m.decomposeGeneral(general), "decomposable as the general path", idx);
+    if (!decomposed) {
+      continue;
+    }
+    decomposeDiff = std::max(decomposeDiff, decompositionDifference(affine, general));
+
+    // both rotation forms recompose as the general path does, and round trip
+    for (int useEulerAngle = 0; useEulerAngle < 2; useEulerAngle++) {
+      TransformationMatrix r1, r2;
+      r1.recompose(affine, useEulerAngle);
+      r2.recomposeGeneral(affine, useEulerAngle);
+      recomposeDiff = std::max(recomposeDiff, matrixDifference(r1, r2));
+    }
+    TransformationMatrix r;
+    r.recompose(affine);
+    roundTripDiff = std::max(roundTripDiff, matrixDifference(r, m));
+  }
+  check(decomposeDiff <= 1e-12, "decompose matches general", 0);
+  check(recomposeDiff <= 1e-5, "recompose matches general", 0);
+  check(roundTripDiff <= 1e-5, "recompose round trips", 0);
+
+  // perspective and 3D decompositions take the general path
+  TransformationMatrix p;
+  p.applyPerspective(500).rotate3d(1, 0, 0, 30);
+  check(!p.isAffine(), "perspective not affine", 0);
+  TransformationMatrix::DecomposedType d1, d2;
+  check(p.decompose(d1) && p.decomposeGeneral(d2), "perspective decomposable", 0);
+  check(0 == decompositionDifference(d1, d2), "perspective decompose is general", 0);
+
+  printf("affine decompose: max difference %g, recompose %g, round trip %g\n", decomposeDiff, recomposeDiff, roundTripDiff);
+}
+
+static void testMatrixKernelsMatchScalar()
+{
+  double multiplyDiff = 0;
+  double mapDiff = 0;
+  double inverseDiff = 0;
+
+  unsigned short seed[3] = {1, 2, 3};
+  for (size_t idx = 0; idx < kTransformSampleCount; idx++) {
+    TransformationMatrix::Matrix4 a, b, r1, r2;
+    randomMatrix4(seed, a);
+    randomMatrix4(seed, b);
+
+    // products and maps sum in the scalar order, up to contraction of the scalar code; transposes move elements
+    TransformationMatrix::multiplyMatrix4(a, b, r1);
+    TransformationMatrix::multiplyMatrix4Scalar(a, b, r2);
+    multiplyDiff = std::max(multiplyDiff, matrix4Difference(r1, r2));
+
+    TransformationMatrix::transposeMatrix4(a, r1);
+    TransformationMatrix::transposeMatrix4Scalar(a, r2);
+    check(0 == matrix4Difference(r1, r2), "transpose matches scalar", idx);
+
+    double p[4] = {erand48(seed) * 100, erand48(seed) * 100, erand48(seed) * 100, 1}, q1[4], q2[4];
+    TransformationMatrix::mapPoint4(p, a, q1);
+    TransformationMatrix::mapPoint4Scalar(p, a, q2);
+    for (int i = 0; i < 4; i++) {
+      mapDiff = std::max(mapDiff, difference(q1[i], q2[i]));
+    }
+
+    // inverses round differently, by up to about 1e-10 relative over many samples
+    bool inverted = TransformationMatrix::inverseMatrix4(a, r1);
+    check(inverted == TransformationMatrix::inverseMatrix4Scalar(a, r2), "invertible as scalar", idx);
+    if (inverted) {
+      inverseDiff = std::max(inverseDiff, matrix4Difference(r1, r2));
+    }
+  }
+  check(multiplyDiff <= 1e-12, "multiply matches scalar", 0);
+  check(mapDiff <= 1e-12, "map matches scalar", 0);
+  check(inverseDiff <= 1e-6, "inverse matches scalar", 0);
+
+  // singular matrices report as the scalar version does
+  TransformationMatrix::Matrix4 s = {{1, 2, 3, 4}, {2, 4, 6, 8}, {0, 0, 1, 0}, {0, 0, 0, 1}}, r1, r2;
+  check(!TransformationMatrix::inverseMatrix4(s, r1), "singular not inverted", 0);
+  check(!TransformationMatrix::inverseMatrix4Scalar(s, r2), "singular not inverted by scalar", 0);
+  check(0 == matrix4Difference(r1, r2), "singular result matches scalar", 0);
+
+  printf("matrix kernels: max relative difference multiply %g, map %g, inverse %g\n", multiplyDiff, mapDiff, inverseDiff);
+}
+
+template <class Block>
+static double nanosecondsPerCall(size_t calls, Block block)
+{
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  block();
+  std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count() / calls;
+}
+
+static void benchmarkAffineDecomposition()
+{
+  // decompose and recompose of layer transforms, against decomposeGeneral and recomposeGeneral
+  unsigned short seed[3] = {1, 2, 3};
+  std::vector<TransformationMatrix> matrices;
+  for (size_t idx = 0; idx < 1000; idx++) {
+    TransformationMatrix m;
+    m.translate(erand48(seed) * 100, erand48(seed) * 100).rotate3d(0, 0, 1, erand48(seed) * 360).scaleNonUniform(0.5 + erand48(seed), 0.5 + erand48(seed));
+    matrices.push_back(m);
+  }
+
+  for (int general = 0; general < 2; general++) {
+    double sum = 0;
+    double ns = nanosecondsPerCall(1000 * matrices.size(), [&]() {
+      for (size_t pass = 0; pass < 1000; pass++) {
+        for (const TransformationMatrix &m : matrices) {
+          TransformationMatrix::DecomposedType d;
+          TransformationMatrix r;
+          if (general) {
+            m.decomposeGeneral(d);
+            d.scaleX *= 1.01;
+            r.recomposeGeneral(d);
+          } else {
+            m.decompose(d);
+            d.scaleX *= 1.01;
+            r.recompose(d);
+          }
+          sum += r.m11();
+        }
+      }
+    });
+    check(std::isfinite(sum), "finite benchmark result", 0);
+    printf("%s decompose and recompose: %.1f ns\n", general ? "general" : "affine", ns);
+  }
+}
+
+static void benchmarkMatrixKernels()
+{
+  // products and inverses of 4x4 matrices; build with POP_TRANSFORM_NO_SIMD to compare against the scalar kernels
+  unsigned short seed[3] = {1, 2, 3};
+  std::vector<TransformationMatrix> matrices(1000);
+  for (TransformationMatrix &m : matrices) {
+    m.applyPerspective(500).rotate3d(erand48(seed), erand48(seed), erand48(seed), erand48(seed) * 360).translate3d(erand48(seed) * 100, erand48(seed) * 100, erand48(seed) * 100);
+  }
+
+  double sum = 0;
+  double ns = nanosecondsPerCall(1000 * matrices.size(), [&]() {
+    for (size_t pass = 0; pass < 1000; pass++) {
+      for (const TransformationMatrix &m : matrices) {
+        TransformationMatrix product = m.inverse().multiply(m);
+        sum += product.m11();
+      }
+    }
+  });
+  check(std::isfinite(sum), "finite benchmark result", 0);
+  printf("inverse and multiply: %.1f ns\n", ns);
+}
+
+int main(int argc, char *argv[])
+{
+  testAffineDecompositionMatchesGeneral();
+  testMatrixKernelsMatchScalar();
+
+  if (argc > 1 && 0 == strcmp(argv[1], "--benchmark")) {
+    benchmarkAffineDecomposition();
+    benchmarkMatrixKernels();
+  }
+
+  if (0 != _failures) {
+    fprintf(stderr, "%u failures\n", _failures);
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,16 @@
+/**
+ Copyright (c) 2014-present, Facebook, Inc.
+ All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree. An additional grant
+ of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#ifndef POP_STUB_COREGRAPHICS_H
+#define POP_STUB_COREGRAPHICS_H
+
+#include <CoreGraphics/CGBase.h>
+#include <CoreGraphics/CGAffineTransform.h>
+
+#endif
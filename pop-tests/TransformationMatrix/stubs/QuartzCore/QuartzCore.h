@@ -0,0 +1,26 @@
+/**
+ Copyright (c) 2014-present, Facebook, Inc.
+ All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree. An additional grant
+ of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+// Minimal QuartzCore stand-in for building TransformationMatrix without Apple SDKs.
+
+#ifndef POP_STUB_QUARTZCORE_H
+#define POP_STUB_QUARTZCORE_H
+
+#include <CoreGraphics/CGBase.h>
+
+struct CATransform3D
+{
+  CGFloat m11, m12, m13, m14;
+  CGFloat m21, m22, m23, m24;
+  CGFloat m31, m32, m33, m34;
+  CGFloat m41, m42, m43, m44;
+};
+typedef struct CATransform3D CATransform3D;
+
+#endif
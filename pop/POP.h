@@ -22,6 +22,7 @@
 #import <pop/POPBasicAnimation.h>
 #import <pop/POPCustomAnimation.h>
 #import <pop/POPDecayAnimation.h>
+#import <pop/POPFrameSource.h>
 #import <pop/POPGeometry.h>
 #import <pop/POPLayerExtras.h>
 #import <pop/POPPropertyAnimation.h>
@@ -13,6 +13,7 @@
 #import <QuartzCore/CATransaction.h>
 
 #import <pop/POPDefines.h>
+#import <pop/POPLayerExtras.h>
 
 #ifdef __cplusplus
 
@@ -41,7 +42,7 @@ namespace POP {
   
   /**
    @abstract Enables Core Animation actions using RAII.
-   @discussion The enablement of actions is scoped to the current transaction.
+   @discussion The enablement of actions is scoped to the current transaction. Layer transforms batched on the calling thread are written first, so that callouts made within the scope read and set current transforms.
    */
   class ActionEnabler
   {
@@ -50,6 +51,7 @@ namespace POP {
   public:
     ActionEnabler() POP_NOTHROW
     {
+      POPLayerFlushTransformBatch();
       state = [CATransaction disableActions];
       [CATransaction setDisableActions:NO];
     }
@@ -34,7 +34,7 @@
  @param name The name of the property.
  @param block The block used to configure the property on creation.
  @return The animatable property with name if it exists, otherwise a newly created instance configured by block.
- @discussion Custom properties should use reverse-DNS naming. A newly created instance is only mutable in the scope of block. Once constructed, a property becomes immutable.
+ @discussion Custom properties should use reverse-DNS naming. A newly created instance is only mutable in the scope of block. Once constructed, a property becomes immutable. Properties with a name are cached by it, so block runs only until a property with that name exists; later calls, from any thread, return the cached property. Concurrent first calls may each run block, and all return the same property.
  */
 + (id)propertyWithName:(NSString *)name initializer:(void (^)(POPMutableAnimatableProperty *prop))block;
 
@@ -8,6 +8,13 @@
  */
 
 #import "POPAnimatableProperty.h"
+#import "POPAnimatablePropertyInternal.h"
+
+#import <atomic>
+#import <memory>
+#import <vector>
+
+#import <pthread.h>
 
 #import <QuartzCore/QuartzCore.h>
 
@@ -15,6 +22,7 @@
 #import "POPCGUtils.h"
 #import "POPDefines.h"
 #import "POPLayerExtras.h"
+#import "POPPerfectHash.h"
 
 // common threshold definitions
 static CGFloat const kPOPThresholdColor = 0.01;
@@ -172,957 +180,994 @@ typedef struct
 } _POPStaticAnimatablePropertyState;
 typedef _POPStaticAnimatablePropertyState POPStaticAnimatablePropertyState;
 
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Wglobal-constructors"
-static POPStaticAnimatablePropertyState _staticStates[] =
+/**
+ Returns the static property states, built on first use rather than by a global constructor at image load.
+ */
+static POPStaticAnimatablePropertyState *staticStates(NSUInteger *count)
 {
-  /* CALayer */
-
-  {kPOPLayerBackgroundColor,
-    ^(CALayer *obj, CGFloat values[]) {
-      POPCGColorGetRGBAComponents(obj.backgroundColor, values);
-    },
-    ^(CALayer *obj, const CGFloat values[]) {
-      CGColorRef color = POPCGColorRGBACreate(values);
-      [obj setBackgroundColor:color];
-      CGColorRelease(color);
-    },
-    kPOPThresholdColor
-  },
-
-  {kPOPLayerBounds,
-    ^(CALayer *obj, CGFloat values[]) {
-      values_from_rect(values, [obj bounds]);
-    },
-    ^(CALayer *obj, const CGFloat values[]) {
-      [obj setBounds:values_to_rect(values)];
-    },
-    kPOPThresholdPoint
-  },
-
-  {kPOPLayerCornerRadius,
-    ^(CALayer *obj, CGFloat values[]) {
-      values[0] = [obj cornerRadius];
-    },
-    ^(CALayer *obj, const CGFloat values[]) {
-      [obj setCornerRadius:values[0]];
-    },
-    kPOPThresholdRadius
-  },
-
-  {kPOPLayerBorderWidth,
-    ^(CALayer *obj, CGFloat values[]) {
-      values[0] = [obj borderWidth];
-    },
-    ^(CALayer *obj, const CGFloat values[]) {
-      [obj setBorderWidth:values[0]];
-    },
-    0.01
-  },
-
-  {kPOPLayerBorderColor,
-    ^(CALayer *obj, CGFloat values[]) {
-      POPCGColorGetRGBAComponents(obj.borderColor, values);
-    },
-    ^(CALayer *obj, const CGFloat values[]) {
-      CGColorRef color = POPCGColorRGBACreate(values);
-      [obj setBorderColor:color];
-      CGColorRelease(color);
-    },
-    kPOPThresholdColor
-  },
-
-  {kPOPLayerPosition,
-    ^(CALayer *obj, CGFloat values[]) {
-      values_from_point(values, [(CALayer *)obj position]);
-    },
-    ^(CALayer *obj, const CGFloat values[]) {
-      [obj setPosition:values_to_point(values)];
-    },
-    kPOPThresholdPoint
-  },
-
-  {kPOPLayerPositionX,
-    ^(CALayer *obj, CGFloat values[]) {
-      values[0] = [(CALayer *)obj position].x;
-    },
-    ^(CALayer *obj, const CGFloat values[]) {
-      CGPoint p = [(CALayer *)obj position];
-      p.x = values[0];
-      [obj setPosition:p];
-    },
-    kPOPThresholdPoint
-  },
-
-  {kPOPLayerPositionY,
-    ^(CALayer *obj, CGFloat values[]) {
-      values[0] = [(CALayer *)obj position].y;
-    },
-    ^(CALayer *obj, const CGFloat values[]) {
-      CGPoint p = [(CALayer *)obj position];
-      p.y = values[0];
-      [obj setPosition:p];
-    },
-    kPOPThresholdPoint
-  },
-
-  {kPOPLayerOpacity,
-    ^(CALayer *obj, CGFloat values[]) {
-      values[0] = [obj opacity];
-    },
-    ^(CALayer *obj, const CGFloat values[]) {
-      [obj setOpacity:((float)values[0])];
-    },
-    kPOPThresholdOpacity
-  },
-
-  {kPOPLayerScaleX,
-    ^(CALayer *obj, CGFloat values[]) {
-      values[0] = POPLayerGetScaleX(obj);
-    },
-    ^(CALayer *obj, const CGFloat values[]) {
-      POPLayerSetScaleX(obj, values[0]);
-    },
-    kPOPThresholdScale
-  },
-
-  {kPOPLayerScaleY,
-    ^(CALayer *obj, CGFloat values[]) {
-      values[0] = POPLayerGetScaleY(obj);
-    },
-    ^(CALayer *obj, const CGFloat values[]) {
-      POPLayerSetScaleY(obj, values[0]);
-    },
-    kPOPThresholdScale
-  },
-
-  {kPOPLayerScaleXY,
-    ^(CALayer *obj, CGFloat values[]) {
-      values_from_point(values, POPLayerGetScaleXY(obj));
-    },
-    ^(CALayer *obj, const CGFloat values[]) {
-      POPLayerSetScaleXY(obj, values_to_point(values));
-    },
-    kPOPThresholdScale
-  },
-
-  {kPOPLayerSubscaleXY,
-    ^(CALayer *obj, CGFloat values[]) {
-      values_from_point(values, POPLayerGetSubScaleXY(obj));
-    },
-    ^(CALayer *obj, const CGFloat values[]) {
-      POPLayerSetSubScaleXY(obj, values_to_point(values));
-    },
-    kPOPThresholdScale
-  },
-
-  {kPOPLayerTranslationX,
-    ^(CALayer *obj, CGFloat values[]) {
-      values[0] = POPLayerGetTranslationX(obj);
-    },
-    ^(CALayer *obj, const CGFloat values[]) {
-      POPLayerSetTranslationX(obj, values[0]);
-    },
-    kPOPThresholdPoint
-  },
-
-  {kPOPLayerTranslationY,
-    ^(CALayer *obj, CGFloat values[]) {
-      values[0] = POPLayerGetTranslationY(obj);
-    },
-    ^(CALayer *obj, const CGFloat values[]) {
-      POPLayerSetTranslationY(obj, values[0]);
-    },
-    kPOPThresholdPoint
-  },
-
-  {kPOPLayerTranslationZ,
-    ^(CALayer *obj, CGFloat values[]) {
-      values[0] = POPLayerGetTranslationZ(obj);
-    },
-    ^(CALayer *obj, const CGFloat values[]) {
-      POPLayerSetTranslationZ(obj, values[0]);
-    },
-    kPOPThresholdPoint
-  },
-
-  {kPOPLayerTranslationXY,
-    ^(CALayer *obj, CGFloat values[]) {
-      values_from_point(values, POPLayerGetTranslationXY(obj));
-    },
-    ^(CALayer *obj, const CGFloat values[]) {
-      POPLayerSetTranslationXY(obj, values_to_point(values));
-    },
-    kPOPThresholdPoint
-  },
-
-  {kPOPLayerSubtranslationX,
-    ^(CALayer *obj, CGFloat values[]) {
-      values[0] = POPLayerGetSubTranslationX(obj);
-    },
-    ^(CALayer *obj, const CGFloat values[]) {
-      POPLayerSetSubTranslationX(obj, values[0]);
-    },
-    kPOPThresholdPoint
-  },
-
-  {kPOPLayerSubtranslationY,
-    ^(CALayer *obj, CGFloat values[]) {
-      values[0] = POPLayerGetSubTranslationY(obj);
-    },
-    ^(CALayer *obj, const CGFloat values[]) {
-      POPLayerSetSubTranslationY(obj, values[0]);
-    },
-    kPOPThresholdPoint
-  },
-
-  {kPOPLayerSubtranslationZ,
-    ^(CALayer *obj, CGFloat values[]) {
-      values[0] = POPLayerGetSubTranslationZ(obj);
-    },
-    ^(CALayer *obj, const CGFloat values[]) {
-      POPLayerSetSubTranslationZ(obj, values[0]);
-    },
-    kPOPThresholdPoint
-  },
-
-  {kPOPLayerSubtranslationXY,
-    ^(CALayer *obj, CGFloat values[]) {
-      values_from_point(values, POPLayerGetSubTranslationXY(obj));
-    },
-    ^(CALayer *obj, const CGFloat values[]) {
-      POPLayerSetSubTranslationXY(obj, values_to_point(values));
-    },
-    kPOPThresholdPoint
-  },
-
-  {kPOPLayerZPosition,
-    ^(CALayer *obj, CGFloat values[]) {
-      values[0] = [obj zPosition];
-    },
-    ^(CALayer *obj, const CGFloat values[]) {
-      [obj setZPosition:values[0]];
-    },
-    kPOPThresholdPoint
-  },
-
-  {kPOPLayerSize,
-    ^(CALayer *obj, CGFloat values[]) {
-      values_from_size(values, [obj bounds].size);
-    },
-    ^(CALayer *obj, const CGFloat values[]) {
-      CGSize size = values_to_size(values);
-      if (size.width < 0. || size.height < 0.)
-        return;
-
-      CGRect b = [obj bounds];
-      b.size = size;
-      [obj setBounds:b];
-    },
-    kPOPThresholdPoint
-  },
-
-  {kPOPLayerRotation,
-    ^(CALayer *obj, CGFloat values[]) {
-      values[0] = POPLayerGetRotation(obj);
-    },
-    ^(CALayer *obj, const CGFloat values[]) {
-      POPLayerSetRotation(obj, values[0]);
-    },
-    kPOPThresholdRotation
-  },
-
-  {kPOPLayerRotationY,
-    ^(CALayer *obj, CGFloat values[]) {
-      values[0] = POPLayerGetRotationY(obj);
-    },
-    ^(id obj, const CGFloat values[]) {
-      POPLayerSetRotationY(obj, values[0]);
-    },
-    kPOPThresholdRotation
-  },
-
-  {kPOPLayerRotationX,
-    ^(CALayer *obj, CGFloat values[]) {
-      values[0] = POPLayerGetRotationX(obj);
-    },
-    ^(CALayer *obj, const CGFloat values[]) {
-      POPLayerSetRotationX(obj, values[0]);
-    },
-    kPOPThresholdRotation
-  },
-
-  {kPOPLayerShadowColor,
-    ^(CALayer *obj, CGFloat values[]) {
-        POPCGColorGetRGBAComponents(obj.shadowColor, values);
-    },
-    ^(CALayer *obj, const CGFloat values[]) {
+  static POPStaticAnimatablePropertyState states[] =
+  {
+    /* CALayer */
+
+    {kPOPLayerBackgroundColor,
+      ^(CALayer *obj, CGFloat values[]) {
+        POPCGColorGetRGBAComponents(obj.backgroundColor, values);
+      },
+      ^(CALayer *obj, const CGFloat values[]) {
         CGColorRef color = POPCGColorRGBACreate(values);
-        [obj setShadowColor:color];
+        [obj setBackgroundColor:color];
         CGColorRelease(color);
-    },
-    0.01
-  },
-
-  {kPOPLayerShadowOffset,
-    ^(CALayer *obj, CGFloat values[]) {
-        values_from_size(values, [obj shadowOffset]);
-    },
-    ^(CALayer *obj, const CGFloat values[]) {
-        CGSize size = values_to_size(values);
-        [obj setShadowOffset:size];
-    },
-    0.01
-  },
-
-  {kPOPLayerShadowOpacity,
-    ^(CALayer *obj, CGFloat values[]) {
-        values[0] = [obj shadowOpacity];
-    },
-    ^(CALayer *obj, const CGFloat values[]) {
-        [obj setShadowOpacity:values[0]];
-    },
-    kPOPThresholdOpacity
-  },
-
-  {kPOPLayerShadowRadius,
-    ^(CALayer *obj, CGFloat values[]) {
-        values[0] = [obj shadowRadius];
-    },
-    ^(CALayer *obj, const CGFloat values[]) {
-        [obj setShadowRadius:values[0]];
-    },
-    kPOPThresholdRadius
-  },
-
-  /* CAShapeLayer */
-
-  {kPOPShapeLayerStrokeStart,
-    ^(CAShapeLayer *obj, CGFloat values[]) {
-      values[0] = obj.strokeStart;
-    },
-    ^(CAShapeLayer *obj, const CGFloat values[]) {
-      obj.strokeStart = values[0];
-    },
-    0.01
-  },
-
-  {kPOPShapeLayerStrokeEnd,
-    ^(CAShapeLayer *obj, CGFloat values[]) {
-      values[0] = obj.strokeEnd;
-    },
-    ^(CAShapeLayer *obj, const CGFloat values[]) {
-      obj.strokeEnd = values[0];
-    },
-    0.01
-  },
-
-  {kPOPShapeLayerStrokeColor,
-    ^(CAShapeLayer *obj, CGFloat values[]) {
-        POPCGColorGetRGBAComponents(obj.strokeColor, values);
-    },
-    ^(CAShapeLayer *obj, const CGFloat values[]) {
-        CGColorRef color = POPCGColorRGBACreate(values);
-        [obj setStrokeColor:color];
-        CGColorRelease(color);
-    },
-    kPOPThresholdColor
-  },
-
-  {kPOPShapeLayerFillColor,
-    ^(CAShapeLayer *obj, CGFloat values[]) {
-        POPCGColorGetRGBAComponents(obj.fillColor, values);
-    },
-    ^(CAShapeLayer *obj, const CGFloat values[]) {
+      },
+      kPOPThresholdColor
+    },
+
+    {kPOPLayerBounds,
+      ^(CALayer *obj, CGFloat values[]) {
+        values_from_rect(values, [obj bounds]);
+      },
+      ^(CALayer *obj, const CGFloat values[]) {
+        [obj setBounds:values_to_rect(values)];
+      },
+      kPOPThresholdPoint
+    },
+
+    {kPOPLayerCornerRadius,
+      ^(CALayer *obj, CGFloat values[]) {
+        values[0] = [obj cornerRadius];
+      },
+      ^(CALayer *obj, const CGFloat values[]) {
+        [obj setCornerRadius:values[0]];
+      },
+      kPOPThresholdRadius
+    },
+
+    {kPOPLayerBorderWidth,
+      ^(CALayer *obj, CGFloat values[]) {
+        values[0] = [obj borderWidth];
+      },
+      ^(CALayer *obj, const CGFloat values[]) {
+        [obj setBorderWidth:values[0]];
+      },
+      0.01
+    },
+
+    {kPOPLayerBorderColor,
+      ^(CALayer *obj, CGFloat values[]) {
+        POPCGColorGetRGBAComponents(obj.borderColor, values);
+      },
+      ^(CALayer *obj, const CGFloat values[]) {
         CGColorRef color = POPCGColorRGBACreate(values);
-        [obj setFillColor:color];
+        [obj setBorderColor:color];
         CGColorRelease(color);
+      },
+      kPOPThresholdColor
+    },
+
+    {kPOPLayerPosition,
+      ^(CALayer *obj, CGFloat values[]) {
+        values_from_point(values, [(CALayer *)obj position]);
+      },
+      ^(CALayer *obj, const CGFloat values[]) {
+        [obj setPosition:values_to_point(values)];
+      },
+      kPOPThresholdPoint
+    },
+
+    {kPOPLayerPositionX,
+      ^(CALayer *obj, CGFloat values[]) {
+        values[0] = [(CALayer *)obj position].x;
+      },
+      ^(CALayer *obj, const CGFloat values[]) {
+        CGPoint p = [(CALayer *)obj position];
+        p.x = values[0];
+        [obj setPosition:p];
+      },
+      kPOPThresholdPoint
+    },
+
+    {kPOPLayerPositionY,
+      ^(CALayer *obj, CGFloat values[]) {
+        values[0] = [(CALayer *)obj position].y;
+      },
+      ^(CALayer *obj, const CGFloat values[]) {
+        CGPoint p = [(CALayer *)obj position];
+        p.y = values[0];
+        [obj setPosition:p];
+      },
+      kPOPThresholdPoint
+    },
+
+    {kPOPLayerOpacity,
+      ^(CALayer *obj, CGFloat values[]) {
+        values[0] = [obj opacity];
+      },
+      ^(CALayer *obj, const CGFloat values[]) {
+        [obj setOpacity:((float)values[0])];
+      },
+      kPOPThresholdOpacity
+    },
+
+    {kPOPLayerScaleX,
+      ^(CALayer *obj, CGFloat values[]) {
+        values[0] = POPLayerGetScaleX(obj);
+      },
+      ^(CALayer *obj, const CGFloat values[]) {
+        POPLayerSetScaleX(obj, values[0]);
+      },
+      kPOPThresholdScale
+    },
+
+    {kPOPLayerScaleY,
+      ^(CALayer *obj, CGFloat values[]) {
+        values[0] = POPLayerGetScaleY(obj);
+      },
+      ^(CALayer *obj, const CGFloat values[]) {
+        POPLayerSetScaleY(obj, values[0]);
+      },
+      kPOPThresholdScale
+    },
+
+    {kPOPLayerScaleXY,
+      ^(CALayer *obj, CGFloat values[]) {
+        values_from_point(values, POPLayerGetScaleXY(obj));
+      },
+      ^(CALayer *obj, const CGFloat values[]) {
+        POPLayerSetScaleXY(obj, values_to_point(values));
+      },
+      kPOPThresholdScale
+    },
+
+    {kPOPLayerSubscaleXY,
+      ^(CALayer *obj, CGFloat values[]) {
+        values_from_point(values, POPLayerGetSubScaleXY(obj));
+      },
+      ^(CALayer *obj, const CGFloat values[]) {
+        POPLayerSetSubScaleXY(obj, values_to_point(values));
+      },
+      kPOPThresholdScale
+    },
+
+    {kPOPLayerTranslationX,
+      ^(CALayer *obj, CGFloat values[]) {
+        values[0] = POPLayerGetTranslationX(obj);
+      },
+      ^(CALayer *obj, const CGFloat values[]) {
+        POPLayerSetTranslationX(obj, values[0]);
+      },
+      kPOPThresholdPoint
+    },
+
+    {kPOPLayerTranslationY,
+      ^(CALayer *obj, CGFloat values[]) {
+        values[0] = POPLayerGetTranslationY(obj);
+      },
+      ^(CALayer *obj, const CGFloat values[]) {
+        POPLayerSetTranslationY(obj, values[0]);
+      },
+      kPOPThresholdPoint
+    },
+
+    {kPOPLayerTranslationZ,
+      ^(CALayer *obj, CGFloat values[]) {
+        values[0] = POPLayerGetTranslationZ(obj);
+      },
+      ^(CALayer *obj, const CGFloat values[]) {
+        POPLayerSetTranslationZ(obj, values[0]);
+      },
+      kPOPThresholdPoint
+    },
+
+    {kPOPLayerTranslationXY,
+      ^(CALayer *obj, CGFloat values[]) {
+        values_from_point(values, POPLayerGetTranslationXY(obj));
+      },
+      ^(CALayer *obj, const CGFloat values[]) {
+        POPLayerSetTranslationXY(obj, values_to_point(values));
+      },
+      kPOPThresholdPoint
+    },
+
+    {kPOPLayerSubtranslationX,
+      ^(CALayer *obj, CGFloat values[]) {
+        values[0] = POPLayerGetSubTranslationX(obj);
+      },
+      ^(CALayer *obj, const CGFloat values[]) {
+        POPLayerSetSubTranslationX(obj, values[0]);
+      },
+      kPOPThresholdPoint
+    },
+
+    {kPOPLayerSubtranslationY,
+      ^(CALayer *obj, CGFloat values[]) {
+        values[0] = POPLayerGetSubTranslationY(obj);
+      },
+      ^(CALayer *obj, const CGFloat values[]) {
+        POPLayerSetSubTranslationY(obj, values[0]);
+      },
+      kPOPThresholdPoint
+    },
+
+    {kPOPLayerSubtranslationZ,
+      ^(CALayer *obj, CGFloat values[]) {
+        values[0] = POPLayerGetSubTranslationZ(obj);
+      },
+      ^(CALayer *obj, const CGFloat values[]) {
+        POPLayerSetSubTranslationZ(obj, values[0]);
+      },
+      kPOPThresholdPoint
+    },
+
+    {kPOPLayerSubtranslationXY,
+      ^(CALayer *obj, CGFloat values[]) {
+        values_from_point(values, POPLayerGetSubTranslationXY(obj));
+      },
+      ^(CALayer *obj, const CGFloat values[]) {
+        POPLayerSetSubTranslationXY(obj, values_to_point(values));
+      },
+      kPOPThresholdPoint
+    },
+
+    {kPOPLayerZPosition,
+      ^(CALayer *obj, CGFloat values[]) {
+        values[0] = [obj zPosition];
+      },
+      ^(CALayer *obj, const CGFloat values[]) {
+        [obj setZPosition:values[0]];
+      },
+      kPOPThresholdPoint
+    },
+
+    {kPOPLayerSize,
+      ^(CALayer *obj, CGFloat values[]) {
+        values_from_size(values, [obj bounds].size);
+      },
+      ^(CALayer *obj, const CGFloat values[]) {
+        CGSize size = values_to_size(values);
+        if (size.width < 0. || size.height < 0.)
+          return;
+
+        CGRect b = [obj bounds];
+        b.size = size;
+        [obj setBounds:b];
+      },
+      kPOPThresholdPoint
+    },
+
+    {kPOPLayerRotation,
+      ^(CALayer *obj, CGFloat values[]) {
+        values[0] = POPLayerGetRotation(obj);
+      },
+      ^(CALayer *obj, const CGFloat values[]) {
+        POPLayerSetRotation(obj, values[0]);
+      },
+      kPOPThresholdRotation
+    },
+
+    {kPOPLayerRotationY,
+      ^(CALayer *obj, CGFloat values[]) {
+        values[0] = POPLayerGetRotationY(obj);
+      },
+      ^(id obj, const CGFloat values[]) {
+        POPLayerSetRotationY(obj, values[0]);
+      },
+      kPOPThresholdRotation
+    },
+
+    {kPOPLayerRotationX,
+      ^(CALayer *obj, CGFloat values[]) {
+        values[0] = POPLayerGetRotationX(obj);
+      },
+      ^(CALayer *obj, const CGFloat values[]) {
+        POPLayerSetRotationX(obj, values[0]);
+      },
+      kPOPThresholdRotation
+    },
+
+    {kPOPLayerShadowColor,
+      ^(CALayer *obj, CGFloat values[]) {
+          POPCGColorGetRGBAComponents(obj.shadowColor, values);
+      },
+      ^(CALayer *obj, const CGFloat values[]) {
+          CGColorRef color = POPCGColorRGBACreate(values);
+          [obj setShadowColor:color];
+          CGColorRelease(color);
+      },
+      0.01
+    },
+
+    {kPOPLayerShadowOffset,
+      ^(CALayer *obj, CGFloat values[]) {
+          values_from_size(values, [obj shadowOffset]);
+      },
+      ^(CALayer *obj, const CGFloat values[]) {
+          CGSize size = values_to_size(values);
+          [obj setShadowOffset:size];
+      },
+      0.01
+    },
+
+    {kPOPLayerShadowOpacity,
+      ^(CALayer *obj, CGFloat values[]) {
+          values[0] = [obj shadowOpacity];
+      },
+      ^(CALayer *obj, const CGFloat values[]) {
+          [obj setShadowOpacity:values[0]];
+      },
+      kPOPThresholdOpacity
+    },
+
+    {kPOPLayerShadowRadius,
+      ^(CALayer *obj, CGFloat values[]) {
+          values[0] = [obj shadowRadius];
+      },
+      ^(CALayer *obj, const CGFloat values[]) {
+          [obj setShadowRadius:values[0]];
+      },
+      kPOPThresholdRadius
+    },
+
+    /* CAShapeLayer */
+
+    {kPOPShapeLayerStrokeStart,
+      ^(CAShapeLayer *obj, CGFloat values[]) {
+        values[0] = obj.strokeStart;
+      },
+      ^(CAShapeLayer *obj, const CGFloat values[]) {
+        obj.strokeStart = values[0];
+      },
+      0.01
+    },
+
+    {kPOPShapeLayerStrokeEnd,
+      ^(CAShapeLayer *obj, CGFloat values[]) {
+        values[0] = obj.strokeEnd;
+      },
+      ^(CAShapeLayer *obj, const CGFloat values[]) {
+        obj.strokeEnd = values[0];
+      },
+      0.01
+    },
+
+    {kPOPShapeLayerStrokeColor,
+      ^(CAShapeLayer *obj, CGFloat values[]) {
+          POPCGColorGetRGBAComponents(obj.strokeColor, values);
+      },
+      ^(CAShapeLayer *obj, const CGFloat values[]) {
+          CGColorRef color = POPCGColorRGBACreate(values);
+          [obj setStrokeColor:color];
+          CGColorRelease(color);
+      },
+      kPOPThresholdColor
+    },
+
+    {kPOPShapeLayerFillColor,
+      ^(CAShapeLayer *obj, CGFloat values[]) {
+          POPCGColorGetRGBAComponents(obj.fillColor, values);
+      },
+      ^(CAShapeLayer *obj, const CGFloat values[]) {
+          CGColorRef color = POPCGColorRGBACreate(values);
+          [obj setFillColor:color];
+          CGColorRelease(color);
+      },
+      kPOPThresholdColor
+    },
+
+    {kPOPShapeLayerLineWidth,
+      ^(CAShapeLayer *obj, CGFloat values[]) {
+          values[0] = obj.lineWidth;
+      },
+      ^(CAShapeLayer *obj, const CGFloat values[]) {
+          obj.lineWidth = values[0];
+      },
+      0.01
     },
-    kPOPThresholdColor
-  },
-
-  {kPOPShapeLayerLineWidth,
-    ^(CAShapeLayer *obj, CGFloat values[]) {
-        values[0] = obj.lineWidth;
-    },
-    ^(CAShapeLayer *obj, const CGFloat values[]) {
-        obj.lineWidth = values[0];
-    },
-    0.01
-  },
     
-    {kPOPShapeLayerLineDashPhase,
-        ^(CAShapeLayer *obj, CGFloat values[]) {
-            values[0] = obj.lineDashPhase;
-        },
-        ^(CAShapeLayer *obj, const CGFloat values[]) {
-            obj.lineDashPhase = values[0];
-        },
-        0.01
-    },
-
-  {kPOPLayoutConstraintConstant,
-    ^(NSLayoutConstraint *obj, CGFloat values[]) {
-      values[0] = obj.constant;
-    },
-    ^(NSLayoutConstraint *obj, const CGFloat values[]) {
-      obj.constant = values[0];
+      {kPOPShapeLayerLineDashPhase,
+          ^(CAShapeLayer *obj, CGFloat values[]) {
+              values[0] = obj.lineDashPhase;
+          },
+          ^(CAShapeLayer *obj, const CGFloat values[]) {
+              obj.lineDashPhase = values[0];
+          },
+          0.01
+      },
+
+    {kPOPLayoutConstraintConstant,
+      ^(NSLayoutConstraint *obj, CGFloat values[]) {
+        values[0] = obj.constant;
+      },
+      ^(NSLayoutConstraint *obj, const CGFloat values[]) {
+        obj.constant = values[0];
+      },
+      0.01
     },
-    0.01
-  },
 
 #if TARGET_OS_IPHONE
 
-  /* UIView */
-
-  {kPOPViewAlpha,
-    ^(UIView *obj, CGFloat values[]) {
-      values[0] = obj.alpha;
-    },
-    ^(UIView *obj, const CGFloat values[]) {
-      obj.alpha = values[0];
-    },
-    kPOPThresholdOpacity
-  },
-
-  {kPOPViewBackgroundColor,
-    ^(UIView *obj, CGFloat values[]) {
-      POPUIColorGetRGBAComponents(obj.backgroundColor, values);
-    },
-    ^(UIView *obj, const CGFloat values[]) {
-      obj.backgroundColor = POPUIColorRGBACreate(values);
-    },
-    kPOPThresholdColor
-  },
-
-  {kPOPViewCenter,
-    ^(UIView *obj, CGFloat values[]) {
-      values_from_point(values, obj.center);
-    },
-    ^(UIView *obj, const CGFloat values[]) {
-      obj.center = values_to_point(values);
-    },
-    kPOPThresholdPoint
-  },
-
-  {kPOPViewFrame,
-    ^(UIView *obj, CGFloat values[]) {
-      values_from_rect(values, obj.frame);
+    /* UIView */
+
+    {kPOPViewAlpha,
+      ^(UIView *obj, CGFloat values[]) {
+        values[0] = obj.alpha;
+      },
+      ^(UIView *obj, const CGFloat values[]) {
+        obj.alpha = values[0];
+      },
+      kPOPThresholdOpacity
+    },
+
+    {kPOPViewBackgroundColor,
+      ^(UIView *obj, CGFloat values[]) {
+        POPUIColorGetRGBAComponents(obj.backgroundColor, values);
+      },
+      ^(UIView *obj, const CGFloat values[]) {
+        obj.backgroundColor = POPUIColorRGBACreate(values);
+      },
+      kPOPThresholdColor
+    },
+
+    {kPOPViewCenter,
+      ^(UIView *obj, CGFloat values[]) {
+        values_from_point(values, obj.center);
+      },
+      ^(UIView *obj, const CGFloat values[]) {
+        obj.center = values_to_point(values);
+      },
+      kPOPThresholdPoint
+    },
+
+    {kPOPViewFrame,
+      ^(UIView *obj, CGFloat values[]) {
+        values_from_rect(values, obj.frame);
+      },
+      ^(UIView *obj, const CGFloat values[]) {
+        obj.frame = values_to_rect(values);
+      },
+      kPOPThresholdPoint
+    },
+
+    {kPOPViewScaleX,
+      ^(UIView *obj, CGFloat values[]) {
+        values[0] = POPLayerGetScaleX(obj.layer);
+      },
+      ^(UIView *obj, const CGFloat values[]) {
+        POPLayerSetScaleX(obj.layer, values[0]);
+      },
+      kPOPThresholdScale
+    },
+
+    {kPOPViewScaleY,
+      ^(UIView *obj, CGFloat values[]) {
+        values[0] = POPLayerGetScaleY(obj.layer);
+      },
+      ^(UIView *obj, const CGFloat values[]) {
+        POPLayerSetScaleY(obj.layer, values[0]);
+      },
+      kPOPThresholdScale
+    },
+
+    {kPOPViewScaleXY,
+      ^(UIView *obj, CGFloat values[]) {
+        values_from_point(values, POPLayerGetScaleXY(obj.layer));
+      },
+      ^(UIView *obj, const CGFloat values[]) {
+        POPLayerSetScaleXY(obj.layer, values_to_point(values));
+      },
+      kPOPThresholdScale
+    },
+
+    {kPOPViewTintColor,
+      ^(UIView *obj, CGFloat values[]) {
+        POPUIColorGetRGBAComponents(obj.tintColor, values);
+      },
+      ^(UIView *obj, const CGFloat values[]) {
+          obj.tintColor = POPUIColorRGBACreate(values);
+      },
+      kPOPThresholdColor
+    },
+
+    /* UIScrollView */
+
+    {kPOPScrollViewContentOffset,
+      ^(UIScrollView *obj, CGFloat values[]) {
+        values_from_point(values, obj.contentOffset);
+      },
+      ^(UIScrollView *obj, const CGFloat values[]) {
+        [obj setContentOffset:values_to_point(values) animated:NO];
+      },
+      kPOPThresholdPoint
+    },
+
+    {kPOPScrollViewContentSize,
+      ^(UIScrollView *obj, CGFloat values[]) {
+        values_from_size(values, obj.contentSize);
+      },
+      ^(UIScrollView *obj, const CGFloat values[]) {
+        obj.contentSize = values_to_size(values);
+      },
+      kPOPThresholdPoint
+    },
+
+    {kPOPScrollViewZoomScale,
+      ^(UIScrollView *obj, CGFloat values[]) {
+        values[0]=obj.zoomScale;
+      },
+      ^(UIScrollView *obj, const CGFloat values[]) {
+        obj.zoomScale=values[0];
+      },
+      kPOPThresholdScale
+    },
+
+    {kPOPScrollViewContentInset,
+      ^(UIScrollView *obj, CGFloat values[]) {
+        values[0] = obj.contentInset.top;
+        values[1] = obj.contentInset.left;
+        values[2] = obj.contentInset.bottom;
+        values[3] = obj.contentInset.right;
+      },
+      ^(UIScrollView *obj, const CGFloat values[]) {
+        obj.contentInset = values_to_edge_insets(values);
+      },
+      kPOPThresholdPoint
+    },
+
+    {kPOPScrollViewScrollIndicatorInsets,
+      ^(UIScrollView *obj, CGFloat values[]) {
+        values[0] = obj.scrollIndicatorInsets.top;
+        values[1] = obj.scrollIndicatorInsets.left;
+        values[2] = obj.scrollIndicatorInsets.bottom;
+        values[3] = obj.scrollIndicatorInsets.right;
+      },
+      ^(UIScrollView *obj, const CGFloat values[]) {
+        obj.scrollIndicatorInsets = values_to_edge_insets(values);
+      },
+      kPOPThresholdPoint
+    },
+
+    /* UINavigationBar */
+
+    {kPOPNavigationBarBarTintColor,
+      ^(UINavigationBar *obj, CGFloat values[]) {
+        POPUIColorGetRGBAComponents(obj.barTintColor, values);
+      },
+      ^(UINavigationBar *obj, const CGFloat values[]) {
+        obj.barTintColor = POPUIColorRGBACreate(values);
+      },
+      kPOPThresholdColor
+    },
+
+    /* UILabel */
+
+    {kPOPLabelTextColor,
+      ^(UILabel *obj, CGFloat values[]) {
+        POPUIColorGetRGBAComponents(obj.textColor, values);
+      },
+      ^(UILabel *obj, const CGFloat values[]) {
+        obj.textColor = POPUIColorRGBACreate(values);
+      },
+      kPOPThresholdColor
     },
-    ^(UIView *obj, const CGFloat values[]) {
-      obj.frame = values_to_rect(values);
-    },
-    kPOPThresholdPoint
-  },
-
-  {kPOPViewScaleX,
-    ^(UIView *obj, CGFloat values[]) {
-      values[0] = POPLayerGetScaleX(obj.layer);
-    },
-    ^(UIView *obj, const CGFloat values[]) {
-      POPLayerSetScaleX(obj.layer, values[0]);
-    },
-    kPOPThresholdScale
-  },
-
-  {kPOPViewScaleY,
-    ^(UIView *obj, CGFloat values[]) {
-      values[0] = POPLayerGetScaleY(obj.layer);
-    },
-    ^(UIView *obj, const CGFloat values[]) {
-      POPLayerSetScaleY(obj.layer, values[0]);
-    },
-    kPOPThresholdScale
-  },
-
-  {kPOPViewScaleXY,
-    ^(UIView *obj, CGFloat values[]) {
-      values_from_point(values, POPLayerGetScaleXY(obj.layer));
-    },
-    ^(UIView *obj, const CGFloat values[]) {
-      POPLayerSetScaleXY(obj.layer, values_to_point(values));
-    },
-    kPOPThresholdScale
-  },
-
-  {kPOPViewTintColor,
-    ^(UIView *obj, CGFloat values[]) {
-      POPUIColorGetRGBAComponents(obj.tintColor, values);
-    },
-    ^(UIView *obj, const CGFloat values[]) {
-        obj.tintColor = POPUIColorRGBACreate(values);
-    },
-    kPOPThresholdColor
-  },
-
-  /* UIScrollView */
-
-  {kPOPScrollViewContentOffset,
-    ^(UIScrollView *obj, CGFloat values[]) {
-      values_from_point(values, obj.contentOffset);
-    },
-    ^(UIScrollView *obj, const CGFloat values[]) {
-      [obj setContentOffset:values_to_point(values) animated:NO];
-    },
-    kPOPThresholdPoint
-  },
-
-  {kPOPScrollViewContentSize,
-    ^(UIScrollView *obj, CGFloat values[]) {
-      values_from_size(values, obj.contentSize);
-    },
-    ^(UIScrollView *obj, const CGFloat values[]) {
-      obj.contentSize = values_to_size(values);
-    },
-    kPOPThresholdPoint
-  },
-
-  {kPOPScrollViewZoomScale,
-    ^(UIScrollView *obj, CGFloat values[]) {
-      values[0]=obj.zoomScale;
-    },
-    ^(UIScrollView *obj, const CGFloat values[]) {
-      obj.zoomScale=values[0];
-    },
-    kPOPThresholdScale
-  },
-
-  {kPOPScrollViewContentInset,
-    ^(UIScrollView *obj, CGFloat values[]) {
-      values[0] = obj.contentInset.top;
-      values[1] = obj.contentInset.left;
-      values[2] = obj.contentInset.bottom;
-      values[3] = obj.contentInset.right;
-    },
-    ^(UIScrollView *obj, const CGFloat values[]) {
-      obj.contentInset = values_to_edge_insets(values);
-    },
-    kPOPThresholdPoint
-  },
-
-  {kPOPScrollViewScrollIndicatorInsets,
-    ^(UIScrollView *obj, CGFloat values[]) {
-      values[0] = obj.scrollIndicatorInsets.top;
-      values[1] = obj.scrollIndicatorInsets.left;
-      values[2] = obj.scrollIndicatorInsets.bottom;
-      values[3] = obj.scrollIndicatorInsets.right;
-    },
-    ^(UIScrollView *obj, const CGFloat values[]) {
-      obj.scrollIndicatorInsets = values_to_edge_insets(values);
-    },
-    kPOPThresholdPoint
-  },
-
-  /* UINavigationBar */
-
-  {kPOPNavigationBarBarTintColor,
-    ^(UINavigationBar *obj, CGFloat values[]) {
-      POPUIColorGetRGBAComponents(obj.barTintColor, values);
-    },
-    ^(UINavigationBar *obj, const CGFloat values[]) {
-      obj.barTintColor = POPUIColorRGBACreate(values);
-    },
-    kPOPThresholdColor
-  },
-
-  /* UILabel */
-
-  {kPOPLabelTextColor,
-    ^(UILabel *obj, CGFloat values[]) {
-      POPUIColorGetRGBAComponents(obj.textColor, values);
-    },
-    ^(UILabel *obj, const CGFloat values[]) {
-      obj.textColor = POPUIColorRGBACreate(values);
-    },
-    kPOPThresholdColor
-  },
 
 #else
 
-  /* NSView */
-
-  {kPOPViewFrame,
-    ^(NSView *obj, CGFloat values[]) {
-      values_from_rect(values, NSRectToCGRect(obj.frame));
-    },
-    ^(NSView *obj, const CGFloat values[]) {
-      obj.frame = NSRectFromCGRect(values_to_rect(values));
-    },
-    kPOPThresholdPoint
-  },
-
-  {kPOPViewBounds,
-    ^(NSView *obj, CGFloat values[]) {
-      values_from_rect(values, NSRectToCGRect(obj.frame));
-    },
-    ^(NSView *obj, const CGFloat values[]) {
-      obj.bounds = NSRectFromCGRect(values_to_rect(values));
+    /* NSView */
+
+    {kPOPViewFrame,
+      ^(NSView *obj, CGFloat values[]) {
+        values_from_rect(values, NSRectToCGRect(obj.frame));
+      },
+      ^(NSView *obj, const CGFloat values[]) {
+        obj.frame = NSRectFromCGRect(values_to_rect(values));
+      },
+      kPOPThresholdPoint
+    },
+
+    {kPOPViewBounds,
+      ^(NSView *obj, CGFloat values[]) {
+        values_from_rect(values, NSRectToCGRect(obj.frame));
+      },
+      ^(NSView *obj, const CGFloat values[]) {
+        obj.bounds = NSRectFromCGRect(values_to_rect(values));
+      },
+      kPOPThresholdPoint
+    },
+
+    {kPOPViewAlphaValue,
+      ^(NSView *obj, CGFloat values[]) {
+        values[0] = obj.alphaValue;
+      },
+      ^(NSView *obj, const CGFloat values[]) {
+        obj.alphaValue = values[0];
+      },
+      kPOPThresholdOpacity
+    },
+
+    {kPOPViewFrameRotation,
+      ^(NSView *obj, CGFloat values[]) {
+        values[0] = obj.frameRotation;
+      },
+      ^(NSView *obj, const CGFloat values[]) {
+        obj.frameRotation = values[0];
+      },
+      kPOPThresholdRotation
+    },
+
+    {kPOPViewFrameCenterRotation,
+      ^(NSView *obj, CGFloat values[]) {
+        values[0] = obj.frameCenterRotation;
+      },
+      ^(NSView *obj, const CGFloat values[]) {
+        obj.frameCenterRotation = values[0];
+      },
+      kPOPThresholdRotation
+    },
+
+    {kPOPViewBoundsRotation,
+      ^(NSView *obj, CGFloat values[]) {
+        values[0] = obj.boundsRotation;
+      },
+      ^(NSView *obj, const CGFloat values[]) {
+        obj.boundsRotation = values[0];
+      },
+      kPOPThresholdRotation
+    },
+
+    /* NSWindow */
+
+    {kPOPWindowFrame,
+      ^(NSWindow *obj, CGFloat values[]) {
+        values_from_rect(values, NSRectToCGRect(obj.frame));
+      },
+      ^(NSWindow *obj, const CGFloat values[]) {
+        [obj setFrame:NSRectFromCGRect(values_to_rect(values)) display:YES];
+      },
+      kPOPThresholdPoint
+    },
+
+    {kPOPWindowAlphaValue,
+      ^(NSWindow *obj, CGFloat values[]) {
+        values[0] = obj.alphaValue;
+      },
+      ^(NSWindow *obj, const CGFloat values[]) {
+        obj.alphaValue = values[0];
+      },
+      kPOPThresholdOpacity
+    },
+
+    {kPOPWindowBackgroundColor,
+      ^(NSWindow *obj, CGFloat values[]) {
+        POPNSColorGetRGBAComponents(obj.backgroundColor, values);
+      },
+      ^(NSWindow *obj, const CGFloat values[]) {
+        obj.backgroundColor = POPNSColorRGBACreate(values);
+      },
+      kPOPThresholdColor
     },
-    kPOPThresholdPoint
-  },
-
-  {kPOPViewAlphaValue,
-    ^(NSView *obj, CGFloat values[]) {
-      values[0] = obj.alphaValue;
-    },
-    ^(NSView *obj, const CGFloat values[]) {
-      obj.alphaValue = values[0];
-    },
-    kPOPThresholdOpacity
-  },
-
-  {kPOPViewFrameRotation,
-    ^(NSView *obj, CGFloat values[]) {
-      values[0] = obj.frameRotation;
-    },
-    ^(NSView *obj, const CGFloat values[]) {
-      obj.frameRotation = values[0];
-    },
-    kPOPThresholdRotation
-  },
-
-  {kPOPViewFrameCenterRotation,
-    ^(NSView *obj, CGFloat values[]) {
-      values[0] = obj.frameCenterRotation;
-    },
-    ^(NSView *obj, const CGFloat values[]) {
-      obj.frameCenterRotation = values[0];
-    },
-    kPOPThresholdRotation
-  },
-
-  {kPOPViewBoundsRotation,
-    ^(NSView *obj, CGFloat values[]) {
-      values[0] = obj.boundsRotation;
-    },
-    ^(NSView *obj, const CGFloat values[]) {
-      obj.boundsRotation = values[0];
-    },
-    kPOPThresholdRotation
-  },
-
-  /* NSWindow */
-
-  {kPOPWindowFrame,
-    ^(NSWindow *obj, CGFloat values[]) {
-      values_from_rect(values, NSRectToCGRect(obj.frame));
-    },
-    ^(NSWindow *obj, const CGFloat values[]) {
-      [obj setFrame:NSRectFromCGRect(values_to_rect(values)) display:YES];
-    },
-    kPOPThresholdPoint
-  },
-
-  {kPOPWindowAlphaValue,
-    ^(NSWindow *obj, CGFloat values[]) {
-      values[0] = obj.alphaValue;
-    },
-    ^(NSWindow *obj, const CGFloat values[]) {
-      obj.alphaValue = values[0];
-    },
-    kPOPThresholdOpacity
-  },
-
-  {kPOPWindowBackgroundColor,
-    ^(NSWindow *obj, CGFloat values[]) {
-      POPNSColorGetRGBAComponents(obj.backgroundColor, values);
-    },
-    ^(NSWindow *obj, const CGFloat values[]) {
-      obj.backgroundColor = POPNSColorRGBACreate(values);
-    },
-    kPOPThresholdColor
-  },
 
 #endif
 
 #if SCENEKIT_SDK_AVAILABLE
 
-  /* SceneKit */
-
-  {kPOPSCNNodePosition,
-    ^(SCNNode *obj, CGFloat values[]) {
-      values_from_vec3(values, obj.position);
-    },
-    ^(SCNNode *obj, const CGFloat values[]) {
-      obj.position = values_to_vec3(values);
-    },
-    kPOPThresholdScale
-  },
-
-  {kPOPSCNNodePositionX,
-    ^(SCNNode *obj, CGFloat values[]) {
-      values[0] = obj.position.x;
-    },
-    ^(SCNNode *obj, const CGFloat values[]) {
-      obj.position = SCNVector3Make(values[0], obj.position.y, obj.position.z);
-    },
-    kPOPThresholdScale
-  },
-
-  {kPOPSCNNodePositionY,
-    ^(SCNNode *obj, CGFloat values[]) {
-      values[0] = obj.position.y;
-    },
-    ^(SCNNode *obj, const CGFloat values[]) {
-      obj.position = SCNVector3Make(obj.position.x, values[0], obj.position.z);
-    },
-    kPOPThresholdScale
-  },
-
-  {kPOPSCNNodePositionZ,
-    ^(SCNNode *obj, CGFloat values[]) {
-      values[0] = obj.position.z;
-    },
-    ^(SCNNode *obj, const CGFloat values[]) {
-      obj.position = SCNVector3Make(obj.position.x, obj.position.y, values[0]);
-    },
-    kPOPThresholdScale
-  },
-
-  {kPOPSCNNodeTranslation,
-    ^(SCNNode *obj, CGFloat values[]) {
-      values[0] = obj.transform.m41;
-      values[1] = obj.transform.m42;
-      values[2] = obj.transform.m43;
-    },
-    ^(SCNNode *obj, const CGFloat values[]) {
-      obj.transform = SCNMatrix4MakeTranslation(values[0], values[1], values[2]);
-    },
-    kPOPThresholdScale
-  },
-
-  {kPOPSCNNodeTranslationX,
-    ^(SCNNode *obj, CGFloat values[]) {
-      values[0] = obj.transform.m41;
-    },
-    ^(SCNNode *obj, const CGFloat values[]) {
-      obj.transform = SCNMatrix4MakeTranslation(values[0], obj.transform.m42, obj.transform.m43);
-    },
-    kPOPThresholdScale
-  },
-
-  {kPOPSCNNodeTranslationY,
-    ^(SCNNode *obj, CGFloat values[]) {
-      values[0] = obj.transform.m42;
-    },
-    ^(SCNNode *obj, const CGFloat values[]) {
-      obj.transform = SCNMatrix4MakeTranslation(obj.transform.m41, values[0], obj.transform.m43);
-    },
-    kPOPThresholdScale
-  },
-
-  {kPOPSCNNodeTranslationY,
-    ^(SCNNode *obj, CGFloat values[]) {
-      values[0] = obj.transform.m43;
-    },
-    ^(SCNNode *obj, const CGFloat values[]) {
-      obj.transform = SCNMatrix4MakeTranslation(obj.transform.m41, obj.transform.m42, values[0]);
-    },
-    kPOPThresholdScale
-  },
-
-  {kPOPSCNNodeRotation,
-    ^(SCNNode *obj, CGFloat values[]) {
-      values_from_vec4(values, obj.rotation);
-    },
-    ^(SCNNode *obj, const CGFloat values[]) {
-      obj.rotation = values_to_vec4(values);
-    },
-    kPOPThresholdScale
-  },
-
-  {kPOPSCNNodeRotationX,
-    ^(SCNNode *obj, CGFloat values[]) {
-      values[0] = obj.rotation.x;
-    },
-    ^(SCNNode *obj, const CGFloat values[]) {
-      obj.rotation = SCNVector4Make(1.0, obj.rotation.y, obj.rotation.z, values[0]);
-    },
-    kPOPThresholdScale
-  },
-
-  {kPOPSCNNodeRotationY,
-    ^(SCNNode *obj, CGFloat values[]) {
-      values[0] = obj.rotation.y;
-    },
-    ^(SCNNode *obj, const CGFloat values[]) {
-      obj.rotation = SCNVector4Make(obj.rotation.x, 1.0, obj.rotation.z, values[0]);
-    },
-    kPOPThresholdScale
-  },
-
-  {kPOPSCNNodeRotationZ,
-    ^(SCNNode *obj, CGFloat values[]) {
-      values[0] = obj.rotation.z;
-    },
-    ^(SCNNode *obj, const CGFloat values[]) {
-      obj.rotation = SCNVector4Make(obj.rotation.x, obj.rotation.y, 1.0, values[0]);
-    },
-    kPOPThresholdScale
-  },
-
-  {kPOPSCNNodeRotationW,
-    ^(SCNNode *obj, CGFloat values[]) {
-      values[0] = obj.rotation.w;
-    },
-    ^(SCNNode *obj, const CGFloat values[]) {
-      obj.rotation = SCNVector4Make(obj.rotation.x, obj.rotation.y, obj.rotation.z, values[0]);
-    },
-    kPOPThresholdScale
-  },
-
-  {kPOPSCNNodeEulerAngles,
-    ^(SCNNode *obj, CGFloat values[]) {
-      values_from_vec3(values, obj.eulerAngles);
-    },
-    ^(SCNNode *obj, const CGFloat values[]) {
-      obj.eulerAngles = values_to_vec3(values);
-    },
-    kPOPThresholdScale
-  },
-
-  {kPOPSCNNodeEulerAnglesX,
-    ^(SCNNode *obj, CGFloat values[]) {
-      values[0] = obj.eulerAngles.x;
-    },
-    ^(SCNNode *obj, const CGFloat values[]) {
-      obj.eulerAngles = SCNVector3Make(values[0], obj.eulerAngles.y, obj.eulerAngles.z);
-    },
-    kPOPThresholdScale
-  },
-
-  {kPOPSCNNodeEulerAnglesY,
-    ^(SCNNode *obj, CGFloat values[]) {
-      values[0] = obj.eulerAngles.y;
-    },
-    ^(SCNNode *obj, const CGFloat values[]) {
-      obj.eulerAngles = SCNVector3Make(obj.eulerAngles.x, values[0], obj.eulerAngles.z);
-    },
-    kPOPThresholdScale
-  },
-
-  {kPOPSCNNodeEulerAnglesZ,
-    ^(SCNNode *obj, CGFloat values[]) {
-      values[0] = obj.eulerAngles.z;
-    },
-    ^(SCNNode *obj, const CGFloat values[]) {
-      obj.eulerAngles = SCNVector3Make(obj.eulerAngles.x, obj.eulerAngles.y, values[0]);
-    },
-    kPOPThresholdScale
-  },
-
-  {kPOPSCNNodeOrientation,
-    ^(SCNNode *obj, CGFloat values[]) {
-      values_from_vec4(values, obj.orientation);
-    },
-    ^(SCNNode *obj, const CGFloat values[]) {
-      obj.orientation = values_to_vec4(values);
-    },
-    kPOPThresholdScale
-  },
-
-  {kPOPSCNNodeOrientationX,
-    ^(SCNNode *obj, CGFloat values[]) {
-      values[0] = obj.orientation.x;
-    },
-    ^(SCNNode *obj, const CGFloat values[]) {
-      obj.orientation = SCNVector4Make(values[0], obj.orientation.y, obj.orientation.z, obj.orientation.w);
-    },
-    kPOPThresholdScale
-  },
-
-  {kPOPSCNNodeOrientationY,
-    ^(SCNNode *obj, CGFloat values[]) {
-      values[0] = obj.orientation.y;
-    },
-    ^(SCNNode *obj, const CGFloat values[]) {
-      obj.orientation = SCNVector4Make(obj.orientation.x, values[0], obj.orientation.z, obj.orientation.w);
-    },
-    kPOPThresholdScale
-  },
-
-  {kPOPSCNNodeOrientationZ,
-    ^(SCNNode *obj, CGFloat values[]) {
-      values[0] = obj.orientation.z;
-    },
-    ^(SCNNode *obj, const CGFloat values[]) {
-      obj.orientation = SCNVector4Make(obj.orientation.x, obj.orientation.y, values[0], obj.orientation.w);
-    },
-    kPOPThresholdScale
-  },
-
-  {kPOPSCNNodeOrientationW,
-    ^(SCNNode *obj, CGFloat values[]) {
-      values[0] = obj.orientation.w;
-    },
-    ^(SCNNode *obj, const CGFloat values[]) {
-      obj.orientation = SCNVector4Make(obj.orientation.x, obj.orientation.y, obj.orientation.z, values[0]);
-    },
-    kPOPThresholdScale
-  },
-
-  {kPOPSCNNodeScale,
-    ^(SCNNode *obj, CGFloat values[]) {
-      values_from_vec3(values, obj.scale);
-    },
-    ^(SCNNode *obj, const CGFloat values[]) {
-      obj.scale = values_to_vec3(values);
+    /* SceneKit */
+
+    {kPOPSCNNodePosition,
+      ^(SCNNode *obj, CGFloat values[]) {
+        values_from_vec3(values, obj.position);
+      },
+      ^(SCNNode *obj, const CGFloat values[]) {
+        obj.position = values_to_vec3(values);
+      },
+      kPOPThresholdScale
+    },
+
+    {kPOPSCNNodePositionX,
+      ^(SCNNode *obj, CGFloat values[]) {
+        values[0] = obj.position.x;
+      },
+      ^(SCNNode *obj, const CGFloat values[]) {
+        obj.position = SCNVector3Make(values[0], obj.position.y, obj.position.z);
+      },
+      kPOPThresholdScale
+    },
+
+    {kPOPSCNNodePositionY,
+      ^(SCNNode *obj, CGFloat values[]) {
+        values[0] = obj.position.y;
+      },
+      ^(SCNNode *obj, const CGFloat values[]) {
+        obj.position = SCNVector3Make(obj.position.x, values[0], obj.position.z);
+      },
+      kPOPThresholdScale
+    },
+
+    {kPOPSCNNodePositionZ,
+      ^(SCNNode *obj, CGFloat values[]) {
+        values[0] = obj.position.z;
+      },
+      ^(SCNNode *obj, const CGFloat values[]) {
+        obj.position = SCNVector3Make(obj.position.x, obj.position.y, values[0]);
+      },
+      kPOPThresholdScale
+    },
+
+    {kPOPSCNNodeTranslation,
+      ^(SCNNode *obj, CGFloat values[]) {
+        values[0] = obj.transform.m41;
+        values[1] = obj.transform.m42;
+        values[2] = obj.transform.m43;
+      },
+      ^(SCNNode *obj, const CGFloat values[]) {
+        obj.transform = SCNMatrix4MakeTranslation(values[0], values[1], values[2]);
+      },
+      kPOPThresholdScale
+    },
+
+    {kPOPSCNNodeTranslationX,
+      ^(SCNNode *obj, CGFloat values[]) {
+        values[0] = obj.transform.m41;
+      },
+      ^(SCNNode *obj, const CGFloat values[]) {
+        obj.transform = SCNMatrix4MakeTranslation(values[0], obj.transform.m42, obj.transform.m43);
+      },
+      kPOPThresholdScale
+    },
+
+    {kPOPSCNNodeTranslationY,
+      ^(SCNNode *obj, CGFloat values[]) {
+        values[0] = obj.transform.m42;
+      },
+      ^(SCNNode *obj, const CGFloat values[]) {
+        obj.transform = SCNMatrix4MakeTranslation(obj.transform.m41, values[0], obj.transform.m43);
+      },
+      kPOPThresholdScale
+    },
+
+    {kPOPSCNNodeTranslationY,
+      ^(SCNNode *obj, CGFloat values[]) {
+        values[0] = obj.transform.m43;
+      },
+      ^(SCNNode *obj, const CGFloat values[]) {
+        obj.transform = SCNMatrix4MakeTranslation(obj.transform.m41, obj.transform.m42, values[0]);
+      },
+      kPOPThresholdScale
+    },
+
+    {kPOPSCNNodeRotation,
+      ^(SCNNode *obj, CGFloat values[]) {
+        values_from_vec4(values, obj.rotation);
+      },
+      ^(SCNNode *obj, const CGFloat values[]) {
+        obj.rotation = values_to_vec4(values);
+      },
+      kPOPThresholdScale
+    },
+
+    {kPOPSCNNodeRotationX,
+      ^(SCNNode *obj, CGFloat values[]) {
+        values[0] = obj.rotation.x;
+      },
+      ^(SCNNode *obj, const CGFloat values[]) {
+        obj.rotation = SCNVector4Make(1.0, obj.rotation.y, obj.rotation.z, values[0]);
+      },
+      kPOPThresholdScale
+    },
+
+    {kPOPSCNNodeRotationY,
+      ^(SCNNode *obj, CGFloat values[]) {
+        values[0] = obj.rotation.y;
+      },
+      ^(SCNNode *obj, const CGFloat values[]) {
+        obj.rotation = SCNVector4Make(obj.rotation.x, 1.0, obj.rotation.z, values[0]);
+      },
+      kPOPThresholdScale
+    },
+
+    {kPOPSCNNodeRotationZ,
+      ^(SCNNode *obj, CGFloat values[]) {
+        values[0] = obj.rotation.z;
+      },
+      ^(SCNNode *obj, const CGFloat values[]) {
+        obj.rotation = SCNVector4Make(obj.rotation.x, obj.rotation.y, 1.0, values[0]);
+      },
+      kPOPThresholdScale
+    },
+
+    {kPOPSCNNodeRotationW,
+      ^(SCNNode *obj, CGFloat values[]) {
+        values[0] = obj.rotation.w;
+      },
+      ^(SCNNode *obj, const CGFloat values[]) {
+        obj.rotation = SCNVector4Make(obj.rotation.x, obj.rotation.y, obj.rotation.z, values[0]);
+      },
+      kPOPThresholdScale
+    },
+
+    {kPOPSCNNodeEulerAngles,
+      ^(SCNNode *obj, CGFloat values[]) {
+        values_from_vec3(values, obj.eulerAngles);
+      },
+      ^(SCNNode *obj, const CGFloat values[]) {
+        obj.eulerAngles = values_to_vec3(values);
+      },
+      kPOPThresholdScale
+    },
+
+    {kPOPSCNNodeEulerAnglesX,
+      ^(SCNNode *obj, CGFloat values[]) {
+        values[0] = obj.eulerAngles.x;
+      },
+      ^(SCNNode *obj, const CGFloat values[]) {
+        obj.eulerAngles = SCNVector3Make(values[0], obj.eulerAngles.y, obj.eulerAngles.z);
+      },
+      kPOPThresholdScale
+    },
+
+    {kPOPSCNNodeEulerAnglesY,
+      ^(SCNNode *obj, CGFloat values[]) {
+        values[0] = obj.eulerAngles.y;
+      },
+      ^(SCNNode *obj, const CGFloat values[]) {
+        obj.eulerAngles = SCNVector3Make(obj.eulerAngles.x, values[0], obj.eulerAngles.z);
+      },
+      kPOPThresholdScale
+    },
+
+    {kPOPSCNNodeEulerAnglesZ,
+      ^(SCNNode *obj, CGFloat values[]) {
+        values[0] = obj.eulerAngles.z;
+      },
+      ^(SCNNode *obj, const CGFloat values[]) {
+        obj.eulerAngles = SCNVector3Make(obj.eulerAngles.x, obj.eulerAngles.y, values[0]);
+      },
+      kPOPThresholdScale
+    },
+
+    {kPOPSCNNodeOrientation,
+      ^(SCNNode *obj, CGFloat values[]) {
+        values_from_vec4(values, obj.orientation);
+      },
+      ^(SCNNode *obj, const CGFloat values[]) {
+        obj.orientation = values_to_vec4(values);
+      },
+      kPOPThresholdScale
+    },
+
+    {kPOPSCNNodeOrientationX,
+      ^(SCNNode *obj, CGFloat values[]) {
+        values[0] = obj.orientation.x;
+      },
+      ^(SCNNode *obj, const CGFloat values[]) {
+        obj.orientation = SCNVector4Make(values[0], obj.orientation.y, obj.orientation.z, obj.orientation.w);
+      },
+      kPOPThresholdScale
+    },
+
+    {kPOPSCNNodeOrientationY,
+      ^(SCNNode *obj, CGFloat values[]) {
+        values[0] = obj.orientation.y;
+      },
+      ^(SCNNode *obj, const CGFloat values[]) {
+        obj.orientation = SCNVector4Make(obj.orientation.x, values[0], obj.orientation.z, obj.orientation.w);
+      },
+      kPOPThresholdScale
+    },
+
+    {kPOPSCNNodeOrientationZ,
+      ^(SCNNode *obj, CGFloat values[]) {
+        values[0] = obj.orientation.z;
+      },
+      ^(SCNNode *obj, const CGFloat values[]) {
+        obj.orientation = SCNVector4Make(obj.orientation.x, obj.orientation.y, values[0], obj.orientation.w);
+      },
+      kPOPThresholdScale
+    },
+
+    {kPOPSCNNodeOrientationW,
+      ^(SCNNode *obj, CGFloat values[]) {
+        values[0] = obj.orientation.w;
+      },
+      ^(SCNNode *obj, const CGFloat values[]) {
+        obj.orientation = SCNVector4Make(obj.orientation.x, obj.orientation.y, obj.orientation.z, values[0]);
+      },
+      kPOPThresholdScale
+    },
+
+    {kPOPSCNNodeScale,
+      ^(SCNNode *obj, CGFloat values[]) {
+        values_from_vec3(values, obj.scale);
+      },
+      ^(SCNNode *obj, const CGFloat values[]) {
+        obj.scale = values_to_vec3(values);
+      },
+      kPOPThresholdScale
+    },
+
+    {kPOPSCNNodeScaleX,
+      ^(SCNNode *obj, CGFloat values[]) {
+        values[0] = obj.scale.x;
+      },
+      ^(SCNNode *obj, const CGFloat values[]) {
+        obj.scale = SCNVector3Make(values[0], obj.scale.y, obj.scale.z);
+      },
+      kPOPThresholdScale
+    },
+
+    {kPOPSCNNodeScaleY,
+      ^(SCNNode *obj, CGFloat values[]) {
+        values[0] = obj.scale.y;
+      },
+      ^(SCNNode *obj, const CGFloat values[]) {
+        obj.position = SCNVector3Make(obj.scale.x, values[0], obj.scale.z);
+      },
+      kPOPThresholdScale
+    },
+
+    {kPOPSCNNodeScaleZ,
+      ^(SCNNode *obj, CGFloat values[]) {
+        values[0] = obj.scale.z;
+      },
+      ^(SCNNode *obj, const CGFloat values[]) {
+        obj.scale = SCNVector3Make(obj.scale.x, obj.scale.y, values[0]);
+      },
+      kPOPThresholdScale
+    },
+
+    {kPOPSCNNodeScaleXY,
+      ^(SCNNode *obj, CGFloat values[]) {
+        values[0] = obj.scale.x;
+        values[1] = obj.scale.y;
+      },
+      ^(SCNNode *obj, const CGFloat values[]) {
+        obj.scale = SCNVector3Make(values[0], values[1], obj.scale.z);
+      },
+      kPOPThresholdScale
     },
-    kPOPThresholdScale
-  },
 
-  {kPOPSCNNodeScaleX,
-    ^(SCNNode *obj, CGFloat values[]) {
-      values[0] = obj.scale.x;
-    },
-    ^(SCNNode *obj, const CGFloat values[]) {
-      obj.scale = SCNVector3Make(values[0], obj.scale.y, obj.scale.z);
-    },
-    kPOPThresholdScale
-  },
-
-  {kPOPSCNNodeScaleY,
-    ^(SCNNode *obj, CGFloat values[]) {
-      values[0] = obj.scale.y;
-    },
-    ^(SCNNode *obj, const CGFloat values[]) {
-      obj.position = SCNVector3Make(obj.scale.x, values[0], obj.scale.z);
-    },
-    kPOPThresholdScale
-  },
-
-  {kPOPSCNNodeScaleZ,
-    ^(SCNNode *obj, CGFloat values[]) {
-      values[0] = obj.scale.z;
-    },
-    ^(SCNNode *obj, const CGFloat values[]) {
-      obj.scale = SCNVector3Make(obj.scale.x, obj.scale.y, values[0]);
-    },
-    kPOPThresholdScale
-  },
+#endif
 
-  {kPOPSCNNodeScaleXY,
-    ^(SCNNode *obj, CGFloat values[]) {
-      values[0] = obj.scale.x;
-      values[1] = obj.scale.y;
-    },
-    ^(SCNNode *obj, const CGFloat values[]) {
-      obj.scale = SCNVector3Make(values[0], values[1], obj.scale.z);
-    },
-    kPOPThresholdScale
-  },
+  };
 
-#endif
+  *count = POP_ARRAY_COUNT(states);
+  return states;
+}
 
-};
-#pragma clang diagnostic pop
+/**
+ Returns the perfect hash over static property name hashes, or NULL should two names share a hash.
+ */
+static const POP::PerfectHash *staticIndex()
+{
+  static const POP::PerfectHash *index = []() -> const POP::PerfectHash * {
+    NSUInteger count = 0;
+    POPStaticAnimatablePropertyState *states = staticStates(&count);
+    std::vector<uint64_t> hashes(count);
+    for (NSUInteger idx = 0; idx < count; idx++) {
+      hashes[idx] = states[idx].name.hash;
+    }
+    POP::PerfectHash *perfectHash = new POP::PerfectHash();
+    if (!perfectHash->build(hashes.data(), (uint32_t)count)) {
+      delete perfectHash;
+      return NULL;
+    }
+    return perfectHash;
+  }();
+  return index;
+}
 
 static NSUInteger staticIndexWithName(NSString *aName)
 {
+  NSUInteger count = 0;
+  POPStaticAnimatablePropertyState *states = staticStates(&count);
+
+  const POP::PerfectHash *index = staticIndex();
+  if (NULL != index) {
+    uint32_t idx = index->find(aName.hash);
+    return (POP::PerfectHash::kNotFound != idx && [states[idx].name isEqualToString:aName]) ? idx : NSNotFound;
+  }
+
   NSUInteger idx = 0;
 
-  while (idx < POP_ARRAY_COUNT(_staticStates)) {
-    if ([_staticStates[idx].name isEqualToString:aName])
+  while (idx < count) {
+    if ([states[idx].name isEqualToString:aName])
       return idx;
     idx++;
   }
@@ -1200,6 +1245,125 @@ static NSUInteger staticIndexWithName(NSString *aName)
 
 @end
 
+#pragma mark - Cache
+
+/**
+ Cached property; immutable once published.
+ */
+struct POPPropertyCacheEntry
+{
+  NSUInteger hash;
+  NSString *name;
+  POPAnimatableProperty *property;
+};
+
+/**
+ Insert only open addressing table of cache entries, probed linearly.
+ */
+struct POPPropertyCacheTable
+{
+  size_t mask;
+  size_t count;
+  std::unique_ptr<std::atomic<POPPropertyCacheEntry *>[]> slots;
+
+  explicit POPPropertyCacheTable(size_t capacity) : mask(capacity - 1), count(0), slots(new std::atomic<POPPropertyCacheEntry *>[capacity]()) {}
+
+  size_t home(NSUInteger hash) const
+  {
+    // fibonacci hashing, string hashes vary most in their low bits
+    uint64_t h = (uint64_t)hash * 0x9E3779B97F4A7C15ull;
+    return (size_t)(h ^ (h >> 32)) & mask;
+  }
+};
+
+/**
+ Property cache shared by all threads. Lookups are lock free: they load the current table and probe its slots with
+ acquire ordering. Inserts are serialized by the lock, and each fully built entry is published with a release store
+ into an empty slot. A table at half load is replaced by a copy of twice the size. The old table is never freed, as
+ readers may still be probing it; entries live as long as the process, like the properties they cache.
+ */
+static std::atomic<POPPropertyCacheTable *> _propertyCache(NULL);
+static pthread_mutex_t _propertyCacheLock = PTHREAD_MUTEX_INITIALIZER;
+
+static POPAnimatableProperty *cachedProperty(POPPropertyCacheTable *table, NSString *name, NSUInteger hash)
+{
+  if (NULL == table) {
+    return nil;
+  }
+  for (size_t i = table->home(hash); ; i = (i + 1) & table->mask) {
+    POPPropertyCacheEntry *entry = table->slots[i].load(std::memory_order_acquire);
+    if (NULL == entry) {
+      return nil;
+    }
+    if (hash == entry->hash && [entry->name isEqualToString:name]) {
+      return entry->property;
+    }
+  }
+}
+
+static POPAnimatableProperty *cachedProperty(NSString *name)
+{
+  return cachedProperty(_propertyCache.load(std::memory_order_acquire), name, name.hash);
+}
+
+/**
+ Caches the property under name unless another thread got there first; returns the cached property.
+ */
+static POPAnimatableProperty *cacheProperty(NSString *name, POPAnimatableProperty *property)
+{
+  NSUInteger hash = name.hash;
+
+  // lock
+  pthread_mutex_lock(&_propertyCacheLock);
+
+  POPPropertyCacheTable *table = _propertyCache.load(std::memory_order_relaxed);
+  POPAnimatableProperty *cached = cachedProperty(table, name, hash);
+  if (nil == cached) {
+    // keep load at most one half
+    if (NULL == table || (table->count + 1) * 2 > table->mask + 1) {
+      POPPropertyCacheTable *grown = new POPPropertyCacheTable(NULL == table ? 64 : (table->mask + 1) * 2);
+      if (NULL != table) {
+        for (size_t i = 0; i <= table->mask; i++) {
+          POPPropertyCacheEntry *entry = table->slots[i].load(std::memory_order_relaxed);
+          if (NULL != entry) {
+            size_t j = grown->home(entry->hash);
+            while (NULL != grown->slots[j].load(std::memory_order_relaxed)) {
+              j = (j + 1) & grown->mask;
+            }
+            grown->slots[j].store(entry, std::memory_order_relaxed);
+          }
+        }
+        grown->count = table->count;
+      }
+      _propertyCache.store(grown, std::memory_order_release);
+      table = grown;
+    }
+
+    size_t i = table->home(hash);
+    while (NULL != table->slots[i].load(std::memory_order_relaxed)) {
+      i = (i + 1) & table->mask;
+    }
+    table->slots[i].store(new POPPropertyCacheEntry{hash, [name copy], property}, std::memory_order_release);
+    table->count++;
+    cached = property;
+  }
+
+  // unlock
+  pthread_mutex_unlock(&_propertyCacheLock);
+
+  return cached;
+}
+
+// builds a custom property configured by block
+static POPAnimatableProperty *customProperty(NSString *aName, void (^aBlock)(POPMutableAnimatableProperty *prop))
+{
+  POPMutableAnimatableProperty *mutableProp = [[POPMutableAnimatableProperty alloc] init];
+  mutableProp.name = aName;
+  mutableProp.threshold = 1.0;
+  aBlock(mutableProp);
+  return [mutableProp copy];
+}
+
 #pragma mark - Cluster
 
 /**
@@ -1271,33 +1435,39 @@ static POPAnimatableProperty *placeholder = nil;
 
 + (id)propertyWithName:(NSString *)aName initializer:(void (^)(POPMutableAnimatableProperty *prop))aBlock
 {
-  POPAnimatableProperty *prop = nil;
-
-  static NSMutableDictionary *_propertyDict = nil;
-  if (nil == _propertyDict) {
-    _propertyDict = [[NSMutableDictionary alloc] initWithCapacity:10];
-  }
-
-  prop = _propertyDict[aName];
+  POPAnimatableProperty *prop = cachedProperty(aName);
   if (nil != prop) {
     return prop;
   }
 
+  // build outside the cache lock, the initializer may look up other properties
   NSUInteger staticIdx = staticIndexWithName(aName);
 
   if (NSNotFound != staticIdx) {
+    NSUInteger count = 0;
     POPStaticAnimatableProperty *staticProp = [[POPStaticAnimatableProperty alloc] init];
-    staticProp->_state = &_staticStates[staticIdx];
-    _propertyDict[aName] = staticProp;
-    prop = staticProp;
+    staticProp->_state = &staticStates(&count)[staticIdx];
+    prop = cacheProperty(aName, staticProp);
   } else if (NULL != aBlock) {
-    POPMutableAnimatableProperty *mutableProp = [[POPMutableAnimatableProperty alloc] init];
-    mutableProp.name = aName;
-    mutableProp.threshold = 1.0;
-    aBlock(mutableProp);
-    prop = [mutableProp copy];
+    prop = customProperty(aName, aBlock);
+    if (nil != aName) {
+      prop = cacheProperty(aName, prop);
+    }
+  }
+
+  return prop;
+}
+
++ (id)uncachedPropertyWithName:(NSString *)aName initializer:(void (^)(POPMutableAnimatableProperty *prop))aBlock
+{
+  if (NSNotFound != staticIndexWithName(aName)) {
+    return [self propertyWithName:aName];
   }
 
+  POPAnimatableProperty *prop = nil;
+  if (NULL != aBlock) {
+    prop = customProperty(aName, aBlock);
+  }
   return prop;
 }
 
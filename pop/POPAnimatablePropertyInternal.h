@@ -0,0 +1,22 @@
+/**
+ Copyright (c) 2014-present, Facebook, Inc.
+ All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree. An additional grant
+ of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import <pop/POPAnimatableProperty.h>
+
+@interface POPAnimatableProperty (Internal)
+
+/**
+ @abstract Returns the common property with name if it exists, otherwise a new instance configured by block.
+ @discussion Unlike propertyWithName:initializer:, neither looks up nor caches custom properties, so that each caller gets its own blocks, and one-off names are not retained.
+ */
++ (id)uncachedPropertyWithName:(NSString *)name initializer:(void (^)(POPMutableAnimatableProperty *prop))block;
+
+@end
@@ -19,6 +19,12 @@
 
 using namespace POP;
 
+void _POPAnimationState::unpark()
+{
+  // the animator holding the animation parked, not necessarily the shared one
+  [animator unparkAnimation:self];
+}
+
 #pragma mark - POPAnimation
 
 @implementation POPAnimation
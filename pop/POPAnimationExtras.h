@@ -10,6 +10,7 @@
 #import <QuartzCore/CAAnimation.h>
 
 #import <pop/POPDefines.h>
+#import <pop/POPPropertyAnimation.h>
 #import <pop/POPSpringAnimation.h>
 
 /**
@@ -41,3 +42,18 @@ extern CGFloat POPAnimationDragCoefficient(void);
 + (void)convertTension:(CGFloat)tension friction:(CGFloat)friction toBounciness:(CGFloat *)outBounciness speed:(CGFloat *)outSpeed;
 
 @end
+
+@interface POPPropertyAnimation (POPAnimationExtras)
+
+/**
+ @abstract Bakes the animation into keyframes, without running it.
+ @param rate The sampling rate, in samples per second.
+ @param maxError The maximal deviation of the keyframes, interpolated linearly, from the sampled trajectory. Pass 0 to keep every sample.
+ @param outKeyTimes On return, the keyframe times in seconds from the start of the animation, as NSNumber instances.
+ @param outValues On return, the keyframe values, boxed like fromValue.
+ @returns NO for animations missing values, spring and decay animations without a property threshold, or a non-positive rate.
+ @discussion Supports spring, decay and basic animations, advanced from fromValue and velocity as they would run. Clamping and rounding are not applied. Dividing key times by the last key time gives CAKeyframeAnimation keyTimes.
+ */
+- (BOOL)pop_bakeWithRate:(CGFloat)rate maxError:(CGFloat)maxError keyTimes:(NSArray **)outKeyTimes values:(NSArray **)outValues;
+
+@end
@@ -9,6 +9,10 @@
 
 #import "POPAnimationExtras.h"
 #import "POPAnimationPrivate.h"
+#import "POPBasicAnimationInternal.h"
+#import "POPDecayAnimationInternal.h"
+#import "POPKeyframeTrack.h"
+#import "POPSpringAnimationInternal.h"
 
 #if TARGET_OS_IPHONE
 #import <UIKit/UIKit.h>
@@ -115,3 +119,75 @@ static const CGFloat POPBouncy3FrictionInterpolationMax = 0.01;
 }
 
 @end
+
+@implementation POPPropertyAnimation (POPAnimationExtras)
+
+- (BOOL)pop_bakeWithRate:(CGFloat)rate maxError:(CGFloat)maxError keyTimes:(NSArray **)outKeyTimes values:(NSArray **)outValues
+{
+  _POPPropertyAnimationState *s = (_POPPropertyAnimationState *)POPAnimationGetState(self);
+  const NSUInteger count = s->valueCount;
+  if (rate <= 0 || 0 == count || NULL == s->fromVec) {
+    return NO;
+  }
+
+  POP::KeyframeTrack track;
+  switch (s->type) {
+    case kPOPAnimationSpring: {
+      _POPSpringAnimationState *ss = (_POPSpringAnimationState *)s;
+      if (NULL == ss->toVec || ss->dynamicsThreshold <= 0) {
+        return NO;
+      }
+      track = POP::bake_spring(count, ss->fromVec->data(), ss->toVec->data(), vec_data(ss->velocityVec), ss->dynamicsTension, ss->dynamicsFriction, ss->dynamicsMass, ss->dynamicsThreshold, rate, maxError);
+      break;
+    }
+    case kPOPAnimationDecay: {
+      _POPDecayAnimationState *ds = (_POPDecayAnimationState *)s;
+      if (NULL == ds->velocityVec || ds->dynamicsThreshold <= 0) {
+        return NO;
+      }
+      // computes duration
+      (void)((POPDecayAnimation *)self).duration;
+      track = POP::bake_decay(count, ds->fromVec->data(), ds->velocityVec->data(), ds->deceleration, ds->duration, rate, maxError);
+      break;
+    }
+    case kPOPAnimationBasic: {
+      _POPBasicAnimationState *bs = (_POPBasicAnimationState *)s;
+      if (NULL == bs->toVec) {
+        return NO;
+      }
+      // default timing function, without setting it on the animation
+      double controlPoints[4];
+      CAMediaTimingFunction *timingFunction = bs->timingFunction;
+      if (!timingFunction) {
+        timingFunction = [CAMediaTimingFunction functionWithName:kCAMediaTimingFunctionDefault];
+      }
+      float points[4] = {0.};
+      [timingFunction getControlPointAtIndex:1 values:&points[0]];
+      [timingFunction getControlPointAtIndex:2 values:&points[2]];
+      for (NSUInteger idx = 0; idx < POP_ARRAY_COUNT(points); idx++) {
+        controlPoints[idx] = points[idx];
+      }
+      track = POP::bake_basic(count, bs->fromVec->data(), bs->toVec->data(), controlPoints, bs->duration, rate, maxError);
+      break;
+    }
+    default:
+      return NO;
+  }
+
+  NSMutableArray *keyTimes = [NSMutableArray arrayWithCapacity:track.size()];
+  NSMutableArray *values = [NSMutableArray arrayWithCapacity:track.size()];
+  for (size_t idx = 0; idx < track.size(); idx++) {
+    [keyTimes addObject:@(track.times[idx])];
+    [values addObject:POPBox(VectorRef(Vector::new_vector(count, track.value(idx))), s->valueType, true)];
+  }
+
+  if (outKeyTimes) {
+    *outKeyTimes = keyTimes;
+  }
+  if (outValues) {
+    *outValues = values;
+  }
+  return YES;
+}
+
+@end
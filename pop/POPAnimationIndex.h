@@ -0,0 +1,200 @@
+/**
+ Copyright (c) 2014-present, Facebook, Inc.
+ All rights reserved.
+
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree. An additional grant
+ of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#ifndef __POP__FBAnimationIndex__
+#define __POP__FBAnimationIndex__
+
+#ifdef __cplusplus
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace POP {
+
+  /**
+   Flat open addressing map from (object, key id) to a value.
+   Entries live in one power of two array, probed linearly and deleted by backward shifting, so there are no
+   tombstones. Slots are chosen by object pointer alone, placing the keys of an object in one run of the probe
+   sequence; lookups and per object enumeration scan only that run. Objects are compared by pointer and never
+   retained. Plain C++, no platform dependencies.
+   */
+  template <typename V>
+  class AnimationIndex
+  {
+    struct Entry
+    {
+      const void *object; // NULL when empty
+      uint32_t keyId;
+      V value;
+
+      Entry() : object(NULL), keyId(0), value() {}
+    };
+
+    std::vector<Entry> _entries;
+    size_t _count;
+    size_t _mask;
+
+    size_t home(const void *object) const
+    {
+      // fibonacci hashing of the pointer, aligned bits are mixed into the high bits
+      uint64_t h = (uint64_t)(uintptr_t)object * 0x9E3779B97F4A7C15ull;
+      return (size_t)(h ^ (h >> 32)) & _mask;
+    }
+
+    // slot of the key, or the empty slot ending its probe run
+    size_t slot(const void *object, uint32_t keyId) const
+    {
+      size_t i = home(object);
+      while (NULL != _entries[i].object && !(object == _entries[i].object && keyId == _entries[i].keyId)) {
+        i = (i + 1) & _mask;
+      }
+      return i;
+    }
+
+    void grow()
+    {
+      std::vector<Entry> entries(_entries.empty() ? 16 : _entries.size() * 2);
+      entries.swap(_entries);
+      _mask = _entries.size() - 1;
+      for (Entry &entry : entries) {
+        if (NULL != entry.object) {
+          Entry &target = _entries[slot(entry.object, entry.keyId)];
+          target.object = entry.object;
+          target.keyId = entry.keyId;
+          target.value = std::move(entry.value);
+        }
+      }
+    }
+
+    void eraseSlot(size_t i)
+    {
+      // shift following entries of the run back unless that moves them before their home
+      size_t j = i;
+      for (;;) {
+        j = (j + 1) & _mask;
+        if (NULL == _entries[j].object) {
+          break;
+        }
+        size_t k = home(_entries[j].object);
+        bool movable = (i <= j) ? (k <= i || k > j) : (k <= i && k > j);
+        if (movable) {
+          _entries[i].object = _entries[j].object;
+          _entries[i].keyId = _entries[j].keyId;
+          _entries[i].value = std::move(_entries[j].value);
+          i = j;
+        }
+      }
+      _entries[i].object = NULL;
+      _entries[i].value = V();
+      _count--;
+    }
+
+  public:
+    AnimationIndex() : _count(0), _mask(0) {}
+
+    // Number of entries
+    size_t size() const { return _count; }
+
+    // Returns the value of the key, or NULL
+    V *find(const void *object, uint32_t keyId)
+    {
+      if (0 == _count) {
+        return NULL;
+      }
+      Entry &entry = _entries[slot(object, keyId)];
+      return NULL != entry.object ? &entry.value : NULL;
+    }
+
+    // Sets the value of the key, returning false when replacing an existing value
+    bool insert(const void *object, uint32_t keyId, V value)
+    {
+      // keep load at most one half
+      if ((_count + 1) * 2 > _entries.size()) {
+        grow();
+      }
+      Entry &entry = _entries[slot(object, keyId)];
+      bool inserted = NULL == entry.object;
+      if (inserted) {
+        entry.object = object;
+        entry.keyId = keyId;
+        _count++;
+      }
+      entry.value = std::move(value);
+      return inserted;
+    }
+
+    // Removes the key, moving its value into removed when not NULL; returns false when absent
+    bool erase(const void *object, uint32_t keyId, V *removed = NULL)
+    {
+      if (0 == _count) {
+        return false;
+      }
+      size_t i = slot(object, keyId);
+      if (NULL == _entries[i].object) {
+        return false;
+      }
+      if (NULL != removed) {
+        *removed = std::move(_entries[i].value);
+      }
+      eraseSlot(i);
+      return true;
+    }
+
+    // Removes all entries, keeping storage
+    void clear()
+    {
+      if (0 == _count) {
+        return;
+      }
+      for (Entry &entry : _entries) {
+        entry.object = NULL;
+        entry.value = V();
+      }
+      _count = 0;
+    }
+
+    // Calls f(keyId, value) for each key of the object
+    template <typename F>
+    void forEach(const void *object, F f) const
+    {
+      if (0 == _count) {
+        return;
+      }
+      for (size_t i = home(object); NULL != _entries[i].object; i = (i + 1) & _mask) {
+        if (object == _entries[i].object) {
+          f(_entries[i].keyId, _entries[i].value);
+        }
+      }
+    }
+
+    // Removes all keys of the object, calling f(keyId, value) with each removed value
+    template <typename F>
+    void eraseAll(const void *object, F f)
+    {
+      if (0 == _count) {
+        return;
+      }
+      size_t i = home(object);
+      while (NULL != _entries[i].object) {
+        if (object == _entries[i].object) {
+          // a shifted entry may fill the slot, so visit it again
+          f(_entries[i].keyId, _entries[i].value);
+          eraseSlot(i);
+        } else {
+          i = (i + 1) & _mask;
+        }
+      }
+    }
+  };
+
+}
+
+#endif /* __cplusplus */
+#endif /* defined(__POP__FBAnimationIndex__) */
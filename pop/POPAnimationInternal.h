@@ -15,8 +15,11 @@
 #import "POPAnimationRuntime.h"
 #import "POPAnimationTracerInternal.h"
 #import "POPMath.h"
+#import "POPSlotMap.h"
 #import "POPSpringSolver.h"
 
+@class POPAnimator;
+
 using namespace POP;
 
 /**
@@ -69,17 +72,17 @@ typedef void (^POPAnimationDidApplyBlock)(POPAnimation *anim);
 
 @end
 
-NS_INLINE NSString *describe(VectorConstRef vec)
+NS_INLINE NSString *describe(const VectorRef &vec)
 {
   return NULL == vec ? @"null" : vec->toString();
 }
 
-NS_INLINE Vector4r vector4(VectorConstRef vec)
+NS_INLINE Vector4r vector4(const VectorRef &vec)
 {
   return NULL == vec ? Vector4r::Zero() : vec->vector4r();
 }
 
-NS_INLINE Vector4d vector4d(VectorConstRef vec)
+NS_INLINE Vector4d vector4d(const VectorRef &vec)
 {
   if (NULL == vec) {
     return Vector4d::Zero();
@@ -88,18 +91,20 @@ NS_INLINE Vector4d vector4d(VectorConstRef vec)
   }
 }
 
-NS_INLINE bool vec_equal(VectorConstRef v1, VectorConstRef v2)
+NS_INLINE bool vec_equal(const VectorRef &v1, const VectorRef &v2)
 {
-  if (v1 == v2) {
-    return true;
-  }
   if (!v1 || !v2) {
-    return false;
+    return !v1 && !v2;
   }
   return *v1 == *v2;
 }
 
-NS_INLINE CGFloat * vec_data(VectorRef vec)
+NS_INLINE CGFloat * vec_data(VectorRef &vec)
+{
+  return NULL == vec ? NULL : vec->data();
+}
+
+NS_INLINE const CGFloat * vec_data(const VectorRef &vec)
 {
   return NULL == vec ? NULL : vec->data();
 }
@@ -212,6 +217,8 @@ struct _POPAnimationState
   POPAnimationTracer *tracer;
   CGFloat progress;
   NSInteger repeatCount;
+  POPAnimator * __weak animator; // animator running the animation
+  SlotHandle animatorHandle; // registry slot of the animator running the animation
 
   bool active:1;
   bool paused:1;
@@ -230,6 +237,7 @@ struct _POPAnimationState
   bool autoreverses:1;
   bool repeatForever:1;
   bool customFinished:1;
+  bool parked:1; // paused and held apart from running animations by the animator
 
   _POPAnimationState(id __unsafe_unretained anim) :
   self(anim),
@@ -248,6 +256,8 @@ struct _POPAnimationState
   tracer(nil),
   progress(0),
   repeatCount(0),
+  animator(nil),
+  animatorHandle(),
   active(false),
   paused(true),
   removedOnCompletion(true),
@@ -262,7 +272,8 @@ struct _POPAnimationState
   userSpecifiedDynamics(false),
   autoreverses(false),
   repeatForever(false),
-  customFinished(false) {}
+  customFinished(false),
+  parked(false) {}
 
   virtual ~_POPAnimationState()
   {
@@ -307,6 +318,11 @@ struct _POPAnimationState
       paused = f;
       if (!paused) {
         reset(false);
+
+        // return to running animations
+        if (parked) {
+          unpark();
+        }
       }
     }
   }
@@ -315,6 +331,8 @@ struct _POPAnimationState
     return progress;
   }
 
+  void unpark();
+
   /* returns true if started */
   bool startIfNeeded(id obj, CFTimeInterval time, CFTimeInterval offset)
   {
@@ -72,7 +72,7 @@ extern CFMutableDictionaryRef POPDictionaryCreateMutableWeakPointerToStrongObjec
 /**
  Box a vector.
  */
-extern id POPBox(VectorConstRef vec, POPValueType type, bool force = false);
+extern id POPBox(const VectorRef &vec, POPValueType type, bool force = false);
 
 /**
  Unbox a vector.
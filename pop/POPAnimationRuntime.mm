@@ -201,7 +201,7 @@ NSString *POPValueTypeToString(POPValueType t)
   }
 }
 
-id POPBox(VectorConstRef vec, POPValueType type, bool force)
+id POPBox(const VectorRef &vec, POPValueType type, bool force)
 {
   if (NULL == vec)
     return nil;
@@ -247,7 +247,7 @@ id POPBox(VectorConstRef vec, POPValueType type, bool force)
 
 static VectorRef vectorize(id value, POPValueType type)
 {
-  Vector *vec = NULL;
+  Vector vec;
 
   switch (type) {
     case kPOPValueInteger:
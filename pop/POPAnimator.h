@@ -10,6 +10,7 @@
 #import <Foundation/Foundation.h>
 
 @protocol POPAnimatorDelegate;
+@protocol POPFrameSource;
 
 /**
  @abstract The animator class renders animations.
@@ -29,16 +30,78 @@
 - (instancetype)initWithDisplayID:(CGDirectDisplayID)displayID;
 #endif
 
+/**
+ @abstract Initializes an animator driven by the specified frame source instead of a display link.
+ @discussion The animator reads time from the source and pauses it while idle. Animations are added to the animator through its funnel methods; the NSObject additions use the shared animator.
+ */
+- (instancetype)initWithFrameSource:(id<POPFrameSource>)frameSource;
+
+/**
+ @abstract The frame source driving the animator, or nil when driven by a display link.
+ */
+@property (readonly, nonatomic) id<POPFrameSource> frameSource;
+
+/**
+ @abstract Renders a frame at the current time. Called by frame sources.
+ */
+- (void)render;
+
 /**
  @abstract The optional animator delegate.
  */
 @property (weak, nonatomic) id<POPAnimatorDelegate> delegate;
 
 /**
- @abstract Retrieves the nominal refresh period of a display link. Returns zero if unavailable.
+ @abstract Retrieves the nominal refresh period of a display link. Returns zero if unavailable, including when driven by a frame source.
  */
 @property (readonly, nonatomic) CFTimeInterval refreshPeriod;
 
+/**
+ @abstract The maximum number of solver steps a spring animation integrates per frame.
+ @discussion Bounds the cost of the frame following a hitch. Springs exceeding the budget are evaluated in closed form, independent of the elapsed time. Decay animations are always evaluated in closed form. Set to 0 for unbounded integration, stopping springs after time gaps over 30 seconds. Defaults to 100.
+ */
+@property (assign, nonatomic) NSUInteger maxSolverStepsPerFrame;
+
+/**
+ @abstract The number of running animations of one type from which their solver math is computed concurrently.
+ @discussion Spring, decay and basic animations of a type are then advanced across worker threads, and written and called out on the animating thread in order afterwards. As their math has already advanced, changes a callout makes to a later animation of the same type take effect on the next frame rather than the current one. Custom animations always advance on the animating thread. Set to NSUIntegerMax to always advance on the animating thread. Defaults to 256.
+ */
+@property (assign, nonatomic) NSUInteger concurrentComputeThreshold;
+
+/**
+ @abstract Whether frame metrics are recorded. Defaults to NO.
+ @discussion Recording times the compute and write phases of each frame and counts running animations, solver steps, and performed and skipped writes, without allocating.
+ */
+@property (assign, nonatomic) BOOL metricsEnabled;
+
+/**
+ @abstract The recorded frame metrics as a JSON object.
+ @discussion Contains frame, solver step and write totals; the p50, p95, p99 and maximum milliseconds of the total, compute, write and callback phases over the last 512 frames; and the counters of the last frame. The callback phase is the remainder of the total, covering callouts and bookkeeping.
+ */
+- (NSString *)metricsJSON;
+
+/**
+ @abstract The recorded frame metrics, as parsed from metricsJSON.
+ */
+- (NSDictionary *)metrics;
+
+/**
+ @abstract Removes all recorded frame metrics.
+ */
+- (void)resetMetrics;
+
+/**
+ @abstract The number of most recent events kept by the animator trace. Defaults to 0.
+ @discussion Setting a positive capacity starts tracing into an empty buffer, rounded up to a power of two; setting 0 stops tracing, keeping the recorded events. Animation adds, starts, stops and value writes, and rendered frames, are recorded from any thread without locking or allocating.
+ */
+@property (assign, nonatomic) NSUInteger traceCapacity;
+
+/**
+ @abstract The recorded trace in Chrome trace event format, loadable by chrome://tracing and Perfetto.
+ @discussion Frames are complete events; animations are async slices from start to stop, named by animation type, with adds and writes as instant events.
+ */
+- (NSString *)traceJSON;
+
 @end
 
 /**
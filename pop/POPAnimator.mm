@@ -10,7 +10,10 @@
 #import "POPAnimator.h"
 #import "POPAnimatorPrivate.h"
 
-#import <list>
+#import <algorithm>
+#import <atomic>
+#import <memory>
+#import <type_traits>
 #import <vector>
 
 #if !TARGET_OS_IPHONE
@@ -23,8 +26,18 @@
 
 #import "POPAnimation.h"
 #import "POPAnimationExtras.h"
+#import "POPAnimationIndex.h"
+#import "POPAnimatorMetrics.h"
 #import "POPBasicAnimationInternal.h"
+#import "POPCommandQueue.h"
 #import "POPDecayAnimation.h"
+#import "POPDecayAnimationInternal.h"
+#import "POPFrameSource.h"
+#import "POPLayerExtras.h"
+#import "POPSpringAnimationInternal.h"
+#import "POPSlotMap.h"
+#import "POPSpringBatch.h"
+#import "POPTraceBuffer.h"
 
 using namespace std;
 using namespace POP;
@@ -48,40 +61,626 @@ using namespace POP;
 static const uint64_t kDisplayTimerFrequency = 60ull; // Hz
 #endif
 
+static const NSUInteger kMaxSolverStepsPerFrame = 100;
+static const NSUInteger kConcurrentComputeThreshold = 256;
+static const NSUInteger kParkedSweepInterval = 60; // frames between checks of parked items for deallocated objects
+
+// running items are bucketed by animation type
+static const NSUInteger kPOPAnimatorBucketCount = kPOPAnimationCustom + 1;
+
 class POPAnimatorItem
 {
 public:
   id __weak object;
-  NSString *key;
   POPAnimation *animation;
-  NSInteger refCount;
   id __unsafe_unretained unretainedObject;
-
-  POPAnimatorItem(id o, NSString *k, POPAnimation *a) POP_NOTHROW
+  uint32_t keyId;
+  POPAnimationState *state;
+  POPAnimationType type;
+  SlotHandle handle;
+  SlotMap<POPAnimatorItem *> *registry; // registry holding the item, or NULL
+  bool removed;   // deleted once placed
+  bool parked;    // placed apart from running items
+  bool deferred;  // placement deferred to the end of the frame
+  bool waiting;   // placed apart from running items until its begin time
+
+  POPAnimatorItem(id o, uint32_t k, POPAnimation *a) POP_NOTHROW
   {
     object = o;
-    key = [k copy];
     animation = a;
-    refCount = 1;
     unretainedObject = o;
+    keyId = k;
+    state = POPAnimationGetState(a);
+    type = state->type;
+    registry = NULL;
+    removed = false;
+    parked = false;
+    deferred = false;
+    waiting = false;
   }
 
   ~POPAnimatorItem()
   {
   }
+};
+
+/**
+ Interned animation keys, identifying keys of the animation index by integer id.
+ Named keys map to ids by string; anonymous keys take ids from a counter and are named on demand. Ids are
+ counted by index entries and reused once unreferenced. Repeated key strings, typically literals, are found
+ by pointer in a small cache before hashing; only interned copies are cached, so a mutable key mutated after
+ use is looked up by its new contents. Not thread safe.
+ */
+class POPAnimatorKeyTable
+{
+  struct Record
+  {
+    NSString *name;       // nil for unnamed anonymous keys
+    uint32_t references;
+    uint32_t generation;  // changed on reuse, invalidating cache entries
+  };
+
+  struct CacheEntry
+  {
+    NSString *name;       // retained, keeping the pointer unique
+    uint32_t keyId;
+    uint32_t generation;
+  };
+
+  static const size_t kCacheSize = 64;
+
+  std::vector<Record> _records;
+  std::vector<uint32_t> _unused;
+  CFMutableDictionaryRef _ids; // name to id
+  CacheEntry _cache[kCacheSize];
+
+  static size_t cacheSlot(NSString *name)
+  {
+    return ((uintptr_t)(__bridge void *)name >> 4) & (kCacheSize - 1);
+  }
+
+  uint32_t allocate()
+  {
+    uint32_t keyId;
+    if (!_unused.empty()) {
+      keyId = _unused.back();
+      _unused.pop_back();
+    } else {
+      keyId = (uint32_t)_records.size();
+      Record record = {nil, 0, 0};
+      _records.push_back(record);
+    }
+    return keyId;
+  }
+
+  void setName(uint32_t keyId, NSString *name)
+  {
+    _records[keyId].name = name;
+    CFDictionarySetValue(_ids, (__bridge void *)name, (void *)(uintptr_t)keyId);
+  }
+
+public:
+  static const uint32_t kNotFound = UINT32_MAX;
+
+  POPAnimatorKeyTable() : _cache()
+  {
+    CFDictionaryValueCallBacks vcb = {0, NULL, NULL, NULL, NULL};
+    _ids = CFDictionaryCreateMutable(NULL, 0, &kCFTypeDictionaryKeyCallBacks, &vcb);
+  }
+
+  ~POPAnimatorKeyTable()
+  {
+    CFRelease(_ids);
+  }
+
+  // Returns the id of a named key in use, or kNotFound
+  uint32_t find(NSString *name)
+  {
+    CacheEntry &entry = _cache[cacheSlot(name)];
+    if (name == entry.name && entry.generation == _records[entry.keyId].generation) {
+      return entry.keyId;
+    }
+
+    const void *value;
+    if (!CFDictionaryGetValueIfPresent(_ids, (__bridge void *)name, &value)) {
+      return kNotFound;
+    }
+    uint32_t keyId = (uint32_t)(uintptr_t)value;
+
+    // cache only the interned copy, whose contents cannot change under the pointer
+    if (name == _records[keyId].name) {
+      entry.name = name;
+      entry.keyId = keyId;
+      entry.generation = _records[keyId].generation;
+    }
+    return keyId;
+  }
+
+  // Returns the id of a named key, interning it, and adds a reference
+  uint32_t retain(NSString *name)
+  {
+    uint32_t keyId = find(name);
+    if (kNotFound == keyId) {
+      keyId = allocate();
+      setName(keyId, [name copy]);
+    }
+    _records[keyId].references++;
+    return keyId;
+  }
+
+  // Returns a new anonymous key with one reference
+  uint32_t retainAnonymous()
+  {
+    uint32_t keyId = allocate();
+    _records[keyId].references++;
+    return keyId;
+  }
+
+  // Removes a reference, releasing the id when unreferenced
+  void release(uint32_t keyId)
+  {
+    Record &record = _records[keyId];
+    if (0 != --record.references) {
+      return;
+    }
+    if (nil != record.name) {
+      CFDictionaryRemoveValue(_ids, (__bridge void *)record.name);
+      record.name = nil;
+    }
+    record.generation++;
+    _unused.push_back(keyId);
+  }
 
-  bool operator==(const POPAnimatorItem& o) const {
-    return unretainedObject == o.unretainedObject && animation == o.animation && [key isEqualToString:o.key];
+  // Returns the name of a key, naming anonymous keys
+  NSString *name(uint32_t keyId)
+  {
+    Record &record = _records[keyId];
+    if (nil == record.name) {
+      setName(keyId, [[NSUUID UUID] UUIDString]);
+    }
+    return record.name;
   }
+};
+
+// animations by (object, key id)
+typedef AnimationIndex<POPAnimation *> POPAnimatorIndex;
+
+// items owned by the registries; placement changes wait until no frame renders them
+typedef SlotMap<POPAnimatorItem *> POPAnimatorItemRegistry;
+
+// new item awaiting its first render; stale once the item is removed
+struct POPAnimatorPendingItem
+{
+  POPAnimationType type;
+  SlotHandle handle;
+};
+
+// waiting item due at its begin time; stale once the item leaves the waiting items
+struct POPAnimatorDelayedItem
+{
+  CFTimeInterval beginTime;
+  SlotHandle handle;
+
+  // orders a min-heap by begin time
+  bool operator<(const POPAnimatorDelayedItem &other) const { return beginTime > other.beginTime; }
+};
+
+enum POPAnimatorCommandType
+{
+  kPOPAnimatorCommandAdd,
+  kPOPAnimatorCommandRemove,
+  kPOPAnimatorCommandUnpark,
+};
+
+/**
+ Registry change submitted by any thread, applied by the rendering thread at the start of a frame.
+ */
+struct POPAnimatorCommand
+{
+  POPAnimatorCommandType type;
+  POPAnimatorItem *item;    // item to add
+  POPAnimation *animation;  // animation to remove or unpark
 
+  POPAnimatorCommand() : type(kPOPAnimatorCommandAdd), item(NULL), animation(nil) {}
+  POPAnimatorCommand(POPAnimatorCommandType t, POPAnimatorItem *i, POPAnimation *a) : type(t), item(i), animation(a) {}
 };
 
-typedef std::shared_ptr<POPAnimatorItem> POPAnimatorItemRef;
-typedef std::shared_ptr<const POPAnimatorItem> POPAnimatorItemConstRef;
+enum POPAnimatorWrite
+{
+  kPOPAnimatorWriteNone,
+  kPOPAnimatorWriteSkipped,
+  kPOPAnimatorWritePerformed,
+};
+
+/**
+ Adds the time of a scope to a phase of the frame sample, when sampling.
+ */
+struct POPAnimatorPhaseTimer
+{
+  AnimatorMetrics::Sample *sample;
+  AnimatorMetrics::Phase phase;
+  CFTimeInterval startTime;
+
+  POPAnimatorPhaseTimer(AnimatorMetrics::Sample *s, AnimatorMetrics::Phase p) : sample(s), phase(p), startTime(NULL != s ? CACurrentMediaTime() : 0) {}
+
+  ~POPAnimatorPhaseTimer()
+  {
+    if (NULL != sample) {
+      sample->time[phase] += CACurrentMediaTime() - startTime;
+    }
+  }
+};
+
+// defined with the animator
+static POPAnimatorWrite updateAnimatable(id obj, POPPropertyAnimationState *anim, bool shouldAvoidExtraneousWrite);
+static AnimatorMetrics::Sample *frameSample(POPAnimator *self);
+static TraceBuffer *traceBuffer(POPAnimator *self);
+static void stopAndCleanup(POPAnimator *self, POPAnimatorItem *item, bool shouldRemove, bool finished);
+static void parkItem(POPAnimator *self, POPAnimatorItem *item);
+static void waitItem(POPAnimator *self, POPAnimatorItem *item);
+
+/**
+ Evaluation of one animation type. Calls are bound to State at compile time, avoiding virtual dispatch and
+ casts in the per frame loop; custom animations use POPAnimationState and its generic advance.
+ */
+
+// writes property animation values; other animations have none
+static inline POPAnimatorWrite updateStateAnimatable(id obj, POPAnimationState *state, bool shouldAvoidExtraneousWrite)
+{
+  return kPOPAnimatorWriteNone;
+}
+
+static inline POPAnimatorWrite updateStateAnimatable(id obj, POPPropertyAnimationState *state, bool shouldAvoidExtraneousWrite)
+{
+  return updateAnimatable(obj, state, shouldAvoidExtraneousWrite);
+}
+
+// records an animation event when tracing
+static void traceAnimation(TraceBuffer *trace, TraceEventType type, POPAnimationState *state, double value = 0)
+{
+  if (NULL == trace) {
+    return;
+  }
+  TraceEvent event = {CACurrentMediaTime(), (uint64_t)(uintptr_t)state, (uint8_t)type, (uint8_t)state->type, 0, {value, 0, 0, 0}};
+  trace->record(event);
+}
+
+// records written values of property animations; other animations write none
+static inline void traceStateWrite(TraceBuffer *trace, POPAnimationState *state) {}
+
+static inline void traceStateWrite(TraceBuffer *trace, POPPropertyAnimationState *state)
+{
+  TraceEvent event = {CACurrentMediaTime(), (uint64_t)(uintptr_t)state, kTraceEventWrite, (uint8_t)state->type, 0, {0, 0, 0, 0}};
+  if (state->currentVec) {
+    size_t count = MIN(state->currentVec->size(), (size_t)4);
+    for (size_t idx = 0; idx < count; idx++) {
+      event.values[idx] = state->currentVec->data()[idx];
+    }
+    event.valueCount = (uint8_t)count;
+  }
+  trace->record(event);
+}
+
+// writes values, counting writes when sampling and recording them when tracing
+template <class State>
+static void writeState(POPAnimator *self, id obj, State *state, bool shouldAvoidExtraneousWrite)
+{
+  AnimatorMetrics::Sample *sample = frameSample(self);
+  POPAnimatorPhaseTimer timer(sample, AnimatorMetrics::kPhaseWrite);
+  POPAnimatorWrite write = updateStateAnimatable(obj, state, shouldAvoidExtraneousWrite);
+  if (NULL != sample) {
+    sample->writes += (kPOPAnimatorWritePerformed == write) ? 1 : 0;
+    sample->skippedWrites += (kPOPAnimatorWriteSkipped == write) ? 1 : 0;
+  }
+
+  TraceBuffer *trace = traceBuffer(self);
+  if (NULL != trace && kPOPAnimatorWritePerformed == write) {
+    traceStateWrite(trace, state);
+  }
+}
+
+// solver steps of the last advance; other animations have none
+static inline size_t solverStepCount(POPAnimationState *state)
+{
+  return 0;
+}
+
+static inline size_t solverStepCount(POPSpringAnimationState *state)
+{
+  return NULL != state->solver ? state->solver->stepCount() : 0;
+}
+
+// finalizes property animation progress; other animations have none
+static inline void finalizeStateProgress(POPAnimationState *state) {}
+
+static inline void finalizeStateProgress(POPPropertyAnimationState *state)
+{
+  state->finalizeProgress();
+}
+
+// advances solver and progress, without callouts; with advanceTime's callouts removed
+template <class State>
+static bool computeState(State *state, CFTimeInterval time, id obj)
+{
+  CFTimeInterval dt = time - state->lastTime;
+  if (!state->State::advance(time, dt, obj)) {
+    return false;
+  }
+
+  // basic animations compute progress while advancing
+  if (!std::is_same<State, POPBasicAnimationState>::value) {
+    state->State::computeProgress();
+  }
+  return true;
+}
+
+template <>
+bool computeState<POPAnimationState>(POPAnimationState *state, CFTimeInterval time, id obj)
+{
+  // the block calls out, reading and setting current layer transforms
+  POPLayerFlushTransformBatch();
+
+  CFTimeInterval dt = time - state->lastTime;
+  state->customFinished = [state->self _advance:obj currentTime:time elapsedTime:dt] ? false : true;
+  state->computeProgress();
+  return true;
+}
+
+// returns whether computeState may run off the animating thread
+template <class State>
+static inline bool canComputeConcurrently(State *state)
+{
+  return true;
+}
+
+template <>
+inline bool canComputeConcurrently<POPBasicAnimationState>(POPBasicAnimationState *state)
+{
+  // a missing timing function is defaulted through the animation
+  return nil != state->timingFunction;
+}
+
+template <class State>
+static void applyAnimationToValue(POPAnimator *self, id obj, State *state)
+{
+  // finalize progress
+  finalizeStateProgress(state);
+
+  // write to value, updating only if needed
+  writeState(self, obj, state, true);
+
+  state->State::delegateApply();
+}
+
+// applies a computed item, handling completion; on the animating thread, in item order
+template <class State>
+static void applyItem(POPAnimator *self, POPAnimatorItem *item, id obj, bool advanced, CFTimeInterval time, CFTimeInterval offset)
+{
+  POPAnimation *anim = item->animation;
+  State *state = static_cast<State *>(item->state);
+
+  if (advanced) {
+    AnimatorMetrics::Sample *sample = frameSample(self);
+    if (NULL != sample) {
+      sample->solverSteps += solverStepCount(state);
+    }
+
+    // delegate progress
+    state->State::delegateProgress();
+
+    // update time
+    state->lastTime = time;
+
+    // object exists; animate
+    writeState(self, obj, state, false);
+    state->State::delegateApply();
+  }
+
+  FBLogAnimDebug(@"time:%f running:%@", time, anim);
+  if (state->State::isDone()) {
+    // set end value
+    applyAnimationToValue(self, obj, state);
+
+    state->repeatCount--;
+    if (state->repeatForever || state->repeatCount > 0) {
+      if ([anim isKindOfClass:[POPPropertyAnimation class]]) {
+        POPPropertyAnimation *propAnim = (POPPropertyAnimation *)anim;
+        id oldFromValue = propAnim.fromValue;
+        propAnim.fromValue = propAnim.toValue;
+
+        if (state->autoreverses) {
+          if (state->tracing) {
+            [state->tracer autoreversed];
+          }
+
+          if (state->type == kPOPAnimationDecay) {
+            POPDecayAnimation *decayAnimation = (POPDecayAnimation *)propAnim;
+            decayAnimation.velocity = [decayAnimation reversedVelocity];
+          } else {
+            propAnim.toValue = oldFromValue;
+          }
+        } else {
+          if (state->type == kPOPAnimationDecay) {
+            POPDecayAnimation *decayAnimation = (POPDecayAnimation *)propAnim;
+            id originalVelocity = decayAnimation.originalVelocity;
+            decayAnimation.velocity = originalVelocity;
+          } else {
+            propAnim.fromValue = oldFromValue;
+          }
+        }
+      }
+
+      state->stop(NO, NO);
+      state->reset(true);
+
+      state->startIfNeeded(obj, time, offset);
+    } else {
+      stopAndCleanup(self, item, state->removedOnCompletion, YES);
+    }
+  }
+}
+
+// starts item if needed, returning whether it runs this frame; stops items of deallocated objects
+static bool startItem(POPAnimator *self, POPAnimatorItem *item, id obj, CFTimeInterval time, CFTimeInterval offset)
+{
+  if (nil == obj) {
+    // object exists not; stop animating
+    NSCAssert(item->unretainedObject, @"object should exist");
+    stopAndCleanup(self, item, true, false);
+    return false;
+  }
+
+  // only run active, not paused animations
+  POPAnimationState *state = item->state;
+  if (state->startIfNeeded(obj, time, offset)) {
+    traceAnimation(traceBuffer(self), kTraceEventStart, state);
+  }
+  return state->active && !state->paused;
+}
+
+// parks active, paused animations until unpaused
+static void parkItemIfPaused(POPAnimator *self, POPAnimatorItem *item)
+{
+  POPAnimationState *state = item->state;
+  if (state->active && state->paused && !item->parked && !item->removed) {
+    parkItem(self, item);
+  }
+}
+
+// sets aside animations not started by their begin time until due
+static void waitItemIfDelayed(POPAnimator *self, POPAnimatorItem *item)
+{
+  if (0 == item->state->startTime && !item->waiting && !item->parked && !item->removed) {
+    waitItem(self, item);
+  }
+}
+
+template <class State>
+static void renderItem(POPAnimator *self, POPAnimatorItem *item, CFTimeInterval time, CFTimeInterval offset)
+{
+  if (item->removed) {
+    return;
+  }
+
+  id obj = item->object;
+  if (startItem(self, item, obj, time, offset)) {
+    bool advanced;
+    {
+      POPAnimatorPhaseTimer timer(frameSample(self), AnimatorMetrics::kPhaseCompute);
+      advanced = computeState(static_cast<State *>(item->state), time, obj);
+    }
+    applyItem<State>(self, item, obj, advanced, time, offset);
+  }
 
-typedef std::list<POPAnimatorItemRef> POPAnimatorItemList;
-typedef POPAnimatorItemList::iterator POPAnimatorItemListIterator;
-typedef POPAnimatorItemList::const_iterator POPAnimatorItemListConstIterator;
+  if (nil != obj) {
+    parkItemIfPaused(self, item);
+    waitItemIfDelayed(self, item);
+  }
+}
+
+/**
+ Running item of a concurrently computed bucket.
+ */
+struct POPAnimatorComputeItem
+{
+  POPAnimatorItem *item;
+  id object;      // retained through the frame
+  bool running;
+  bool computed;
+  bool advanced;
+
+  POPAnimatorComputeItem(POPAnimatorItem *i, id o, bool r) : item(i), object(o), running(r), computed(false), advanced(false) {}
+};
+
+// items computed per worker task
+static const size_t kPOPAnimatorComputeChunkSize = 64;
+
+/**
+ Renders the items of one type. From threshold items on, rendering runs in three phases: items are started in
+ order, advanced concurrently across worker threads, then applied in order on the animating thread. Callouts
+ happen only in the ordered phases. Later items of the bucket stopped or paused by them are not applied; other
+ changes they make to later items take effect next frame.
+ */
+template <class State>
+static void renderBucket(POPAnimator *self, POPAnimatorItem * const *items, size_t count, CFTimeInterval time, CFTimeInterval offset, size_t threshold, std::vector<POPAnimatorComputeItem> &computeItems)
+{
+  // custom animations call out to their block
+  if (count < threshold || std::is_same<State, POPAnimationState>::value) {
+    for (size_t idx = 0; idx < count; idx++) {
+      renderItem<State>(self, items[idx], time, offset);
+    }
+    return;
+  }
+
+  // start items, in order
+  computeItems.clear();
+  for (size_t idx = 0; idx < count; idx++) {
+    POPAnimatorItem *item = items[idx];
+    if (!item->removed) {
+      id obj = item->object;
+      bool running = startItem(self, item, obj, time, offset);
+      if (nil != obj) {
+        computeItems.push_back(POPAnimatorComputeItem(item, obj, running));
+      }
+    }
+  }
+
+  // advance concurrently
+  {
+    POPAnimatorPhaseTimer timer(frameSample(self), AnimatorMetrics::kPhaseCompute);
+    POPAnimatorComputeItem *data = computeItems.data();
+    const size_t computeCount = computeItems.size();
+    const size_t chunkCount = (computeCount + kPOPAnimatorComputeChunkSize - 1) / kPOPAnimatorComputeChunkSize;
+    dispatch_apply(chunkCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_HIGH, 0), ^(size_t chunk) {
+      size_t end = MIN((chunk + 1) * kPOPAnimatorComputeChunkSize, computeCount);
+      for (size_t idx = chunk * kPOPAnimatorComputeChunkSize; idx < end; idx++) {
+        POPAnimatorComputeItem &computeItem = data[idx];
+        State *state = static_cast<State *>(computeItem.item->state);
+        if (computeItem.running && canComputeConcurrently(state)) {
+          computeItem.advanced = computeState(state, time, computeItem.object);
+          computeItem.computed = true;
+        }
+      }
+    });
+  }
+
+  // apply, in order; callouts of earlier items may have stopped or paused later ones
+  for (POPAnimatorComputeItem &computeItem : computeItems) {
+    POPAnimatorItem *item = computeItem.item;
+    POPAnimationState *state = item->state;
+    if (computeItem.running && !item->removed && state->active && !state->paused) {
+      if (!computeItem.computed) {
+        POPAnimatorPhaseTimer timer(frameSample(self), AnimatorMetrics::kPhaseCompute);
+        computeItem.advanced = computeState(static_cast<State *>(item->state), time, computeItem.object);
+      }
+      applyItem<State>(self, item, computeItem.object, computeItem.advanced, time, offset);
+    }
+    parkItemIfPaused(self, item);
+    waitItemIfDelayed(self, item);
+  }
+
+  // release objects, keeping storage
+  computeItems.clear();
+}
+
+// renders one item of any type
+static void renderAnyItem(POPAnimator *self, POPAnimatorItem *item, CFTimeInterval time, CFTimeInterval offset)
+{
+  switch (item->type) {
+    case kPOPAnimationSpring:
+      renderItem<POPSpringAnimationState>(self, item, time, offset);
+      break;
+    case kPOPAnimationDecay:
+      renderItem<POPDecayAnimationState>(self, item, time, offset);
+      break;
+    case kPOPAnimationBasic:
+      renderItem<POPBasicAnimationState>(self, item, time, offset);
+      break;
+    default:
+      renderItem<POPAnimationState>(self, item, time, offset);
+      break;
+  }
+}
 
 #if !TARGET_OS_IPHONE
 static BOOL _disableBackgroundThread = YES;
@@ -98,17 +697,43 @@ static uint64_t _displayTimerFrequency = kDisplayTimerFrequency;
   BOOL _displayTimerRunning;
   int32_t _enqueuedRender;
 #endif
-  POPAnimatorItemList _list;
-  CFMutableDictionaryRef _dict;
+  POPAnimatorItemRegistry _items[kPOPAnimatorBucketCount];
+  POPAnimatorItemRegistry _parkedItems;
+  POPAnimatorItemRegistry _waitingItems;
+  std::vector<POPAnimatorDelayedItem> _delayedItems;
+  dispatch_source_t _wakeTimer;
+  id<POPFrameSource> _frameSource;
+  AnimatorMetrics _metrics;
+  AnimatorMetrics::Sample _frameSample;
+  std::atomic<bool> _metricsEnabled;
+  bool _sampling;
+  std::atomic<TraceBuffer *> _trace;
+  std::vector<std::unique_ptr<TraceBuffer>> _traceBuffers;
+  CommandQueue<POPAnimatorCommand> _commands;
+  std::atomic<bool> _idle;
+  POPAnimatorIndex _index;
+  POPAnimatorKeyTable _keys;
+  pthread_mutex_t _indexLock;
   NSMutableArray *_observers;
-  POPAnimatorItemList _pendingList;
+  std::vector<POPAnimatorPendingItem> _pendingItems;
   CFRunLoopObserverRef _pendingListObserver;
+  std::atomic<bool> _pendingListScheduled;
   CFTimeInterval _slowMotionStartTime;
   CFTimeInterval _slowMotionLastTime;
   CFTimeInterval _slowMotionAccumulator;
   CFTimeInterval _beginTime;
   pthread_mutex_t _lock;
   BOOL _disableDisplayLink;
+  NSUInteger _maxSolverStepsPerFrame;
+  NSUInteger _concurrentComputeThreshold;
+  SpringBatch _springBatch;
+  std::vector<POPSpringAnimationState *> _springBatchStates;
+  std::vector<POPAnimatorItem *> _pendingRenderItems;
+  std::vector<POPAnimatorComputeItem> _computeItems;
+  std::vector<POPAnimatorItem *> _deferredItems;
+  std::vector<POPAnimatorItem *> _orphanedItems;
+  NSUInteger _parkedSweepCountdown;
+  NSUInteger _renderDepth;
 }
 @end
 
@@ -116,6 +741,7 @@ static uint64_t _displayTimerFrequency = kDisplayTimerFrequency;
 @synthesize delegate = _delegate;
 @synthesize disableDisplayLink = _disableDisplayLink;
 @synthesize beginTime = _beginTime;
+@synthesize frameSource = _frameSource;
 
 #if !TARGET_OS_IPHONE
 static CVReturn displayLinkCallback(CVDisplayLinkRef displayLink, const CVTimeStamp *now, const CVTimeStamp *outputTime, CVOptionFlags flagsIn, CVOptionFlags *flagsOut, void *context)
@@ -137,10 +763,120 @@ static CVReturn displayLinkCallback(CVDisplayLinkRef displayLink, const CVTimeSt
 }
 #endif
 
+// sample of the frame being rendered, or NULL when not sampling; on the animating thread
+static AnimatorMetrics::Sample *frameSample(POPAnimator *self)
+{
+  return self->_sampling ? &self->_frameSample : NULL;
+}
+
+// buffer recording events, or NULL when not tracing; any thread
+static TraceBuffer *traceBuffer(POPAnimator *self)
+{
+  return self->_trace.load(std::memory_order_acquire);
+}
+
+// starts sampling an outermost frame; call while holding lock
+static void beginFrameSample(POPAnimator *self)
+{
+  self->_sampling = self->_metricsEnabled;
+  if (!self->_sampling) {
+    return;
+  }
+
+  AnimatorMetrics::Sample &sample = self->_frameSample;
+  sample = AnimatorMetrics::Sample();
+  sample.springCount = self->_items[kPOPAnimationSpring].size();
+  sample.decayCount = self->_items[kPOPAnimationDecay].size();
+  sample.basicCount = self->_items[kPOPAnimationBasic].size();
+  sample.customCount = self->_items[kPOPAnimationCustom].size();
+  sample.waitingCount = self->_waitingItems.size();
+  sample.parkedCount = self->_parkedItems.size();
+}
+
+// records the sampled frame; call while holding lock
+static void endFrameSample(POPAnimator *self, CFTimeInterval startTime)
+{
+  if (!self->_sampling) {
+    return;
+  }
+  self->_sampling = false;
+
+  AnimatorMetrics::Sample &sample = self->_frameSample;
+  double *time = sample.time;
+  time[AnimatorMetrics::kPhaseTotal] = CACurrentMediaTime() - startTime;
+  time[AnimatorMetrics::kPhaseCallback] = MAX(time[AnimatorMetrics::kPhaseTotal] - time[AnimatorMetrics::kPhaseCompute] - time[AnimatorMetrics::kPhaseWrite], 0.);
+  self->_metrics.record(sample);
+}
+
+// call while holding lock
+static bool hasRunningItems(POPAnimator *self)
+{
+  for (NSUInteger idx = 0; idx < kPOPAnimatorBucketCount; idx++) {
+    if (!self->_items[idx].empty()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// schedules a render at the earliest begin time of waiting items while sleeping; call while holding lock
+static void updateWakeTimer(POPAnimator *self, bool sleeping)
+{
+  if (nil != self->_frameSource) {
+    [self->_frameSource requestFrameAtTime:(sleeping && !self->_delayedItems.empty()) ? self->_delayedItems.front().beginTime : 0];
+    return;
+  }
+
+  if (!sleeping || self->_delayedItems.empty()) {
+    if (NULL != self->_wakeTimer) {
+      dispatch_source_set_timer(self->_wakeTimer, DISPATCH_TIME_FOREVER, DISPATCH_TIME_FOREVER, 0);
+    }
+    return;
+  }
+
+  if (NULL == self->_wakeTimer) {
+    self->_wakeTimer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, dispatch_get_main_queue());
+    __weak POPAnimator *weakSelf = self;
+    dispatch_source_set_event_handler(self->_wakeTimer, ^{
+      [weakSelf render];
+    });
+    dispatch_resume(self->_wakeTimer);
+  }
+
+  // render times follow media time; a stale earliest entry only wakes early
+  CFTimeInterval delay = MAX(self->_delayedItems.front().beginTime - CACurrentMediaTime(), 0.);
+  dispatch_source_set_timer(self->_wakeTimer, dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), DISPATCH_TIME_FOREVER, NSEC_PER_MSEC);
+}
+
 // call while holding lock
 static void updateDisplayLink(POPAnimator *self)
 {
-  BOOL paused = (0 == self->_observers.count && self->_list.empty()) || self->_disableDisplayLink;
+  BOOL paused = (0 == self->_observers.count && !hasRunningItems(self)) || self->_disableDisplayLink;
+  self->_idle = paused;
+
+  // a producer pushing before the store above may have read the animator as running and not woken it, so check
+  // for commands only after publishing idleness; pairs with the fence in -_submitCommand:
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (paused && !self->_disableDisplayLink && !self->_commands.empty()) {
+    paused = NO;
+    self->_idle = false;
+  }
+
+  // objects of parked items may deallocate while idle; check on waking
+  if (paused) {
+    self->_parkedSweepCountdown = 0;
+  }
+
+  // sleep until the next delayed start
+  updateWakeTimer(self, paused && !self->_disableDisplayLink);
+
+  if (nil != self->_frameSource) {
+    if (paused != self->_frameSource.paused) {
+      FBLogAnimInfo(paused ? @"pausing frame source" : @"unpausing frame source");
+      self->_frameSource.paused = paused;
+    }
+    return;
+  }
 
 #if TARGET_OS_IPHONE
   if (paused != self->_displayLink.paused) {
@@ -172,16 +908,26 @@ static void updateDisplayLink(POPAnimator *self)
 #endif
 }
 
-static void updateAnimatable(id obj, POPPropertyAnimationState *anim, bool shouldAvoidExtraneousWrite = false)
+static void updateMaxSolverSteps(POPAnimationState *state, NSUInteger maxSteps)
+{
+  if (kPOPAnimationSpring == state->type) {
+    SpringSolver4d *solver = static_cast<POPSpringAnimationState *>(state)->solver;
+    if (NULL != solver) {
+      solver->setMaxSteps(maxSteps);
+    }
+  }
+}
+
+static POPAnimatorWrite updateAnimatable(id obj, POPPropertyAnimationState *anim, bool shouldAvoidExtraneousWrite)
 {
   // handle user-initiated stop or pause; halt animation
   if (!anim->active || anim->paused)
-    return;
+    return kPOPAnimatorWriteNone;
 
   if (anim->hasValue()) {
     POPAnimatablePropertyWriteBlock write = anim->property.writeBlock;
     if (NULL == write)
-      return;
+      return kPOPAnimatorWriteNone;
 
     // current animation value
     VectorRef currentVec = anim->currentValue();
@@ -197,7 +943,7 @@ static void updateAnimatable(id obj, POPPropertyAnimationState *anim, bool shoul
           Vector4r currentValue = currentVec->vector4r();
           Vector4r objectValue = read_values(read, obj, anim->valueCount);
           if (objectValue == currentValue) {
-            return;
+            return kPOPAnimatorWriteSkipped;
           }
         }
       }
@@ -215,7 +961,7 @@ static void updateAnimatable(id obj, POPPropertyAnimationState *anim, bool shoul
       POPAnimatablePropertyReadBlock read = anim->property.readBlock;
       NSCAssert(read, @"additive requires an animatable property readBlock");
       if (NULL == read) {
-        return;
+        return kPOPAnimatorWriteNone;
       }
 
       // object value
@@ -232,7 +978,7 @@ static void updateAnimatable(id obj, POPPropertyAnimationState *anim, bool shoul
 
       // avoid writing no change
       if (shouldAvoidExtraneousWrite && currentValue == Vector4r::Zero()) {
-        return;
+        return kPOPAnimatorWriteSkipped;
       }
       
       // add to object value
@@ -248,89 +994,274 @@ static void updateAnimatable(id obj, POPPropertyAnimationState *anim, bool shoul
         [anim->tracer writePropertyValue:POPBox(currentVec, anim->valueType, true)];
       }
     }
+    return kPOPAnimatorWritePerformed;
   }
+  return kPOPAnimatorWriteNone;
 }
 
-static void applyAnimationTime(id obj, POPAnimationState *state, CFTimeInterval time)
+static void advanceSpringBatch(POPAnimator *self, POPAnimatorItem * const *items, size_t count, CFTimeInterval time)
 {
-  if (!state->advanceTime(time, obj)) {
+  SpringBatch &batch = self->_springBatch;
+  std::vector<POPSpringAnimationState *> &states = self->_springBatchStates;
+  batch.clear();
+  states.clear();
+
+  // gather running springs, one lane per component
+  for (size_t idx = 0; idx < count; idx++) {
+    POPAnimatorItem *item = items[idx];
+    if (item->removed || kPOPAnimationSpring != item->type) {
+      continue;
+    }
+
+    POPSpringAnimationState *ss = static_cast<POPSpringAnimationState *>(item->state);
+    if (!ss->canBatch(time)) {
+      continue;
+    }
+
+    SpringSolver4d *solver = ss->solver;
+    SSTransition tr = solver->integratedTransition(solverDt);
+    const SSState4d &input = (ss->batched.input = ss->solverState());
+    const Vector4d &dv = solver->lastDv();
+    CFTimeInterval dt = time - ss->lastTime;
+    NSUInteger count = MIN(ss->valueCount, (NSUInteger)4);
+
+    for (NSUInteger idx = 0; idx < count; idx++) {
+      batch.addLane(input.p[idx], input.v[idx], dv[idx], solver->accumulatedTime(), dt, tr.pp, tr.pv, tr.vp, tr.vv);
+    }
+    states.push_back(ss);
+  }
+
+  if (states.empty()) {
     return;
   }
-  
-  POPPropertyAnimationState *ps = dynamic_cast<POPPropertyAnimationState*>(state);
-  if (NULL != ps) {
-    updateAnimatable(obj, ps);
+
+  batch.advance(solverDt);
+
+  // scatter results, consumed by each animation's advance
+  size_t lane = 0;
+  for (POPSpringAnimationState *ss : states) {
+    NSUInteger count = MIN(ss->valueCount, (NSUInteger)4);
+    ss->batched.output.p = ss->batched.output.v = ss->batched.dv = Vector4d::Zero();
+    for (NSUInteger idx = 0; idx < count; idx++) {
+      ss->batched.output.p[idx] = batch.position(lane + idx);
+      ss->batched.output.v[idx] = batch.velocity(lane + idx);
+      ss->batched.dv[idx] = batch.acceleration(lane + idx);
+    }
+    ss->batched.stepCount = (NSUInteger)llround((ss->solver->accumulatedTime() + (time - ss->lastTime) - batch.accumulatedTime(lane)) / solverDt);
+    ss->batched.accumulatedTime = batch.accumulatedTime(lane);
+    ss->batched.time = time;
+    lane += count;
   }
-  
-  state->delegateApply();
 }
 
-static void applyAnimationToValue(id obj, POPAnimationState *state)
+// removes the index entry of anim, releasing its key
+static void deleteIndexEntry(POPAnimator *self, id __unsafe_unretained obj, uint32_t keyId, POPAnimation *anim)
 {
-  POPPropertyAnimationState *ps = dynamic_cast<POPPropertyAnimationState*>(state);
+  // lock
+  pthread_mutex_lock(&self->_indexLock);
 
-  if (NULL != ps) {
-    
-    // finalize progress
-    ps->finalizeProgress();
-    
-    // write to value, updating only if needed
-    updateAnimatable(obj, ps, true);
+  // the key may have been reassigned to another animation
+  POPAnimation * __strong *existing = self->_index.find((__bridge void *)obj, keyId);
+  if (NULL != existing && anim == *existing) {
+    self->_index.erase((__bridge void *)obj, keyId);
+    self->_keys.release(keyId);
   }
-  
-  state->delegateApply();
+
+  // unlock
+  pthread_mutex_unlock(&self->_indexLock);
 }
 
-static POPAnimation *deleteDictEntry(POPAnimator *self, id __unsafe_unretained obj, NSString *key, BOOL cleanup = YES)
+// returns the item of anim, or NULL; lock held
+static POPAnimatorItem *findItem(POPAnimator *self, POPAnimation *anim)
 {
-  POPAnimation *anim = nil;
+  POPAnimationState *state = POPAnimationGetState(anim);
+  const SlotHandle &handle = state->animatorHandle;
+  POPAnimatorItem **item = self->_items[state->type].get(handle);
+  if (NULL != item && anim == (*item)->animation && !(*item)->removed) {
+    return *item;
+  }
+  item = self->_parkedItems.get(handle);
+  if (NULL != item && anim == (*item)->animation && !(*item)->removed) {
+    return *item;
+  }
+  item = self->_waitingItems.get(handle);
+  if (NULL != item && anim == (*item)->animation && !(*item)->removed) {
+    return *item;
+  }
+
+  // added while rendering
+  for (POPAnimatorItem *deferred : self->_deferredItems) {
+    if (anim == deferred->animation && !deferred->removed) {
+      return deferred;
+    }
+  }
+  return NULL;
+}
+
+// moves item to the registry matching its flags, deleting removed items; lock held, not rendering
+static void placeItem(POPAnimator *self, POPAnimatorItem *item)
+{
+  POPAnimatorItemRegistry *registry = item->registry;
+  POPAnimatorItemRegistry *target = item->removed ? NULL : (item->parked ? &self->_parkedItems : (item->waiting ? &self->_waitingItems : &self->_items[item->type]));
+  if (registry == target) {
+    return;
+  }
 
+  if (NULL != registry) {
+    registry->erase(item->handle);
+  }
+
+  if (NULL == target) {
+    delete item;
+    return;
+  }
+
+  item->handle = target->insert(item);
+  item->registry = target;
+  item->state->animator = self;
+  item->state->animatorHandle = item->handle;
+  item->state->parked = item->parked;
+
+  if (NULL == registry) {
+    // bound catch up cost
+    updateMaxSolverSteps(item->state, self->_maxSolverStepsPerFrame);
+
+    // render new items on the next pending pass
+    POPAnimatorPendingItem pending = {item->type, item->handle};
+    self->_pendingItems.push_back(pending);
+  }
+
+  if (item->waiting) {
+    // due at the earliest begin time first
+    POPAnimatorDelayedItem delayed = {item->state->beginTime, item->handle};
+    self->_delayedItems.push_back(delayed);
+    std::push_heap(self->_delayedItems.begin(), self->_delayedItems.end());
+  }
+}
+
+// places item, or defers placement to the end of the frame while rendering; lock held
+static void updateItem(POPAnimator *self, POPAnimatorItem *item)
+{
+  if (0 == self->_renderDepth) {
+    placeItem(self, item);
+  } else if (!item->deferred) {
+    item->deferred = true;
+    self->_deferredItems.push_back(item);
+  }
+}
+
+// lock held
+static void removeItem(POPAnimator *self, POPAnimatorItem *item)
+{
+  item->removed = true;
+  updateItem(self, item);
+}
+
+static void parkItem(POPAnimator *self, POPAnimatorItem *item)
+{
   // lock
   pthread_mutex_lock(&self->_lock);
 
-  NSMutableDictionary *keyAnimationsDict = (__bridge id)CFDictionaryGetValue(self->_dict, (__bridge void *)obj);
-  if (keyAnimationsDict) {
+  item->parked = true;
+  item->state->parked = true;
+  updateItem(self, item);
 
-    anim = keyAnimationsDict[key];
-    if (anim) {
+  // unlock
+  pthread_mutex_unlock(&self->_lock);
+}
 
-      // remove key
-      [keyAnimationsDict removeObjectForKey:key];
+static void waitItem(POPAnimator *self, POPAnimatorItem *item)
+{
+  // lock
+  pthread_mutex_lock(&self->_lock);
 
-      // cleanup empty dictionaries
-      if (cleanup && 0 == keyAnimationsDict.count) {
-        CFDictionaryRemoveValue(self->_dict, (__bridge void *)obj);
-      }
-    }
-  }
+  item->waiting = true;
+  updateItem(self, item);
 
   // unlock
   pthread_mutex_unlock(&self->_lock);
-  return anim;
 }
 
-static void stopAndCleanup(POPAnimator *self, POPAnimatorItemRef item, bool shouldRemove, bool finished)
+// returns waiting items due by time to the running items; lock held
+static void startDueItems(POPAnimator *self, CFTimeInterval time, CFTimeInterval offset)
+{
+  std::vector<POPAnimatorDelayedItem> &delayedItems = self->_delayedItems;
+  while (!delayedItems.empty() && time >= delayedItems.front().beginTime + offset) {
+    POPAnimatorItem **item = self->_waitingItems.get(delayedItems.front().handle);
+    std::pop_heap(delayedItems.begin(), delayedItems.end());
+    delayedItems.pop_back();
+
+    if (NULL != item && (*item)->waiting) {
+      (*item)->waiting = false;
+      updateItem(self, *item);
+    }
+  }
+}
+
+// gathers parked items of deallocated objects, which are otherwise visited only on unpark; lock held
+static void sweepParkedItems(POPAnimator *self, std::vector<POPAnimatorItem *> &orphanedItems)
+{
+  if (0 != self->_parkedSweepCountdown--) {
+    return;
+  }
+  self->_parkedSweepCountdown = kParkedSweepInterval;
+
+  for (POPAnimatorItem *item : self->_parkedItems) {
+    if (nil == item->object) {
+      orphanedItems.push_back(item);
+    }
+  }
+}
+
+// applies commands submitted since the last frame; lock held
+static void drainCommands(POPAnimator *self)
+{
+  POPAnimatorCommand command;
+  while (self->_commands.pop(command)) {
+    switch (command.type) {
+      case kPOPAnimatorCommandAdd:
+        updateItem(self, command.item);
+        break;
+      case kPOPAnimatorCommandRemove: {
+        POPAnimatorItem *item = findItem(self, command.animation);
+        if (NULL != item) {
+          removeItem(self, item);
+        }
+        break;
+      }
+      case kPOPAnimatorCommandUnpark: {
+        POPAnimatorItem *item = findItem(self, command.animation);
+        if (NULL != item && item->parked) {
+          item->parked = false;
+          updateItem(self, item);
+        }
+        break;
+      }
+    }
+  }
+}
+
+static void stopAndCleanup(POPAnimator *self, POPAnimatorItem *item, bool shouldRemove, bool finished)
 {
   // remove
   if (shouldRemove) {
-    deleteDictEntry(self, item->unretainedObject, item->key);
+    deleteIndexEntry(self, item->unretainedObject, item->keyId, item->animation);
   }
 
   // stop
-  POPAnimationState *state = POPAnimationGetState(item->animation);
+  POPAnimationState *state = item->state;
+  if (state->active) {
+    traceAnimation(traceBuffer(self), kTraceEventStop, state, finished ? 1 : 0);
+  }
   state->stop(shouldRemove, finished);
 
   if (shouldRemove) {
     // lock
     pthread_mutex_lock(&self->_lock);
 
-    // find item in list
     // may have already been removed on animationDidStop:
-    POPAnimatorItemListIterator find_iter = find(self->_list.begin(), self->_list.end(), item);
-    BOOL found = find_iter != self->_list.end();
-
-    if (found) {
-      self->_list.erase(find_iter);
+    if (!item->removed) {
+      removeItem(self, item);
     }
 
     // unlock
@@ -405,8 +1336,30 @@ static void stopAndCleanup(POPAnimator *self, POPAnimatorItemRef item, bool shou
   }
 #endif
 
-  _dict = POPDictionaryCreateMutableWeakPointerToStrongObject(5);
+  _maxSolverStepsPerFrame = kMaxSolverStepsPerFrame;
+  _concurrentComputeThreshold = kConcurrentComputeThreshold;
+  _idle = true;
   pthread_mutex_init(&_lock, NULL);
+  pthread_mutex_init(&_indexLock, NULL);
+
+  return self;
+}
+
+- (instancetype)initWithFrameSource:(id<POPFrameSource>)frameSource
+{
+  NSAssert(nil != frameSource, @"attempting to initialize %@ without frame source", self);
+  self = [super init];
+  if (nil == self) return nil;
+
+  _frameSource = frameSource;
+  _frameSource.animator = self;
+  _frameSource.paused = YES;
+
+  _maxSolverStepsPerFrame = kMaxSolverStepsPerFrame;
+  _concurrentComputeThreshold = kConcurrentComputeThreshold;
+  _idle = true;
+  pthread_mutex_init(&_lock, NULL);
+  pthread_mutex_init(&_indexLock, NULL);
 
   return self;
 }
@@ -427,8 +1380,11 @@ static void stopAndCleanup(POPAnimator *self, POPAnimatorItemRef item, bool shou
   }
   CVDisplayLinkSetOutputCallback(_displayLink, displayLinkCallback, (__bridge void *)self);
   
-  _dict = POPDictionaryCreateMutableWeakPointerToStrongObject(5);
+  _maxSolverStepsPerFrame = kMaxSolverStepsPerFrame;
+  _concurrentComputeThreshold = kConcurrentComputeThreshold;
+  _idle = true;
   pthread_mutex_init(&_lock, NULL);
+  pthread_mutex_init(&_indexLock, NULL);
   
   return self;
 }
@@ -450,10 +1406,38 @@ static void stopAndCleanup(POPAnimator *self, POPAnimatorItemRef item, bool shou
 #endif
     _displayTimer = NULL;
   }
-#endif
-  [self _clearPendingListObserver];
-  
+#endif
+  if (_wakeTimer != NULL) {
+    dispatch_source_cancel(_wakeTimer);
+#if !OS_OBJECT_USE_OBJC
+    dispatch_release(_wakeTimer);
+#endif
+    _wakeTimer = NULL;
+  }
+  [self _clearPendingListObserver];
+
+  // items added since the last frame
+  POPAnimatorCommand command;
+  while (_commands.pop(command)) {
+    if (kPOPAnimatorCommandAdd == command.type) {
+      delete command.item;
+    }
+  }
+
+  for (POPAnimatorItemRegistry &registry : _items) {
+    for (POPAnimatorItem *item : registry) {
+      delete item;
+    }
+  }
+  for (POPAnimatorItem *item : _parkedItems) {
+    delete item;
+  }
+  for (POPAnimatorItem *item : _waitingItems) {
+    delete item;
+  }
+
   pthread_mutex_destroy(&_lock);
+  pthread_mutex_destroy(&_indexLock);
 }
 
 #pragma mark - Utility
@@ -462,17 +1446,20 @@ static void stopAndCleanup(POPAnimator *self, POPAnimatorItemRef item, bool shou
 {
   // rendering pending animations
   CFTimeInterval time = [self _currentRenderTime];
-  [self _renderTime:(0 != _beginTime) ? _beginTime : time items:_pendingList];
+  [self _renderTime:(0 != _beginTime) ? _beginTime : time pending:YES];
 
   // lock
   pthread_mutex_lock(&_lock);
 
   // clear list and observer
-  _pendingList.clear();
+  _pendingItems.clear();
   [self _clearPendingListObserver];
 
   // unlock
   pthread_mutex_unlock(&_lock);
+
+  // allow scheduling again
+  _pendingListScheduled = false;
 }
 
 - (void)_clearPendingListObserver
@@ -490,27 +1477,46 @@ static void stopAndCleanup(POPAnimator *self, POPAnimatorItemRef item, bool shou
   static const CFIndex CATransactionCommitRunLoopOrder = 2000000;
   static const CFIndex POPAnimationApplyRunLoopOrder = CATransactionCommitRunLoopOrder - 1;
 
-  // lock
-  pthread_mutex_lock(&_lock);
+  // schedule once until processed, without contending with rendering
+  if (_pendingListScheduled.exchange(true)) {
+    return;
+  }
 
-  if (!_pendingListObserver) {
-    __weak POPAnimator *weakSelf = self;
+  __weak POPAnimator *weakSelf = self;
 
-    _pendingListObserver = CFRunLoopObserverCreateWithHandler(kCFAllocatorDefault, kCFRunLoopBeforeWaiting | kCFRunLoopExit, false, POPAnimationApplyRunLoopOrder, ^(CFRunLoopObserverRef observer, CFRunLoopActivity activity) {
-      [weakSelf _processPendingList];
-    });
+  CFRunLoopObserverRef observer = CFRunLoopObserverCreateWithHandler(kCFAllocatorDefault, kCFRunLoopBeforeWaiting | kCFRunLoopExit, false, POPAnimationApplyRunLoopOrder, ^(CFRunLoopObserverRef observer, CFRunLoopActivity activity) {
+    [weakSelf _processPendingList];
+  });
 
-    if (_pendingListObserver) {
-      CFRunLoopAddObserver(CFRunLoopGetMain(), _pendingListObserver,  kCFRunLoopCommonModes);
-    }
+  if (observer) {
+    // read only once the observer fires
+    _pendingListObserver = observer;
+    CFRunLoopAddObserver(CFRunLoopGetMain(), observer, kCFRunLoopCommonModes);
+  } else {
+    _pendingListScheduled = false;
   }
+}
 
-  // unlock
-  pthread_mutex_unlock(&_lock);
+// queues a registry change for the next frame; any thread
+- (void)_submitCommand:(const POPAnimatorCommand &)command
+{
+  _commands.push(command);
+
+  // wake an idle animator; a running one drains on its next frame, or sees the command on going idle
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (_idle) {
+    // lock
+    pthread_mutex_lock(&_lock);
+    updateDisplayLink(self);
+    // unlock
+    pthread_mutex_unlock(&_lock);
+  }
 }
 
-- (void)_renderTime:(CFTimeInterval)time items:(std::list<POPAnimatorItemRef>)items
+- (void)_renderTime:(CFTimeInterval)time pending:(BOOL)pending
 {
+  const CFTimeInterval startTime = CACurrentMediaTime();
+
   // begin transaction with actions disabled
   [CATransaction begin];
   [CATransaction setDisableActions:YES];
@@ -519,26 +1525,91 @@ static void stopAndCleanup(POPAnimator *self, POPAnimatorItemRef item, bool shou
   __strong __typeof__(_delegate) delegate = _delegate;
   [delegate animatorWillAnimate:self];
 
+  // write each animated layer transform once
+  POPLayerBeginTransformBatch();
+
   // lock
   pthread_mutex_lock(&_lock);
 
-  // count active animations
-  const NSUInteger count = items.size();
-  if (0 == count) {
-    // unlock
-    pthread_mutex_unlock(&_lock);
+  // apply changes submitted since the last frame
+  drainCommands(self);
+
+  const CFTimeInterval offset = _slowMotionAccumulator;
+  const size_t threshold = _concurrentComputeThreshold;
+
+  // run delayed animations once due
+  startDueItems(self, time, offset);
+
+  // sample outermost frames, and check parked items periodically
+  std::vector<POPAnimatorItem *> orphanedItems;
+  if (0 == _renderDepth) {
+    beginFrameSample(self);
+    orphanedItems.swap(_orphanedItems);
+    sweepParkedItems(self, orphanedItems);
+  }
+
+  // registries stay unchanged while rendering, so items are iterated in place
+  _renderDepth++;
+
+  // gather new items, reusing storage of previous passes
+  std::vector<POPAnimatorItem *> pendingItems;
+  if (pending) {
+    pendingItems.swap(_pendingRenderItems);
+    for (const POPAnimatorPendingItem &pendingItem : _pendingItems) {
+      POPAnimatorItem **item = _items[pendingItem.type].get(pendingItem.handle);
+      if (NULL != item) {
+        pendingItems.push_back(*item);
+      }
+    }
+  }
+
+  // unlock
+  pthread_mutex_unlock(&_lock);
+
+  // stop parked animations of deallocated objects, as running ones are
+  if (!orphanedItems.empty()) {
+    for (POPAnimatorItem *item : orphanedItems) {
+      stopAndCleanup(self, item, true, false);
+    }
+    orphanedItems.clear();
+  }
+
+  if (pending) {
+    // few new items of mixed types
+    {
+      POPAnimatorPhaseTimer timer(frameSample(self), AnimatorMetrics::kPhaseCompute);
+      advanceSpringBatch(self, pendingItems.data(), pendingItems.size(), time);
+    }
+    for (POPAnimatorItem *item : pendingItems) {
+      renderAnyItem(self, item, time, offset);
+    }
   } else {
-    // copy list into vector
-    std::vector<POPAnimatorItemRef> vector{ items.begin(), items.end() };
+    // advance running springs together
+    POPAnimatorItemRegistry &springs = _items[kPOPAnimationSpring];
+    {
+      POPAnimatorPhaseTimer timer(frameSample(self), AnimatorMetrics::kPhaseCompute);
+      advanceSpringBatch(self, springs.data(), springs.size(), time);
+    }
 
-    // unlock
-    pthread_mutex_unlock(&_lock);
+    // evaluate each type in its own loop, reusing storage of previous frames; nested renders start empty
+    std::vector<POPAnimatorComputeItem> computeItems;
+    computeItems.swap(_computeItems);
+    renderBucket<POPSpringAnimationState>(self, springs.data(), springs.size(), time, offset, threshold, computeItems);
+    renderBucket<POPDecayAnimationState>(self, _items[kPOPAnimationDecay].data(), _items[kPOPAnimationDecay].size(), time, offset, threshold, computeItems);
+    renderBucket<POPBasicAnimationState>(self, _items[kPOPAnimationBasic].data(), _items[kPOPAnimationBasic].size(), time, offset, threshold, computeItems);
+    renderBucket<POPAnimationState>(self, _items[kPOPAnimationCustom].data(), _items[kPOPAnimationCustom].size(), time, offset, threshold, computeItems);
 
-    for (auto item : vector) {
-      [self _renderTime:time item:item];
+    // lock
+    pthread_mutex_lock(&_lock);
+    if (computeItems.capacity() > _computeItems.capacity()) {
+      computeItems.swap(_computeItems);
     }
+    // unlock
+    pthread_mutex_unlock(&_lock);
   }
 
+  POPLayerEndTransformBatch();
+
   // notify observers
   for (id observer in self.observers) {
     [observer animatorDidAnimate:(id)self];
@@ -547,6 +1618,32 @@ static void stopAndCleanup(POPAnimator *self, POPAnimatorItemRef item, bool shou
   // lock
   pthread_mutex_lock(&_lock);
 
+  // apply additions, removals and parking made while rendering
+  if (0 == --_renderDepth) {
+    orphanedItems.swap(_orphanedItems);
+
+    for (size_t idx = 0; idx < _deferredItems.size(); idx++) {
+      POPAnimatorItem *item = _deferredItems[idx];
+      item->deferred = false;
+      placeItem(self, item);
+    }
+    _deferredItems.clear();
+
+    endFrameSample(self, startTime);
+
+    TraceBuffer *trace = traceBuffer(self);
+    if (NULL != trace) {
+      TraceEvent event = {startTime, 0, kTraceEventFrame, 0, 0, {CACurrentMediaTime() - startTime, 0, 0, 0}};
+      trace->record(event);
+    }
+  }
+
+  // keep storage for the next pending pass
+  if (pending) {
+    pendingItems.clear();
+    pendingItems.swap(_pendingRenderItems);
+  }
+
   // update display link
   updateDisplayLink(self);
 
@@ -558,72 +1655,6 @@ static void stopAndCleanup(POPAnimator *self, POPAnimatorItemRef item, bool shou
   [CATransaction commit];
 }
 
-- (void)_renderTime:(CFTimeInterval)time item:(POPAnimatorItemRef)item
-{
-  id obj = item->object;
-  POPAnimation *anim = item->animation;
-  POPAnimationState *state = POPAnimationGetState(anim);
-
-  if (nil == obj) {
-    // object exists not; stop animating
-    NSAssert(item->unretainedObject, @"object should exist");
-    stopAndCleanup(self, item, true, false);
-  } else {
-
-    // start if needed
-    state->startIfNeeded(obj, time, _slowMotionAccumulator);
-
-    // only run active, not paused animations
-    if (state->active && !state->paused) {
-      // object exists; animate
-      applyAnimationTime(obj, state, time);
-
-      FBLogAnimDebug(@"time:%f running:%@", time, item->animation);
-      if (state->isDone()) {
-        // set end value
-        applyAnimationToValue(obj, state);
-
-        state->repeatCount--;
-        if (state->repeatForever || state->repeatCount > 0) {
-          if ([anim isKindOfClass:[POPPropertyAnimation class]]) {
-            POPPropertyAnimation *propAnim = (POPPropertyAnimation *)anim;
-            id oldFromValue = propAnim.fromValue;
-            propAnim.fromValue = propAnim.toValue;
-
-            if (state->autoreverses) {
-              if (state->tracing) {
-                [state->tracer autoreversed];
-              }
-
-              if (state->type == kPOPAnimationDecay) {
-                POPDecayAnimation *decayAnimation = (POPDecayAnimation *)propAnim;
-                decayAnimation.velocity = [decayAnimation reversedVelocity];
-              } else {
-                propAnim.toValue = oldFromValue;
-              }
-            } else {
-              if (state->type == kPOPAnimationDecay) {
-                POPDecayAnimation *decayAnimation = (POPDecayAnimation *)propAnim;
-                id originalVelocity = decayAnimation.originalVelocity;
-                decayAnimation.velocity = originalVelocity;
-              } else {
-                propAnim.fromValue = oldFromValue;
-              }
-            }
-          }
-
-          state->stop(NO, NO);
-          state->reset(true);
-
-          state->startIfNeeded(obj, time, _slowMotionAccumulator);
-        } else {
-          stopAndCleanup(self, item, state->removedOnCompletion, YES);
-        }
-      }
-    }
-  }
-}
-
 #pragma mark - API
 
 - (NSArray *)observers
@@ -645,54 +1676,46 @@ static void stopAndCleanup(POPAnimator *self, POPAnimatorItemRef item, bool shou
     return;
   }
 
+  // lock
+  pthread_mutex_lock(&_indexLock);
+
   // support arbitrarily many nil keys
-  if (!key) {
-    key = [[NSUUID UUID] UUIDString];
+  uint32_t keyId = key ? _keys.retain(key) : _keys.retainAnonymous();
+
+  // if the animation instance already exists, avoid cancelling only to restart
+  POPAnimation * __strong *existing = _index.find((__bridge void *)obj, keyId);
+  POPAnimation *existingAnim = existing ? *existing : nil;
+  if (existingAnim == anim) {
+    _keys.release(keyId);
+
+    // unlock
+    pthread_mutex_unlock(&_indexLock);
+    return;
   }
 
-  // lock
-  pthread_mutex_lock(&_lock);
+  // replace the existing animation, keeping the reference of its entry
+  _index.insert((__bridge void *)obj, keyId, anim);
+  if (existingAnim) {
+    _keys.release(keyId);
+  }
 
-  // get key, animation dict associated with object
-  NSMutableDictionary *keyAnimationDict = (__bridge id)CFDictionaryGetValue(_dict, (__bridge void *)obj);
+  // unlock
+  pthread_mutex_unlock(&_indexLock);
 
-  // update associated animation state
-  if (nil == keyAnimationDict) {
-    keyAnimationDict = [NSMutableDictionary dictionary];
-    CFDictionarySetValue(_dict, (__bridge void *)obj, (__bridge void *)keyAnimationDict);
-  } else {
-    // if the animation instance already exists, avoid cancelling only to restart
-    POPAnimation *existingAnim = keyAnimationDict[key];
-    if (existingAnim) {
-      // unlock
-      pthread_mutex_unlock(&_lock);
-
-      if (existingAnim == anim) {
-        return;
-      }
-      [self removeAnimationForObject:obj key:key cleanupDict:NO];
-        
-      // lock
-      pthread_mutex_lock(&_lock);
-    }
+  if (existingAnim) {
+    [self removeReplacedAnimation:existingAnim];
   }
-  keyAnimationDict[key] = anim;
 
   // create entry after potential removal
-  POPAnimatorItemRef item(new POPAnimatorItem(obj, key, anim));
-
-  // add to list and pending list
-  _list.push_back(item);
-  _pendingList.push_back(item);
+  POPAnimatorItem *item = new POPAnimatorItem(obj, keyId, anim);
 
   // support animation re-use, reset all animation state
-  POPAnimationGetState(anim)->reset(true);
-
-  // update display link
-  updateDisplayLink(self);
+  POPAnimationState *state = POPAnimationGetState(anim);
+  state->reset(true);
+  traceAnimation(traceBuffer(self), kTraceEventAdd, state);
 
-  // unlock
-  pthread_mutex_unlock(&_lock);
+  // add to running and pending items on the next frame
+  [self _submitCommand:POPAnimatorCommand(kPOPAnimatorCommandAdd, item, nil)];
 
   // schedule runloop processing of pending animations
   [self _scheduleProcessPendingList];
@@ -700,121 +1723,271 @@ static void stopAndCleanup(POPAnimator *self, POPAnimatorItemRef item, bool shou
 
 - (void)removeAllAnimationsForObject:(id)obj
 {
+  NSMutableArray *animations = [NSMutableArray array];
+
   // lock
-  pthread_mutex_lock(&_lock);
+  pthread_mutex_lock(&_indexLock);
 
-  NSArray *animations = [(__bridge id)CFDictionaryGetValue(_dict, (__bridge void *)obj) allValues];
-  CFDictionaryRemoveValue(_dict, (__bridge void *)obj);
+  POPAnimatorKeyTable &keys = _keys;
+  _index.eraseAll((__bridge void *)obj, [animations, &keys](uint32_t keyId, POPAnimation *anim) {
+    [animations addObject:anim];
+    keys.release(keyId);
+  });
 
   // unlock
-  pthread_mutex_unlock(&_lock);
+  pthread_mutex_unlock(&_indexLock);
 
   if (0 == animations.count) {
     return;
   }
 
-  NSHashTable *animationSet = [[NSHashTable alloc] initWithOptions:NSHashTableObjectPointerPersonality capacity:animations.count];
-  for (id animation in animations) {
-    [animationSet addObject:animation];
+  // remove from registries on the next frame
+  for (POPAnimation *anim in animations) {
+    [self _submitCommand:POPAnimatorCommand(kPOPAnimatorCommandRemove, NULL, anim)];
   }
 
-  // lock
-  pthread_mutex_lock(&_lock);
-
-  POPAnimatorItemRef item;
-  for (auto iter = _list.begin(); iter != _list.end();) {
-    item = *iter;
-    if(![animationSet containsObject:item->animation]) {
-      iter++;
-    } else {
-      iter = _list.erase(iter);
+  TraceBuffer *trace = traceBuffer(self);
+  for (POPAnimation *anim in animations) {
+    POPAnimationState *state = POPAnimationGetState(anim);
+    if (state->active) {
+      traceAnimation(trace, kTraceEventStop, state);
     }
+    state->stop(true, !state->active);
   }
+}
 
-  // unlock
-  pthread_mutex_unlock(&_lock);
+// removes an animation replaced in the index
+- (void)removeReplacedAnimation:(POPAnimation *)anim
+{
+  // remove from registries on the next frame, invalidating pending handles
+  [self _submitCommand:POPAnimatorCommand(kPOPAnimatorCommandRemove, NULL, anim)];
 
-  for (POPAnimation *anim in animations) {
-    POPAnimationState *state = POPAnimationGetState(anim);
-    state->stop(true, !state->active);
+  // stop animation and callout
+  POPAnimationState *state = POPAnimationGetState(anim);
+  if (state->active) {
+    traceAnimation(traceBuffer(self), kTraceEventStop, state);
   }
+  state->stop(true, (!state->active && !state->paused));
 }
 
-- (void)removeAnimationForObject:(id)obj key:(NSString *)key cleanupDict:(BOOL)cleanupDict
+- (void)removeAnimationForObject:(id)obj key:(NSString *)key
 {
-  POPAnimation *anim = deleteDictEntry(self, obj, key, cleanupDict);
+  if (!key) {
+    return;
+  }
+
+  POPAnimation *anim = nil;
+
+  // lock
+  pthread_mutex_lock(&_indexLock);
+
+  uint32_t keyId = _keys.find(key);
+  if (POPAnimatorKeyTable::kNotFound != keyId && _index.erase((__bridge void *)obj, keyId, &anim)) {
+    _keys.release(keyId);
+  }
+
+  // unlock
+  pthread_mutex_unlock(&_indexLock);
+
   if (nil == anim) {
     return;
   }
+  [self removeReplacedAnimation:anim];
+}
+
+- (NSArray *)animationKeysForObject:(id)obj
+{
+  NSMutableArray *keys = [NSMutableArray array];
 
   // lock
-  pthread_mutex_lock(&_lock);
+  pthread_mutex_lock(&_indexLock);
 
-  // remove from list
-  POPAnimatorItemRef item;
-  for (auto iter = _list.begin(); iter != _list.end();) {
-    item = *iter;
-    if(anim == item->animation) {
-      _list.erase(iter);
-      break;
-    } else {
-      iter++;
-    }
+  // get keys
+  POPAnimatorKeyTable &table = _keys;
+  _index.forEach((__bridge void *)obj, [keys, &table](uint32_t keyId, POPAnimation *anim) {
+    [keys addObject:table.name(keyId)];
+  });
+
+  // unlock
+  pthread_mutex_unlock(&_indexLock);
+  return 0 != keys.count ? keys : nil;
+}
+
+- (id)animationForObject:(id)obj key:(NSString *)key
+{
+  if (!key) {
+    return nil;
   }
 
-  // remove from pending list
-  for (auto iter = _pendingList.begin(); iter != _pendingList.end();) {
-    item = *iter;
-    if(anim == item->animation) {
-      _pendingList.erase(iter);
-      break;
-    } else {
-      iter++;
-    }
+  // lock
+  pthread_mutex_lock(&_indexLock);
+
+  // lookup animation
+  POPAnimation *animation = nil;
+  uint32_t keyId = _keys.find(key);
+  if (POPAnimatorKeyTable::kNotFound != keyId) {
+    POPAnimation * __strong *existing = _index.find((__bridge void *)obj, keyId);
+    animation = existing ? *existing : nil;
   }
 
+  // unlock
+  pthread_mutex_unlock(&_indexLock);
+  return animation;
+}
+
+- (NSUInteger)maxSolverStepsPerFrame
+{
+  // lock
+  pthread_mutex_lock(&_lock);
+
+  NSUInteger maxSteps = _maxSolverStepsPerFrame;
+
   // unlock
   pthread_mutex_unlock(&_lock);
+  return maxSteps;
+}
 
-  // stop animation and callout
-  POPAnimationState *state = POPAnimationGetState(anim);
-  state->stop(true, (!state->active && !state->paused));
+- (NSUInteger)concurrentComputeThreshold
+{
+  // lock
+  pthread_mutex_lock(&_lock);
+
+  NSUInteger threshold = _concurrentComputeThreshold;
+
+  // unlock
+  pthread_mutex_unlock(&_lock);
+  return threshold;
 }
 
-- (void)removeAnimationForObject:(id)obj key:(NSString *)key
+- (void)setConcurrentComputeThreshold:(NSUInteger)threshold
 {
-  [self removeAnimationForObject:obj key:key cleanupDict:YES];
+  // lock
+  pthread_mutex_lock(&_lock);
+  _concurrentComputeThreshold = threshold;
+  // unlock
+  pthread_mutex_unlock(&_lock);
 }
 
-- (NSArray *)animationKeysForObject:(id)obj
+- (void)setMaxSolverStepsPerFrame:(NSUInteger)maxSteps
 {
   // lock
   pthread_mutex_lock(&_lock);
 
-  // get keys
-  NSArray *keys = [(__bridge NSDictionary *)CFDictionaryGetValue(_dict, (__bridge void *)obj) allKeys];
+  _maxSolverStepsPerFrame = maxSteps;
+
+  // update running animations
+  for (POPAnimatorItem *item : _items[kPOPAnimationSpring]) {
+    updateMaxSolverSteps(item->state, maxSteps);
+  }
+  for (POPAnimatorItem *item : _parkedItems) {
+    updateMaxSolverSteps(item->state, maxSteps);
+  }
+  for (POPAnimatorItem *item : _waitingItems) {
+    updateMaxSolverSteps(item->state, maxSteps);
+  }
 
   // unlock
   pthread_mutex_unlock(&_lock);
-  return keys;
 }
 
-- (id)animationForObject:(id)obj key:(NSString *)key
+- (BOOL)metricsEnabled
+{
+  return _metricsEnabled;
+}
+
+- (void)setMetricsEnabled:(BOOL)enabled
+{
+  _metricsEnabled = enabled;
+}
+
+- (NSString *)metricsJSON
 {
   // lock
   pthread_mutex_lock(&_lock);
 
-  // lookup animation
-  NSDictionary *keyAnimationsDict = (__bridge id)CFDictionaryGetValue(_dict, (__bridge void *)obj);
-  POPAnimation *animation = keyAnimationsDict[key];
+  std::string json = _metrics.json();
 
   // unlock
   pthread_mutex_unlock(&_lock);
-  return animation;
+  return [NSString stringWithUTF8String:json.c_str()];
+}
+
+- (NSDictionary *)metrics
+{
+  NSData *data = [[self metricsJSON] dataUsingEncoding:NSUTF8StringEncoding];
+  return [NSJSONSerialization JSONObjectWithData:data options:0 error:NULL];
+}
+
+- (void)resetMetrics
+{
+  // lock
+  pthread_mutex_lock(&_lock);
+
+  _metrics.reset();
+
+  // unlock
+  pthread_mutex_unlock(&_lock);
+}
+
+- (NSUInteger)traceCapacity
+{
+  // lock
+  pthread_mutex_lock(&_lock);
+
+  TraceBuffer *trace = _trace.load(std::memory_order_relaxed);
+  NSUInteger capacity = NULL != trace ? trace->capacity() : 0;
+
+  // unlock
+  pthread_mutex_unlock(&_lock);
+  return capacity;
+}
+
+- (void)setTraceCapacity:(NSUInteger)capacity
+{
+  // lock
+  pthread_mutex_lock(&_lock);
+
+  if (0 == capacity) {
+    // stop, keeping events for export
+    _trace.store(NULL, std::memory_order_release);
+  } else if (!_traceBuffers.empty() && _traceBuffers.back()->capacity() == TraceBuffer::roundedCapacity(capacity)) {
+    _traceBuffers.back()->clear();
+    _trace.store(_traceBuffers.back().get(), std::memory_order_release);
+  } else {
+    // replaced buffers live until dealloc, as other threads may still record into them
+    _traceBuffers.emplace_back(new TraceBuffer(capacity));
+    _trace.store(_traceBuffers.back().get(), std::memory_order_release);
+  }
+
+  // unlock
+  pthread_mutex_unlock(&_lock);
+}
+
+- (NSString *)traceJSON
+{
+  static const char *names[] = {"spring", "decay", "basic", "custom"};
+  std::vector<TraceEvent> events;
+
+  // lock
+  pthread_mutex_lock(&_lock);
+
+  if (!_traceBuffers.empty()) {
+    _traceBuffers.back()->copyEvents(events);
+  }
+
+  // unlock
+  pthread_mutex_unlock(&_lock);
+
+  std::string json = chromeTraceJSON(events, names, sizeof(names) / sizeof(names[0]));
+  return [NSString stringWithUTF8String:json.c_str()];
 }
 
 - (CFTimeInterval)refreshPeriod
 {
+  if (nil != _frameSource) {
+    return 0;
+  }
+
 #if TARGET_OS_IPHONE
   return self->_displayLink.duration;
 #else
@@ -831,6 +2004,10 @@ static void stopAndCleanup(POPAnimator *self, POPAnimatorItemRef item, bool shou
 
 - (CFTimeInterval)_currentRenderTime
 {
+  if (nil != _frameSource) {
+    return _frameSource.currentTime;
+  }
+
   CFTimeInterval time = CACurrentMediaTime();
 
 #if TARGET_IPHONE_SIMULATOR
@@ -862,9 +2039,15 @@ static void stopAndCleanup(POPAnimator *self, POPAnimatorItemRef item, bool shou
   [self renderTime:time];
 }
 
+- (void)unparkAnimation:(POPAnimation *)anim
+{
+  // return to running items on the next frame
+  [self _submitCommand:POPAnimatorCommand(kPOPAnimatorCommandUnpark, NULL, anim)];
+}
+
 - (void)renderTime:(CFTimeInterval)time
 {
-  [self _renderTime:time items:_list];
+  [self _renderTime:time pending:NO];
 }
 
 - (void)addObserver:(id<POPAnimatorObserving>)observer
@@ -0,0 +1,161 @@
+/**
+ Copyright (c) 2014-present, Facebook, Inc.
+ All rights reserved.
+
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree. An additional grant
+ of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#ifndef __POP__FBAnimatorMetrics__
+#define __POP__FBAnimatorMetrics__
+
+#ifdef __cplusplus
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+
+namespace POP {
+
+  /**
+   Rolling metrics of rendered animator frames.
+   Frames are recorded into a fixed window of the most recent samples, so recording never allocates; percentiles
+   are computed over the window on query. Times are in seconds. Not thread safe. Plain C++, no platform
+   dependencies.
+   */
+  class AnimatorMetrics
+  {
+  public:
+    enum Phase
+    {
+      kPhaseTotal,
+      kPhaseCompute,  // solver and progress evaluation
+      kPhaseWrite,    // property writes
+      kPhaseCallback, // callouts and bookkeeping, the remainder of the total
+      kPhaseCount,
+    };
+
+    // Counters of one frame
+    struct Sample
+    {
+      double time[kPhaseCount];
+      size_t springCount;
+      size_t decayCount;
+      size_t basicCount;
+      size_t customCount;
+      size_t waitingCount;
+      size_t parkedCount;
+      size_t solverSteps;
+      size_t writes;
+      size_t skippedWrites;
+    };
+
+    // Frames kept for percentiles
+    static const size_t kWindow = 512;
+
+  private:
+    Sample _samples[kWindow];
+    size_t _frameCount;
+    size_t _solverSteps;
+    size_t _writes;
+    size_t _skippedWrites;
+
+    size_t windowCount() const { return std::min(_frameCount, kWindow); }
+
+    static void appendPhase(std::string &json, const char *name, const double values[4])
+    {
+      char buffer[160];
+      snprintf(buffer, sizeof(buffer), "\"%s\":{\"p50\":%.4f,\"p95\":%.4f,\"p99\":%.4f,\"max\":%.4f}", name, values[0] * 1e3, values[1] * 1e3, values[2] * 1e3, values[3] * 1e3);
+      json += buffer;
+    }
+
+  public:
+    AnimatorMetrics()
+    {
+      reset();
+    }
+
+    // Removes all recorded frames
+    void reset()
+    {
+      _frameCount = 0;
+      _solverSteps = 0;
+      _writes = 0;
+      _skippedWrites = 0;
+    }
+
+    // Records a frame, replacing the oldest of a full window
+    void record(const Sample &sample)
+    {
+      _samples[_frameCount % kWindow] = sample;
+      _frameCount++;
+      _solverSteps += sample.solverSteps;
+      _writes += sample.writes;
+      _skippedWrites += sample.skippedWrites;
+    }
+
+    // Frames recorded since the last reset
+    size_t frameCount() const { return _frameCount; }
+
+    // Totals since the last reset
+    size_t solverSteps() const { return _solverSteps; }
+    size_t writes() const { return _writes; }
+    size_t skippedWrites() const { return _skippedWrites; }
+
+    // The last recorded frame; frameCount must be positive
+    const Sample &lastSample() const { return _samples[(_frameCount - 1) % kWindow]; }
+
+    // Nearest rank percentile, in [0, 100], of a phase over the window; 0 without frames
+    double percentile(Phase phase, double p) const
+    {
+      size_t count = windowCount();
+      if (0 == count) {
+        return 0;
+      }
+
+      double values[kWindow];
+      for (size_t idx = 0; idx < count; idx++) {
+        values[idx] = _samples[idx].time[phase];
+      }
+      size_t rank = (size_t)std::max(std::ceil(p / 100. * count), 1.) - 1;
+      rank = std::min(rank, count - 1);
+      std::nth_element(values, values + rank, values + count);
+      return values[rank];
+    }
+
+    // Summary of the window and totals as JSON; times in milliseconds
+    std::string json() const
+    {
+      static const char *names[kPhaseCount] = {"total", "compute", "write", "callback"};
+
+      std::string json;
+      char buffer[512];
+      snprintf(buffer, sizeof(buffer), "{\"frames\":%zu,\"window\":%zu,\"solverSteps\":%zu,\"writes\":%zu,\"skippedWrites\":%zu,\"phases\":{", _frameCount, windowCount(), _solverSteps, _writes, _skippedWrites);
+      json += buffer;
+
+      for (size_t phase = 0; phase < kPhaseCount; phase++) {
+        double values[4] = {percentile((Phase)phase, 50), percentile((Phase)phase, 95), percentile((Phase)phase, 99), percentile((Phase)phase, 100)};
+        if (0 != phase) {
+          json += ",";
+        }
+        appendPhase(json, names[phase], values);
+      }
+      json += "}";
+
+      if (0 != _frameCount) {
+        const Sample &last = lastSample();
+        snprintf(buffer, sizeof(buffer), ",\"last\":{\"springs\":%zu,\"decays\":%zu,\"basics\":%zu,\"customs\":%zu,\"waiting\":%zu,\"parked\":%zu,\"solverSteps\":%zu,\"writes\":%zu,\"skippedWrites\":%zu}", last.springCount, last.decayCount, last.basicCount, last.customCount, last.waitingCount, last.parkedCount, last.solverSteps, last.writes, last.skippedWrites);
+        json += buffer;
+      }
+      json += "}";
+      return json;
+    }
+  };
+
+}
+
+#endif /* __cplusplus */
+#endif /* defined(__POP__FBAnimatorMetrics__) */
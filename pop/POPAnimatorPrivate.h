@@ -61,6 +61,11 @@
 - (NSArray *)animationKeysForObject:(id)obj;
 - (POPAnimation *)animationForObject:(id)obj key:(NSString *)key;
 
+/**
+ Returns a parked animation to the running animations. Called when a paused, active animation unpauses.
+ */
+- (void)unparkAnimation:(POPAnimation *)anim;
+
 /**
  @abstract Add an animator observer. Observer will be notified of each subsequent animator advance until removal.
  */
@@ -0,0 +1,97 @@
+/**
+ Copyright (c) 2014-present, Facebook, Inc.
+ All rights reserved.
+
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree. An additional grant
+ of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#ifndef __POP__FBCommandQueue__
+#define __POP__FBCommandQueue__
+
+#ifdef __cplusplus
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace POP {
+
+  /**
+   Lock-free multiple producer, single consumer FIFO queue.
+   Producers push onto an atomic stack; the consumer takes the whole stack with one exchange and reverses it
+   into a private list, so consumers never contend with producers per value and no ABA arises. Values pushed
+   by one thread are popped in push order. Plain C++, no platform dependencies.
+   */
+  template <typename T>
+  class CommandQueue
+  {
+    struct Node
+    {
+      T value;
+      Node *next;
+
+      Node(T v) : value(std::move(v)), next(NULL) {}
+    };
+
+    std::atomic<Node *> _head;  // most recently pushed first
+    Node *_front;               // consumer owned, oldest first
+
+    CommandQueue(const CommandQueue &) = delete;
+    CommandQueue &operator=(const CommandQueue &) = delete;
+
+  public:
+    CommandQueue() : _head(NULL), _front(NULL) {}
+
+    ~CommandQueue()
+    {
+      T value;
+      while (pop(value)) {
+      }
+    }
+
+    // Adds a value; any thread
+    void push(T value)
+    {
+      Node *node = new Node(std::move(value));
+      node->next = _head.load(std::memory_order_relaxed);
+      while (!_head.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)) {
+      }
+    }
+
+    // Removes the oldest value into value, returning false when empty; consumer only
+    bool pop(T &value)
+    {
+      if (NULL == _front) {
+        // take pushed values, reversing into push order
+        Node *node = _head.exchange(NULL, std::memory_order_acquire);
+        while (NULL != node) {
+          Node *next = node->next;
+          node->next = _front;
+          _front = node;
+          node = next;
+        }
+        if (NULL == _front) {
+          return false;
+        }
+      }
+
+      Node *node = _front;
+      _front = node->next;
+      value = std::move(node->value);
+      delete node;
+      return true;
+    }
+
+    // Returns whether no values are queued; consumer only
+    bool empty() const
+    {
+      return NULL == _front && NULL == _head.load(std::memory_order_acquire);
+    }
+  };
+
+}
+
+#endif /* __cplusplus */
+#endif /* defined(__POP__FBCommandQueue__) */
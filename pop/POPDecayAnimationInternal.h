@@ -11,6 +11,7 @@
 
 #import <cmath>
 
+#import "POPDecaySolver.h"
 #import "POPPropertyAnimationInternal.h"
 
 // minimal velocity factor before decay animation is considered complete, in units / s
@@ -19,27 +20,6 @@ static CGFloat kPOPAnimationDecayMinimalVelocityFactor = 5.;
 // default decay animation deceleration
 static CGFloat kPOPAnimationDecayDecelerationDefault = 0.998;
 
-static void decay_position(CGFloat *x, CGFloat *v, NSUInteger count, CFTimeInterval dt, CGFloat deceleration)
-{
-  dt *= 1000;
-
-  // v0 = v / 1000
-  // v = v0 * powf(deceleration, dt);
-  // v = v * 1000;
-
-  // x0 = x;
-  // x = x0 + v0 * deceleration * (1 - powf(deceleration, dt)) / (1 - deceleration)
-  float v0[count];
-  float kv = powf(deceleration, dt);
-  float kx = deceleration * (1 - kv) / (1 - deceleration);
-
-  for (NSUInteger idx = 0; idx < count; idx++) {
-    v0[idx] = v[idx] / 1000.;
-    v[idx] = v0[idx] * kv * 1000.;
-    x[idx] = x[idx] + v0[idx] * kx;
-  }
-}
-
 struct _POPDecayAnimationState : _POPPropertyAnimationState
 {
   double deceleration;
@@ -91,7 +71,7 @@ struct _POPDecayAnimationState : _POPPropertyAnimationState
     // to value assuming final velocity as a factor of dynamics threshold
     // derived from v' = v * d^dt used in decay_position
     // to compute the to value with maximal dt, p' = p + (v * d) / (1 - d)
-    VectorRef fromValue = NULL != currentVec ? currentVec : fromVec;
+    const VectorRef &fromValue = NULL != currentVec ? currentVec : fromVec;
     if (!fromValue) {
       return;
     }
@@ -0,0 +1,65 @@
+/**
+ Copyright (c) 2014-present, Facebook, Inc.
+ All rights reserved.
+
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree. An additional grant
+ of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#ifndef __POP__FBDecaySolver__
+#define __POP__FBDecaySolver__
+
+#ifdef __cplusplus
+
+#import <Foundation/Foundation.h>
+
+#import <cmath>
+
+// decays count components, or N components when N is non-zero
+template <NSUInteger N>
+static void decay_position(CGFloat *x, CGFloat *v, NSUInteger count, CFTimeInterval dt, CGFloat deceleration)
+{
+  dt *= 1000;
+
+  // v0 = v / 1000
+  // v = v0 * powf(deceleration, dt);
+  // v = v * 1000;
+
+  // x0 = x;
+  // x = x0 + v0 * deceleration * (1 - powf(deceleration, dt)) / (1 - deceleration)
+  float kv = powf(deceleration, dt);
+  float kx = deceleration * (1 - kv) / (1 - deceleration);
+
+  const NSUInteger n = 0 != N ? N : count;
+  for (NSUInteger idx = 0; idx < n; idx++) {
+    float v0 = v[idx] / 1000.;
+    v[idx] = v0 * kv * 1000.;
+    x[idx] = x[idx] + v0 * kx;
+  }
+}
+
+inline void decay_position(CGFloat *x, CGFloat *v, NSUInteger count, CFTimeInterval dt, CGFloat deceleration)
+{
+  // specialize common value counts, unrolling the component loop
+  switch (count) {
+    case 1:
+      decay_position<1>(x, v, count, dt, deceleration);
+      break;
+    case 2:
+      decay_position<2>(x, v, count, dt, deceleration);
+      break;
+    case 3:
+      decay_position<3>(x, v, count, dt, deceleration);
+      break;
+    case 4:
+      decay_position<4>(x, v, count, dt, deceleration);
+      break;
+    default:
+      decay_position<0>(x, v, count, dt, deceleration);
+      break;
+  }
+}
+
+#endif /* __cplusplus */
+#endif /* defined(__POP__FBDecaySolver__) */
@@ -0,0 +1,70 @@
+/**
+ Copyright (c) 2014-present, Facebook, Inc.
+ All rights reserved.
+
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree. An additional grant
+ of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <Foundation/Foundation.h>
+
+@class POPAnimator;
+
+/**
+ @abstract A source of frames and time driving an animator.
+ @discussion An animator created with a frame source reads time from it and starts or stops it in place of a display link. Sources deliver frames by calling -render on their animator.
+ */
+@protocol POPFrameSource <NSObject>
+
+/**
+ @abstract The animator receiving frames. Set by the animator on initialization.
+ */
+@property (weak, nonatomic) POPAnimator *animator;
+
+/**
+ @abstract The current time in seconds, in the time base of animation begin times.
+ */
+@property (readonly, nonatomic) CFTimeInterval currentTime;
+
+/**
+ @abstract Whether frame delivery is stopped.
+ @discussion Set by the animator as animations start and finish, possibly with the animator locked. Sources must not render from within the setter.
+ */
+@property (assign, nonatomic, getter=isPaused) BOOL paused;
+
+/**
+ @abstract Requests a single frame at the specified time while paused, replacing any previous request.
+ @discussion Used to start delayed animations without running frames until then. A time of 0 cancels the request. Called under the same conditions as the paused setter.
+ */
+- (void)requestFrameAtTime:(CFTimeInterval)time;
+
+@end
+
+/**
+ @abstract A frame source of virtual time, for deterministic simulation.
+ @discussion Time advances only when told to. Frames are rendered synchronously on the calling thread at a fixed interval while running; while paused, time skips ahead to requested frames.
+ */
+@interface POPVirtualFrameSource : NSObject <POPFrameSource>
+
+/**
+ @abstract Initializes a frame source at the specified time, rendering frames at the specified interval in seconds.
+ */
+- (instancetype)initWithTime:(CFTimeInterval)time frameInterval:(CFTimeInterval)frameInterval;
+
+/**
+ @abstract The interval between frames, in seconds.
+ */
+@property (readonly, nonatomic) CFTimeInterval frameInterval;
+
+/**
+ @abstract The number of frames rendered.
+ */
+@property (readonly, nonatomic) NSUInteger frameCount;
+
+/**
+ @abstract Advances time by the specified duration in seconds, rendering the frames due meanwhile.
+ */
+- (void)advanceTime:(CFTimeInterval)duration;
+
+@end
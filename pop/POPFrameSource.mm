@@ -0,0 +1,84 @@
+/**
+ Copyright (c) 2014-present, Facebook, Inc.
+ All rights reserved.
+
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree. An additional grant
+ of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "POPFrameSource.h"
+
+#import <cmath>
+
+#import "POPAnimator.h"
+
+@implementation POPVirtualFrameSource
+{
+  CFTimeInterval _currentTime;
+  CFTimeInterval _requestedTime;
+}
+@synthesize animator = _animator;
+@synthesize paused = _paused;
+
+- (instancetype)init
+{
+  return [self initWithTime:0 frameInterval:1/60.];
+}
+
+- (instancetype)initWithTime:(CFTimeInterval)time frameInterval:(CFTimeInterval)frameInterval
+{
+  NSAssert(frameInterval > 0, @"invalid frame interval:%f", frameInterval);
+  self = [super init];
+  if (nil == self) return nil;
+
+  _currentTime = time;
+  _frameInterval = frameInterval;
+  _paused = YES;
+  return self;
+}
+
+- (CFTimeInterval)currentTime
+{
+  return _currentTime;
+}
+
+- (void)requestFrameAtTime:(CFTimeInterval)time
+{
+  _requestedTime = time;
+}
+
+- (void)advanceTime:(CFTimeInterval)duration
+{
+  const CFTimeInterval endTime = _currentTime + duration;
+
+  // tolerate accumulated rounding of frame times
+  const CFTimeInterval tolerance = _frameInterval * 1e-6;
+
+  for (;;) {
+    CFTimeInterval time = _currentTime + _frameInterval;
+    if (_paused) {
+      if (0 == _requestedTime) {
+        break;
+      }
+
+      // skip to the first frame at or after the requested time
+      CFTimeInterval frames = MAX(std::ceil((_requestedTime - _currentTime) / _frameInterval - 1e-6), 1.);
+      time = _currentTime + frames * _frameInterval;
+    }
+
+    if (time > endTime + tolerance) {
+      break;
+    }
+
+    // the animator requests again while still sleeping
+    _requestedTime = 0;
+    _currentTime = time;
+    _frameCount++;
+    [_animator render];
+  }
+
+  _currentTime = endTime;
+}
+
+@end
@@ -0,0 +1,75 @@
+/**
+ Copyright (c) 2014-present, Facebook, Inc.
+ All rights reserved.
+
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree. An additional grant
+ of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#ifndef __POP__FBKeyframeTrack__
+#define __POP__FBKeyframeTrack__
+
+#ifdef __cplusplus
+
+#import <Foundation/Foundation.h>
+
+#import <vector>
+
+namespace POP {
+
+  /**
+   Keyframes of count component values at increasing times, evaluated by linear interpolation.
+   Values are stored contiguously, count per keyframe.
+   */
+  struct KeyframeTrack
+  {
+    NSUInteger count;
+    std::vector<CFTimeInterval> times;
+    std::vector<CGFloat> values;
+
+    KeyframeTrack(NSUInteger c = 0) : count(c) {}
+
+    // Number of keyframes
+    size_t size() const { return times.size(); }
+
+    // Values of keyframe idx
+    const CGFloat *value(size_t idx) const { return &values[idx * count]; }
+
+    // Appends a keyframe, times must increase
+    void append(CFTimeInterval time, const CGFloat *value);
+
+    // Interpolates the values at time into out, clamping to the first and last keyframes
+    void evaluate(CFTimeInterval time, CGFloat *out) const;
+
+    /**
+     Removes keyframes while every removed keyframe stays within maxError of the interpolation between the
+     keyframes kept around it, in each component. Keeps the first and last keyframes, and every keyframe when
+     maxError is zero or less.
+     */
+    void reduce(CGFloat maxError);
+  };
+
+  /**
+   Bakes a spring from from to to with initial velocity, sampled at rate samples per second until the spring
+   converges within threshold, as POPSpringAnimation advances it. The last keyframe holds to.
+   Returns a track reduced to maxError.
+   */
+  KeyframeTrack bake_spring(NSUInteger count, const CGFloat *from, const CGFloat *to, const CGFloat *velocity, double tension, double friction, double mass, double threshold, double rate, CGFloat maxError);
+
+  /**
+   Bakes a decay from from with initial velocity over duration, sampled at rate samples per second, as
+   POPDecayAnimation advances it. Returns a track reduced to maxError.
+   */
+  KeyframeTrack bake_decay(NSUInteger count, const CGFloat *from, const CGFloat *velocity, double deceleration, CFTimeInterval duration, double rate, CGFloat maxError);
+
+  /**
+   Bakes a timing function curve from from to to over duration, sampled at rate samples per second, as
+   POPBasicAnimation advances it. Control points are x1, y1, x2, y2. Returns a track reduced to maxError.
+   */
+  KeyframeTrack bake_basic(NSUInteger count, const CGFloat *from, const CGFloat *to, const double controlPoints[4], CFTimeInterval duration, double rate, CGFloat maxError);
+
+}
+
+#endif /* __cplusplus */
+#endif /* defined(__POP__FBKeyframeTrack__) */
@@ -0,0 +1,200 @@
+/**
+ Copyright (c) 2014-present, Facebook, Inc.
+ All rights reserved.
+
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree. An additional grant
+ of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "POPKeyframeTrack.h"
+
+#import <algorithm>
+#import <cmath>
+#import <utility>
+
+#import "POPDecaySolver.h"
+#import "POPMath.h"
+#import "POPSpringSolver.h"
+#import "WebCore/UnitBezier.h"
+
+// upper bound of baked time, guarding against springs that never converge
+static const CFTimeInterval kPOPKeyframeTrackMaxDuration = 60.;
+
+namespace POP
+{
+
+  void KeyframeTrack::append(CFTimeInterval time, const CGFloat *value)
+  {
+    times.push_back(time);
+    values.insert(values.end(), value, value + count);
+  }
+
+  void KeyframeTrack::evaluate(CFTimeInterval time, CGFloat *out) const
+  {
+    if (times.empty()) {
+      return;
+    }
+
+    size_t upper = std::upper_bound(times.begin(), times.end(), time) - times.begin();
+    if (0 == upper || times.size() == upper) {
+      const CGFloat *v = value(0 == upper ? 0 : upper - 1);
+      std::copy(v, v + count, out);
+      return;
+    }
+
+    size_t lower = upper - 1;
+    double f = (time - times[lower]) / (times[upper] - times[lower]);
+    const CGFloat *a = value(lower), *b = value(upper);
+    for (NSUInteger idx = 0; idx < count; idx++) {
+      out[idx] = MIX(a[idx], b[idx], f);
+    }
+  }
+
+  void KeyframeTrack::reduce(CGFloat maxError)
+  {
+    size_t n = size();
+    if (n < 3 || maxError <= 0) {
+      return;
+    }
+
+    // Ramer-Douglas-Peucker over time, splitting spans at the keyframe of largest deviation
+    std::vector<bool> keep(n, false);
+    keep[0] = keep[n - 1] = true;
+
+    std::vector<std::pair<size_t, size_t>> spans;
+    spans.push_back(std::make_pair((size_t)0, n - 1));
+
+    while (!spans.empty()) {
+      std::pair<size_t, size_t> span = spans.back();
+      spans.pop_back();
+
+      const CGFloat *a = value(span.first), *b = value(span.second);
+      double t0 = times[span.first], dt = times[span.second] - t0;
+
+      size_t split = 0;
+      CGFloat maxDeviation = 0;
+      for (size_t k = span.first + 1; k < span.second; k++) {
+        double f = (times[k] - t0) / dt;
+        const CGFloat *v = value(k);
+        for (NSUInteger idx = 0; idx < count; idx++) {
+          CGFloat deviation = fabs(v[idx] - MIX(a[idx], b[idx], f));
+          if (deviation > maxDeviation) {
+            maxDeviation = deviation;
+            split = k;
+          }
+        }
+      }
+
+      if (maxDeviation > maxError) {
+        keep[split] = true;
+        spans.push_back(std::make_pair(span.first, split));
+        spans.push_back(std::make_pair(split, span.second));
+      }
+    }
+
+    // compact kept keyframes in place
+    size_t kept = 0;
+    for (size_t k = 0; k < n; k++) {
+      if (keep[k]) {
+        times[kept] = times[k];
+        std::copy(value(k), value(k) + count, values.begin() + kept * count);
+        kept++;
+      }
+    }
+    times.resize(kept);
+    values.resize(kept * count);
+  }
+
+  KeyframeTrack bake_spring(NSUInteger count, const CGFloat *from, const CGFloat *to, const CGFloat *velocity, double tension, double friction, double mass, double threshold, double rate, CGFloat maxError)
+  {
+    KeyframeTrack track(count);
+    NSUInteger n = MIN(count, (NSUInteger)4);
+
+    SpringSolver4d solver(tension, friction, mass);
+    solver.setThreshold(threshold);
+
+    // solver state relative to the to value, velocity flipped to solver perspective
+    SSState4d state;
+    state.p = state.v = Vector4d::Zero();
+    for (NSUInteger idx = 0; idx < n; idx++) {
+      state.p(idx) = to[idx] - from[idx];
+      state.v(idx) = velocity ? -velocity[idx] : 0;
+    }
+
+    std::vector<CGFloat> value(from, from + count);
+    track.append(0, value.data());
+
+    const double dt = 1. / rate;
+    CFTimeInterval time = 0;
+    while (time < kPOPKeyframeTrackMaxDuration) {
+      solver.advance(state, time, dt);
+      time += dt;
+
+      if (solver.hasConverged()) {
+        break;
+      }
+
+      for (NSUInteger idx = 0; idx < n; idx++) {
+        value[idx] = to[idx] - state.p(idx);
+      }
+      track.append(time, value.data());
+    }
+
+    // converged springs snap to the to value, as does the last sample of springs stopped by the time bound
+    if (track.size() > 1 && track.times.back() == time) {
+      std::copy(to, to + count, track.values.end() - count);
+    } else {
+      track.append(time, to);
+    }
+    track.reduce(maxError);
+    return track;
+  }
+
+  KeyframeTrack bake_decay(NSUInteger count, const CGFloat *from, const CGFloat *velocity, double deceleration, CFTimeInterval duration, double rate, CGFloat maxError)
+  {
+    KeyframeTrack track(count);
+
+    std::vector<CGFloat> value(from, from + count);
+    std::vector<CGFloat> v(velocity, velocity + count);
+    track.append(0, value.data());
+
+    const double dt = 1. / rate;
+    CFTimeInterval time = 0;
+    duration = MIN(duration, kPOPKeyframeTrackMaxDuration);
+    while (time < duration) {
+      CFTimeInterval step = MIN(dt, duration - time);
+      decay_position(value.data(), v.data(), count, step, deceleration);
+      time += step;
+      track.append(time, value.data());
+    }
+
+    track.reduce(maxError);
+    return track;
+  }
+
+  KeyframeTrack bake_basic(NSUInteger count, const CGFloat *from, const CGFloat *to, const double controlPoints[4], CFTimeInterval duration, double rate, CGFloat maxError)
+  {
+    KeyframeTrack track(count);
+    track.append(0, from);
+
+    if (duration > 0) {
+      WebCore::UnitBezier bezier(controlPoints[0], controlPoints[1], controlPoints[2], controlPoints[3]);
+      std::vector<CGFloat> value(count);
+
+      const double dt = 1. / rate;
+      for (CFTimeInterval time = dt; time < duration; time += dt) {
+        double p = bezier.solve(time / duration, SOLVE_EPS(duration));
+        for (NSUInteger idx = 0; idx < count; idx++) {
+          value[idx] = MIX(from[idx], to[idx], p);
+        }
+        track.append(time, value.data());
+      }
+    }
+
+    track.append(MAX(duration, 0.), to);
+    track.reduce(maxError);
+    return track;
+  }
+
+}
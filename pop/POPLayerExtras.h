@@ -13,6 +13,26 @@
 
 POP_EXTERN_C_BEGIN
 
+#pragma mark - Batching
+
+/**
+ @abstract Begins batching transform and sublayer transform component writes on the calling thread.
+ @discussion Until the matching end, the setters below accumulate into a cached decomposition of each layer transform, and the getters read from it, so that setting several components of one layer decomposes and recomposes it once. Batches nest; the animator batches each frame it renders.
+ */
+extern void POPLayerBeginTransformBatch(void);
+
+/**
+ @abstract Ends a batch, writing each changed layer transform once when ending the outermost batch.
+ @discussion A transform set directly on a layer meanwhile wins over components batched before it; components batched after it are applied over it.
+ */
+extern void POPLayerEndTransformBatch(void);
+
+/**
+ @abstract Writes each changed layer transform of the current batch now, leaving the batch open.
+ @discussion The animator flushes before calling out to animation delegates and blocks, which thereby read and set current layer transforms.
+ */
+extern void POPLayerFlushTransformBatch(void);
+
 #pragma mark - Scale
 
 /**
@@ -9,31 +9,225 @@
 
 #import "POPLayerExtras.h"
 
+#import <pthread.h>
+#import <vector>
+
+#include "POPAnimationIndex.h"
 #include "TransformationMatrix.h"
 
+using namespace POP;
 using namespace WebCore;
 
+typedef TransformationMatrix::DecomposedType POPLayerDecomposedTransform;
+
+static const size_t kPOPLayerDecomposedFieldCount = sizeof(POPLayerDecomposedTransform) / sizeof(double);
+static_assert(kPOPLayerDecomposedFieldCount <= 32, "written fields exceed the dirty mask");
+
+enum POPLayerTransformKind
+{
+  kPOPLayerTransform,
+  kPOPLayerSublayerTransform,
+};
+
+/**
+ Decomposed transform of a layer within a batch, written back once as the batch ends.
+ */
+struct POPLayerTransformEntry
+{
+  CALayer *layer;
+  POPLayerTransformKind kind;
+  CATransform3D base;                     // transform decomposed from
+  POPLayerDecomposedTransform decomposed;
+  uint32_t dirty;                         // written fields, by index
+  bool euler;                             // recompose from euler angles, once rotation is written
+};
+
+/**
+ Transform writes of one thread, batched while depth is positive.
+ */
+struct POPLayerTransformBatch
+{
+  NSUInteger depth;
+  std::vector<POPLayerTransformEntry> entries;
+  AnimationIndex<size_t> index;           // entry of each layer and kind
+
+  POPLayerTransformBatch() : depth(0) {}
+};
+
+static pthread_key_t _batchKey;
+
+static void destroyBatch(void *batch)
+{
+  delete static_cast<POPLayerTransformBatch *>(batch);
+}
+
+static POPLayerTransformBatch *currentBatch(bool create)
+{
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    pthread_key_create(&_batchKey, destroyBatch);
+  });
+
+  POPLayerTransformBatch *batch = static_cast<POPLayerTransformBatch *>(pthread_getspecific(_batchKey));
+  if (NULL == batch && create) {
+    batch = new POPLayerTransformBatch();
+    pthread_setspecific(_batchKey, batch);
+  }
+  return batch;
+}
+
+NS_INLINE CATransform3D layerTransform(CALayer *l, POPLayerTransformKind kind)
+{
+  return kPOPLayerTransform == kind ? l.transform : l.sublayerTransform;
+}
+
+NS_INLINE void setLayerTransform(CALayer *l, POPLayerTransformKind kind, const CATransform3D &t)
+{
+  if (kPOPLayerTransform == kind) {
+    l.transform = t;
+  } else {
+    l.sublayerTransform = t;
+  }
+}
+
+// starts the entry from the transform as set outside the batch, which wins over earlier batched writes
+static void rebaseEntry(POPLayerTransformEntry &entry, const CATransform3D &current)
+{
+  TransformationMatrix(current).decompose(entry.decomposed);
+  entry.base = current;
+  entry.dirty = 0;
+  entry.euler = false;
+}
+
+// entry of the layer transform in the current batch, or NULL when not batching
+static POPLayerTransformEntry *batchEntry(CALayer *l, POPLayerTransformKind kind)
+{
+  POPLayerTransformBatch *batch = currentBatch(false);
+  if (NULL == batch || 0 == batch->depth) {
+    return NULL;
+  }
+
+  CATransform3D current = layerTransform(l, kind);
+  size_t *existing = batch->index.find((__bridge void *)l, kind);
+  if (NULL != existing) {
+    POPLayerTransformEntry &entry = batch->entries[*existing];
+    if (!CATransform3DEqualToTransform(current, entry.base)) {
+      rebaseEntry(entry, current);
+    }
+    return &entry;
+  }
+
+  POPLayerTransformEntry entry;
+  entry.layer = l;
+  entry.kind = kind;
+  rebaseEntry(entry, current);
+
+  batch->index.insert((__bridge void *)l, kind, batch->entries.size());
+  batch->entries.push_back(entry);
+  return &batch->entries.back();
+}
+
+/**
+ Decomposed transform of a layer. Read from and written to the batch of the calling thread while batching,
+ otherwise decomposed from and recomposed into the layer.
+ */
+struct POPLayerDecomposition : POPLayerDecomposedTransform
+{
+  CALayer *layer;
+  POPLayerTransformKind kind;
+  POPLayerTransformEntry *entry;
+
+  POPLayerDecomposition(CALayer *l, POPLayerTransformKind k) : layer(l), kind(k), entry(batchEntry(l, k))
+  {
+    if (NULL != entry) {
+      *static_cast<POPLayerDecomposedTransform *>(this) = entry->decomposed;
+    } else {
+      TransformationMatrix(layerTransform(l, k)).decompose(*this);
+    }
+  }
+
+  void write(bool useEulerAngle)
+  {
+    if (NULL == entry) {
+      TransformationMatrix m;
+      m.recompose(*this, useEulerAngle);
+      setLayerTransform(layer, kind, m.transform3d());
+      return;
+    }
+
+    // mark changed fields, written as the batch ends
+    const double *fields = (const double *)static_cast<POPLayerDecomposedTransform *>(this);
+    const double *previous = (const double *)&entry->decomposed;
+    for (size_t idx = 0; idx < kPOPLayerDecomposedFieldCount; idx++) {
+      if (fields[idx] != previous[idx]) {
+        entry->dirty |= (1u << idx);
+      }
+    }
+    entry->decomposed = *this;
+    entry->euler = entry->euler || useEulerAngle;
+  }
+};
+
 #define DECOMPOSE_TRANSFORM(L) \
-  TransformationMatrix _m(L.transform); \
-  TransformationMatrix::DecomposedType _d; \
-  _m.decompose(_d);
+  POPLayerDecomposition _d(L, kPOPLayerTransform);
 
 #define RECOMPOSE_TRANSFORM(L) \
-  _m.recompose(_d); \
-  L.transform = _m.transform3d();
+  _d.write(false);
 
 #define RECOMPOSE_ROT_TRANSFORM(L) \
-  _m.recompose(_d, true); \
-  L.transform = _m.transform3d();
+  _d.write(true);
 
 #define DECOMPOSE_SUBLAYER_TRANSFORM(L) \
-  TransformationMatrix _m(L.sublayerTransform); \
-  TransformationMatrix::DecomposedType _d; \
-  _m.decompose(_d);
+  POPLayerDecomposition _d(L, kPOPLayerSublayerTransform);
 
 #define RECOMPOSE_SUBLAYER_TRANSFORM(L) \
-  _m.recompose(_d); \
-  L.sublayerTransform = _m.transform3d();
+  _d.write(false);
+
+#pragma mark - Batching
+
+void POPLayerBeginTransformBatch(void)
+{
+  currentBatch(true)->depth++;
+}
+
+// writes each changed layer transform once, emptying the batch
+static void flushBatch(POPLayerTransformBatch *batch)
+{
+  for (POPLayerTransformEntry &entry : batch->entries) {
+    if (0 == entry.dirty) {
+      continue;
+    }
+    // transforms set directly after the last batched write are kept
+    if (!CATransform3DEqualToTransform(layerTransform(entry.layer, entry.kind), entry.base)) {
+      continue;
+    }
+    TransformationMatrix m;
+    m.recompose(entry.decomposed, entry.euler);
+    setLayerTransform(entry.layer, entry.kind, m.transform3d());
+  }
+  batch->entries.clear();
+  batch->index.clear();
+}
+
+void POPLayerFlushTransformBatch(void)
+{
+  POPLayerTransformBatch *batch = currentBatch(false);
+  if (NULL != batch && !batch->entries.empty()) {
+    flushBatch(batch);
+  }
+}
+
+void POPLayerEndTransformBatch(void)
+{
+  POPLayerTransformBatch *batch = currentBatch(false);
+  NSCAssert(NULL != batch && 0 != batch->depth, @"unbalanced transform batch");
+  if (NULL == batch || 0 == batch->depth || 0 != --batch->depth) {
+    return;
+  }
+
+  // one recompose and write per layer transform
+  flushBatch(batch);
+}
 
 #pragma mark - Scale
 
@@ -0,0 +1,136 @@
+/**
+ Copyright (c) 2014-present, Facebook, Inc.
+ All rights reserved.
+
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree. An additional grant
+ of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#ifndef __POP__FBPerfectHash__
+#define __POP__FBPerfectHash__
+
+#ifdef __cplusplus
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace POP {
+
+  /**
+   Perfect hash over a fixed set of key hashes, built by hash and displace.
+   Keys are grouped into buckets by hash. Each bucket, largest first, takes the first displacement that mixes all
+   of its hashes into free slots of a power of two table at most half full. A lookup reads one displacement and one
+   slot, yielding the index of the only key that can match; absent keys land on some slot too, so callers compare
+   the key itself. Plain C++, no platform dependencies.
+   */
+  class PerfectHash
+  {
+    std::vector<uint32_t> _displacements; // per bucket, 0 when the bucket is empty
+    std::vector<uint32_t> _slots;         // key index per slot
+    size_t _bucketMask;
+    size_t _slotMask;
+
+    static uint64_t mix(uint64_t h, uint64_t d)
+    {
+      h ^= d * 0x9E3779B97F4A7C15ull;
+      h ^= h >> 33;
+      h *= 0xFF51AFD7ED558CCDull;
+      h ^= h >> 33;
+      return h;
+    }
+
+    size_t bucket(uint64_t h) const
+    {
+      return (size_t)(mix(h, 0) >> 32) & _bucketMask;
+    }
+
+  public:
+    static const uint32_t kNotFound = UINT32_MAX;
+
+    PerfectHash() : _bucketMask(0), _slotMask(0) {}
+
+    /**
+     Builds the table over count key hashes. Returns false, leaving the table empty, when two keys have equal
+     hashes or no displacement separates a bucket.
+     */
+    bool build(const uint64_t *hashes, uint32_t count)
+    {
+      _displacements.clear();
+      _slots.clear();
+
+      size_t slotCount = 2;
+      while (slotCount < 2 * (size_t)count) {
+        slotCount *= 2;
+      }
+      _slotMask = slotCount - 1;
+      _bucketMask = std::max<size_t>(slotCount / 4, 1) - 1;
+
+      std::vector<std::vector<uint32_t>> buckets(_bucketMask + 1);
+      for (uint32_t idx = 0; idx < count; idx++) {
+        buckets[bucket(hashes[idx])].push_back(idx);
+      }
+      std::vector<size_t> order(buckets.size());
+      for (size_t b = 0; b < order.size(); b++) {
+        order[b] = b;
+      }
+      std::stable_sort(order.begin(), order.end(), [&buckets](size_t b1, size_t b2) {
+        return buckets[b1].size() > buckets[b2].size();
+      });
+
+      std::vector<uint32_t> displacements(buckets.size(), 0);
+      std::vector<uint32_t> slots(slotCount, kNotFound);
+      std::vector<size_t> placed;
+      for (size_t b : order) {
+        const std::vector<uint32_t> &keys = buckets[b];
+        if (keys.empty()) {
+          break;
+        }
+
+        uint32_t d = 1;
+        for (; d <= 64 * slotCount; d++) {
+          placed.clear();
+          for (uint32_t key : keys) {
+            size_t s = (size_t)mix(hashes[key], d) & _slotMask;
+            if (kNotFound != slots[s]) {
+              break;
+            }
+            slots[s] = key;
+            placed.push_back(s);
+          }
+          if (placed.size() == keys.size()) {
+            break;
+          }
+          // undo a partial placement
+          for (size_t s : placed) {
+            slots[s] = kNotFound;
+          }
+        }
+        if (placed.size() != keys.size()) {
+          return false;
+        }
+        displacements[b] = d;
+      }
+
+      _displacements.swap(displacements);
+      _slots.swap(slots);
+      return true;
+    }
+
+    // Returns the index of the only key that can have the hash, or kNotFound
+    uint32_t find(uint64_t h) const
+    {
+      if (_slots.empty()) {
+        return kNotFound;
+      }
+      uint32_t d = _displacements[bucket(h)];
+      return 0 == d ? kNotFound : _slots[(size_t)mix(h, d) & _slotMask];
+    }
+  };
+
+}
+
+#endif /* __cplusplus */
+#endif /* defined(__POP__FBPerfectHash__) */
@@ -9,6 +9,8 @@
 
 #import "POPPropertyAnimationInternal.h"
 
+#import "POPAnimatablePropertyInternal.h"
+
 @implementation POPPropertyAnimation
 
 #pragma mark - Lifecycle
@@ -131,7 +133,7 @@ DEFINE_RW_PROPERTY_OBJ_COPY(POPPropertyAnimationState, progressMarkers, setProgr
                                       writeBlock:(POPAnimatablePropertyWriteBlock)writeBlock
 {
   POPPropertyAnimation *animation = [[self alloc] init];
-  animation.property = [POPAnimatableProperty propertyWithName:name initializer:^(POPMutableAnimatableProperty *prop) {
+  animation.property = [POPAnimatableProperty uncachedPropertyWithName:name initializer:^(POPMutableAnimatableProperty *prop) {
     prop.readBlock = readBlock;
     prop.writeBlock = writeBlock;
   }];
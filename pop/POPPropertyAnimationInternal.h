@@ -107,7 +107,7 @@ struct _POPPropertyAnimationState : _POPAnimationState
 
   // returns a copy of the currentVec, rounding if needed
   VectorRef currentValue() {
-    VectorRef vec = VectorRef(Vector::new_vector(currentVec.get()));
+    VectorRef vec = currentVec;
     if (shouldRound()) {
       vec->subRound(1 / roundingFactor);
     }
@@ -303,7 +303,7 @@ struct _POPPropertyAnimationState : _POPAnimationState
     if (NULL == distanceVec) {
 
       // not yet started animations may not have current value
-      VectorRef fromVec2 = NULL != currentVec ? currentVec : fromVec;
+      const VectorRef &fromVec2 = NULL != currentVec ? currentVec : fromVec;
 
       if (fromVec2 && toVec) {
         Vector4r distance = toVec->vector4r();
@@ -0,0 +1,189 @@
+/**
+ Copyright (c) 2014-present, Facebook, Inc.
+ All rights reserved.
+
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree. An additional grant
+ of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#ifndef __POP__FBSlotMap__
+#define __POP__FBSlotMap__
+
+#ifdef __cplusplus
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace POP {
+
+  /**
+   Handle to a slot map value. Handles of removed values are never valid again, as each reuse of a slot
+   increments its generation. The default handle is invalid.
+   */
+  struct SlotHandle
+  {
+    uint32_t index;
+    uint32_t generation;
+
+    SlotHandle() : index(UINT32_MAX), generation(0) {}
+    SlotHandle(uint32_t i, uint32_t g) : index(i), generation(g) {}
+
+    bool operator==(const SlotHandle &other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const SlotHandle &other) const { return !(*this == other); }
+  };
+
+  /**
+   Values addressed by generational handles, with constant time insertion, removal and lookup.
+   Values are stored densely for iteration, in insertion order. Removal leaves a hole, closed by the next dense
+   access in one pass over the values; removing many values between iterations thus costs linear time in total.
+   Dense accesses invalidate pointers to values. Plain C++, not thread safe.
+   */
+  template <typename T>
+  class SlotMap
+  {
+    struct Slot
+    {
+      uint32_t dense;       // index of the value, or the next free slot while free
+      uint32_t generation;  // odd while occupied
+    };
+
+    static const uint32_t kHole = UINT32_MAX;
+
+    std::vector<T> _values;
+    std::vector<uint32_t> _valueSlots;  // slot of each value, or kHole once removed
+    std::vector<Slot> _slots;
+    uint32_t _freeSlot;
+    uint32_t _holes;
+
+    const Slot *slot(const SlotHandle &handle) const
+    {
+      if (handle.index >= _slots.size()) {
+        return NULL;
+      }
+      const Slot &s = _slots[handle.index];
+      return (s.generation == handle.generation && 0 != (s.generation & 1)) ? &s : NULL;
+    }
+
+  public:
+    SlotMap() : _freeSlot(UINT32_MAX), _holes(0) {}
+
+    // Number of values
+    size_t size() const { return _values.size() - _holes; }
+    bool empty() const { return 0 == size(); }
+
+    // Dense values, in iteration order
+    T *data() { compact(); return _values.data(); }
+    T &operator[](size_t idx) { compact(); return _values[idx]; }
+    typename std::vector<T>::iterator begin() { compact(); return _values.begin(); }
+    typename std::vector<T>::iterator end() { compact(); return _values.end(); }
+
+    // Handle of the value at dense index idx
+    SlotHandle handle(size_t idx)
+    {
+      compact();
+      uint32_t s = _valueSlots[idx];
+      return SlotHandle(s, _slots[s].generation);
+    }
+
+    // Closes the holes of removed values, keeping order
+    void compact()
+    {
+      if (0 == _holes) {
+        return;
+      }
+
+      uint32_t count = 0;
+      for (size_t idx = 0; idx < _values.size(); idx++) {
+        uint32_t s = _valueSlots[idx];
+        if (kHole == s) {
+          continue;
+        }
+        if (count != idx) {
+          _values[count] = _values[idx];
+          _valueSlots[count] = s;
+          _slots[s].dense = count;
+        }
+        count++;
+      }
+      _values.resize(count);
+      _valueSlots.resize(count);
+      _holes = 0;
+    }
+
+    // Adds a value, returning its handle
+    SlotHandle insert(const T &value)
+    {
+      uint32_t s;
+      if (UINT32_MAX != _freeSlot) {
+        s = _freeSlot;
+        _freeSlot = _slots[s].dense;
+      } else {
+        s = (uint32_t)_slots.size();
+        Slot empty = {0, 0};
+        _slots.push_back(empty);
+      }
+
+      Slot &slot = _slots[s];
+      slot.dense = (uint32_t)_values.size();
+      slot.generation++;
+      _values.push_back(value);
+      _valueSlots.push_back(s);
+      return SlotHandle(s, slot.generation);
+    }
+
+    // Returns whether handle refers to a value
+    bool contains(const SlotHandle &handle) const { return NULL != slot(handle); }
+
+    // Returns the value of handle, or NULL
+    T *get(const SlotHandle &handle)
+    {
+      const Slot *s = slot(handle);
+      return NULL != s ? &_values[s->dense] : NULL;
+    }
+
+    const T *get(const SlotHandle &handle) const
+    {
+      const Slot *s = slot(handle);
+      return NULL != s ? &_values[s->dense] : NULL;
+    }
+
+    // Removes the value of handle, returning false for invalid handles
+    bool erase(const SlotHandle &handle)
+    {
+      if (!contains(handle)) {
+        return false;
+      }
+
+      Slot &removed = _slots[handle.index];
+
+      // leave a hole, closed on the next dense access
+      _values[removed.dense] = T();
+      _valueSlots[removed.dense] = kHole;
+      _holes++;
+
+      // free the slot, invalidating its handles
+      removed.generation++;
+      removed.dense = _freeSlot;
+      _freeSlot = handle.index;
+      return true;
+    }
+
+    // Removes all values, invalidating their handles and retaining storage
+    void clear()
+    {
+      for (size_t idx = 0; idx < _values.size(); idx++) {
+        uint32_t s = _valueSlots[idx];
+        if (kHole != s) {
+          erase(SlotHandle(s, _slots[s].generation));
+        }
+      }
+      compact();
+    }
+  };
+
+}
+
+#endif /* __cplusplus */
+#endif /* defined(__POP__FBSlotMap__) */
@@ -9,6 +9,18 @@
 
 #import <pop/POPPropertyAnimation.h>
 
+/**
+ @abstract Modes used to solve spring dynamics.
+ @discussion kPOPSpringSolverModeIntegrated numerically integrates the spring in fixed one millisecond steps. kPOPSpringSolverModeAnalytic evaluates the damped harmonic oscillator in closed form, costing the same per frame regardless of frame duration. Analytic trajectories agree with integrated ones to within 1e-6 of the spring displacement. kPOPSpringSolverModeAdaptive integrates with an embedded Dormand-Prince 5(4) method, adapting the step size to 'solverTolerance' and typically taking a tenth of the integrated steps. kPOPSpringSolverModeCached follows integrated trajectories by table lookup, sharing precomputed responses between springs of equal dynamics through a process-wide cache. Suited to many identical springs running at once.
+ */
+typedef NS_ENUM(NSUInteger, POPSpringSolverMode)
+{
+  kPOPSpringSolverModeIntegrated = 0,
+  kPOPSpringSolverModeAnalytic,
+  kPOPSpringSolverModeAdaptive,
+  kPOPSpringSolverModeCached,
+};
+
 /**
  @abstract A concrete spring animation class.
  @discussion Animation is achieved through modeling spring dynamics.
@@ -28,6 +40,24 @@
  */
 + (instancetype)animationWithPropertyNamed:(NSString *)name;
 
+/**
+ @abstract The memory limit of the process-wide spring response cache, in bytes.
+ @discussion Used by kPOPSpringSolverModeCached. Least recently used responses are evicted beyond the limit; running animations keep their responses. Defaults to 1 MB, about 200 distinct springs.
+ */
++ (NSUInteger)responseCacheMemoryLimit;
++ (void)setResponseCacheMemoryLimit:(NSUInteger)limit;
+
+/**
+ @abstract The memory used by the process-wide spring response cache, in bytes.
+ */
++ (NSUInteger)responseCacheMemoryUsage;
+
+/**
+ @abstract The number of spring response cache lookups that found, or missed, a cached response.
+ */
++ (NSUInteger)responseCacheHitCount;
++ (NSUInteger)responseCacheMissCount;
+
 /**
  @abstract The current velocity value.
  @discussion Set before animation start to account for initial velocity. Expressed in change of value units per second.
@@ -64,4 +94,34 @@
  */
 @property (assign, nonatomic) CGFloat dynamicsMass;
 
+/**
+ @abstract The mode used to solve spring dynamics.
+ @discussion Defaults to kPOPSpringSolverModeIntegrated. Springs with non-positive tension or mass are always integrated.
+ */
+@property (assign, nonatomic) POPSpringSolverMode solverMode;
+
+/**
+ @abstract The local error tolerance of the adaptive solver, in value units.
+ @discussion Used with kPOPSpringSolverModeAdaptive. Velocity errors are weighed by the natural frequency of the spring. Defaults to 0, deriving a tolerance from the property threshold.
+ */
+@property (assign, nonatomic) CGFloat solverTolerance;
+
+/**
+ @abstract The number of integration steps taken on the last frame.
+ @discussion Includes rejected adaptive steps. Always zero for kPOPSpringSolverModeAnalytic.
+ */
+@property (readonly, nonatomic) NSUInteger solverStepCount;
+
+/**
+ @abstract The predicted time, in seconds, until the spring settles within the dynamics threshold.
+ @discussion Computed in closed form from the dynamics, the distance to toValue, velocity and dynamicsThreshold, without simulating. Measured from the current value of a running animation, otherwise from fromValue. Running animations complete no later than the predicted time. Returns INFINITY for springs without friction, and -1 if unavailable, such as without a fromValue or for springs with non-positive tension or mass.
+ */
+@property (readonly, nonatomic) CFTimeInterval predictedSettleDuration;
+
+/**
+ @abstract The predicted peak overshoot past toValue.
+ @discussion Boxed like toValue, holding the largest distance each component travels past toValue, on the side opposite to where it starts. Components that do not overshoot are zero. Measured like predictedSettleDuration, returning nil if unavailable.
+ */
+@property (readonly, nonatomic) id predictedOvershoot;
+
 @end
@@ -28,6 +28,31 @@
   return anim;
 }
 
++ (NSUInteger)responseCacheMemoryLimit
+{
+  return SpringResponseCache::sharedCache().memoryLimit();
+}
+
++ (void)setResponseCacheMemoryLimit:(NSUInteger)limit
+{
+  SpringResponseCache::sharedCache().setMemoryLimit(limit);
+}
+
++ (NSUInteger)responseCacheMemoryUsage
+{
+  return SpringResponseCache::sharedCache().memoryUsage();
+}
+
++ (NSUInteger)responseCacheHitCount
+{
+  return SpringResponseCache::sharedCache().hitCount();
+}
+
++ (NSUInteger)responseCacheMissCount
+{
+  return SpringResponseCache::sharedCache().missCount();
+}
+
 - (void)_initState
 {
   _state = new POPSpringAnimationState(self);
@@ -67,6 +92,7 @@
   if (!vec_equal(vec, s->velocityVec)) {
     s->velocityVec = vec;
     s->originalVelocityVec = origVec;
+    __state->settlePredicted = false;
 
     if (s->tracing) {
       [s->tracer updateVelocity:aValue];
@@ -77,6 +103,30 @@
 DEFINE_RW_PROPERTY(POPSpringAnimationState, dynamicsTension, setDynamicsTension:, CGFloat, [self _updatedDynamicsTension];);
 DEFINE_RW_PROPERTY(POPSpringAnimationState, dynamicsFriction, setDynamicsFriction:, CGFloat, [self _updatedDynamicsFriction];);
 DEFINE_RW_PROPERTY(POPSpringAnimationState, dynamicsMass, setDynamicsMass:, CGFloat, [self _updatedDynamicsMass];);
+DEFINE_RW_PROPERTY(POPSpringAnimationState, solverMode, setSolverMode:, POPSpringSolverMode, __state->updatedSolverMode(););
+DEFINE_RW_PROPERTY(POPSpringAnimationState, solverTolerance, setSolverTolerance:, CGFloat, __state->updatedSolverMode(););
+
+- (NSUInteger)solverStepCount
+{
+  return __state->solver ? __state->solver->stepCount() : 0;
+}
+
+- (CFTimeInterval)predictedSettleDuration
+{
+  return __state->predictedSettleDuration();
+}
+
+- (id)predictedOvershoot
+{
+  SSState4d state;
+  if (!__state->getPredictionState(state)) {
+    return nil;
+  }
+
+  VectorRef vec(Vector::new_vector(__state->valueCount, NULL));
+  *vec = __state->solver->peakOvershoot(state);
+  return POPBox(vec, __state->valueType);
+}
 
 FB_PROPERTY_GET(POPSpringAnimationState, springSpeed, CGFloat);
 - (void)setSpringSpeed:(CGFloat)aFloat
@@ -118,6 +168,7 @@ FB_PROPERTY_GET(POPSpringAnimationState, springBounciness, CGFloat);
       delete(__state->solver);
     }
     __state->solver = aSolver;
+    __state->updatedSolverMode();
   }
 }
 
@@ -160,6 +211,13 @@ FB_PROPERTY_GET(POPSpringAnimationState, springBounciness, CGFloat);
     } else {
       [s appendFormat:@"; bounciness = %f; speed = %f", __state->springBounciness, __state->springSpeed];
     }
+    if (kPOPSpringSolverModeAnalytic == __state->solverMode) {
+      [s appendString:@"; solver = analytic"];
+    } else if (kPOPSpringSolverModeAdaptive == __state->solverMode) {
+      [s appendFormat:@"; solver = adaptive; tolerance = %f", __state->solverTolerance];
+    } else if (kPOPSpringSolverModeCached == __state->solverMode) {
+      [s appendString:@"; solver = cached"];
+    }
   }
 }
 
@@ -184,6 +242,8 @@ FB_PROPERTY_GET(POPSpringAnimationState, springBounciness, CGFloat);
     copy.dynamicsTension = self.dynamicsTension;
     copy.dynamicsFriction = self.dynamicsFriction;
     copy.dynamicsMass = self.dynamicsMass;
+    copy.solverMode = self.solverMode;
+    copy.solverTolerance = self.solverTolerance;
   }
   
   return copy;
@@ -11,6 +11,7 @@
 
 #import "POPAnimationExtras.h"
 #import "POPPropertyAnimationInternal.h"
+#import "POPSpringResponseCache.h"
 
 struct _POPSpringAnimationState : _POPPropertyAnimationState
 {
@@ -20,6 +21,23 @@ struct _POPSpringAnimationState : _POPPropertyAnimationState
   CGFloat dynamicsTension;  // tension
   CGFloat dynamicsFriction; // friction
   CGFloat dynamicsMass;     // mass
+  POPSpringSolverMode solverMode;
+  CGFloat solverTolerance;
+
+  // predicted completion time, negative if unavailable; valid while to value and velocity are unchanged
+  CFTimeInterval settleTime;
+  VectorRef settleToVec;
+  bool settlePredicted;
+
+  // solver result precomputed by the animator's batched spring pass
+  struct {
+    CFTimeInterval time;
+    SSState4d input;
+    SSState4d output;
+    Vector4d dv;
+    CFTimeInterval accumulatedTime;
+    NSUInteger stepCount;
+  } batched;
 
   _POPSpringAnimationState(id __unsafe_unretained anim) : _POPPropertyAnimationState(anim),
   solver(nullptr),
@@ -27,9 +45,14 @@ struct _POPSpringAnimationState : _POPPropertyAnimationState
   springBounciness(4.),
   dynamicsTension(0),
   dynamicsFriction(0),
-  dynamicsMass(0)
+  dynamicsMass(0),
+  solverMode(kPOPSpringSolverModeIntegrated),
+  solverTolerance(0),
+  settleTime(-1),
+  settlePredicted(false)
   {
     type = kPOPAnimationSpring;
+    batched.time = -1;
   }
 
   bool hasConverged()
@@ -60,19 +83,63 @@ struct _POPSpringAnimationState : _POPPropertyAnimationState
     if (_POPPropertyAnimationState::isDone()) {
       return true;
     }
-    return solver->started() && (hasConverged() || solver->hasConverged());
+    if (!solver->started()) {
+      return false;
+    }
+
+    // complete on schedule
+    if (settlePredicted && 0 <= settleTime && lastTime >= settleTime) {
+      return true;
+    }
+    return hasConverged() || solver->hasConverged();
   }
 
   void updatedDynamics()
   {
+    batched.time = -1;
+    settlePredicted = false;
     if (NULL != solver) {
       solver->setConstants(dynamicsTension, dynamicsFriction, dynamicsMass);
+      updatedTransitionTable();
+    }
+  }
+
+  // shares the cached response of equal springs
+  void updatedTransitionTable()
+  {
+    if (kPOPSpringSolverModeCached != solverMode) {
+      solver->setTransitionTable(NULL);
+    } else if (!solver->transitionTable()) {
+      solver->setTransitionTable(SpringResponseCache::sharedCache().response(dynamicsTension, dynamicsFriction, dynamicsMass));
+    }
+  }
+
+  void updatedSolverMode()
+  {
+    if (NULL != solver) {
+      switch (solverMode) {
+        case kPOPSpringSolverModeAnalytic:
+          solver->setMode(kSpringSolverModeAnalytic);
+          break;
+        case kPOPSpringSolverModeAdaptive:
+          solver->setMode(kSpringSolverModeAdaptive);
+          break;
+        case kPOPSpringSolverModeCached:
+          solver->setMode(kSpringSolverModeCached);
+          break;
+        default:
+          solver->setMode(kSpringSolverModeIntegrated);
+          break;
+      }
+      solver->setTolerance(solverTolerance);
+      updatedTransitionTable();
     }
   }
 
   void updatedDynamicsThreshold()
   {
     _POPPropertyAnimationState::updatedDynamicsThreshold();
+    settlePredicted = false;
     if (NULL != solver) {
       solver->setThreshold(dynamicsThreshold);
     }
@@ -83,35 +150,134 @@ struct _POPSpringAnimationState : _POPPropertyAnimationState
     updatedDynamics();
   }
 
-  bool advance(CFTimeInterval time, CFTimeInterval dt, id obj) {
-    // advance past not yet initialized animations
-    if (NULL == currentVec) {
+  // reads the solver state of the first count components, assuming a spring of size zero
+  template <typename V>
+  void getSolverState(SSState<V> &state, size_t count) {
+    const CGFloat *toValues = vec_data(toVec);
+    const CGFloat *values = currentVec->data();
+    const CGFloat *velocities = vec_data(velocityVec);
+
+    for (size_t idx = 0; idx < count; idx++) {
+      state.p(idx) = (toValues ? toValues[idx] : 0) - values[idx];
+
+      // flip the velocity from user perspective to solver perspective
+      state.v(idx) = velocities ? -velocities[idx] : 0;
+    }
+  }
+
+  // returns the solver state, assuming a spring of size zero
+  SSState4d solverState() {
+    SSState4d state;
+    state.p = state.v = Vector4d::Zero();
+    getSolverState(state, MIN(valueCount, (NSUInteger)4));
+    return state;
+  }
+
+  // returns the solver state from the current value, or the from value before the animation runs
+  bool getPredictionState(SSState4d &state) {
+    const VectorRef &vec = NULL != currentVec ? currentVec : fromVec;
+    if (NULL == vec || NULL == toVec || NULL == solver) {
       return false;
     }
 
-    CFTimeInterval localTime = time - startTime;
+    const CGFloat *toValues = toVec->data();
+    const CGFloat *values = vec->data();
+    const CGFloat *velocities = vec_data(velocityVec);
 
-    Vector4d value = vector4d(currentVec);
-    Vector4d toValue = vector4d(toVec);
-    Vector4d velocity = vector4d(velocityVec);
+    state.p = state.v = Vector4d::Zero();
+    for (size_t idx = 0; idx < MIN(valueCount, (NSUInteger)4); idx++) {
+      state.p(idx) = toValues[idx] - values[idx];
+      state.v(idx) = velocities ? -velocities[idx] : 0;
+    }
+    return true;
+  }
 
+  CFTimeInterval predictedSettleDuration() {
     SSState4d state;
-    state.p = toValue - value;
+    return getPredictionState(state) ? solver->settleTime(state) : -1;
+  }
 
-    // the solver assumes a spring of size zero
-    // flip the velocity from user perspective to solver perspective
-    state.v = velocity * -1;
+  // returns true if the solver step for time can be computed by a spring batch
+  bool canBatch(CFTimeInterval time) {
+    if (!active || paused || !isStarted() || NULL == currentVec || NULL == solver) {
+      return false;
+    }
+    CFTimeInterval dt = time - lastTime;
+    if (kSpringSolverModeIntegrated != solver->mode() || dt <= 0 || dt > maxSolverDt) {
+      return false;
+    }
 
-    solver->advance(state, localTime, dt);
-    value = toValue - state.p;
+    // leave steps over budget to the solver's bounded catch up
+    NSUInteger maxSteps = solver->maxSteps();
+    return 0 == maxSteps || (solver->accumulatedTime() + dt) / solverDt <= maxSteps;
+  }
 
-    // flip velocity back to user perspective
-    velocity = state.v * -1;
+  // advances the first state.p.size() components, avoiding work on unused ones
+  template <typename V>
+  void advanceSolver(CFTimeInterval time, CFTimeInterval dt) {
+    CFTimeInterval localTime = time - startTime;
+
+    SSState<V> state;
+    getSolverState(state, state.p.size());
+
+    // predict completion whenever to value or velocity are replaced
+    if (!settlePredicted || !vec_equal(settleToVec, toVec)) {
+      CFTimeInterval settleDuration = solver->settleTime(state);
+      settleTime = settleDuration < 0 ? -1 : lastTime + settleDuration;
+      settleToVec = toVec;
+      settlePredicted = true;
+    }
 
-    *currentVec = value;
+    // use the batched result unless inputs changed since it was computed
+    bool useBatched = time == batched.time;
+    for (size_t idx = 0; useBatched && idx < state.p.size(); idx++) {
+      useBatched = state.p(idx) == batched.input.p(idx) && state.v(idx) == batched.input.v(idx);
+    }
+
+    if (useBatched) {
+      for (size_t idx = 0; idx < state.p.size(); idx++) {
+        state.p(idx) = batched.output.p(idx);
+        state.v(idx) = batched.output.v(idx);
+      }
+      solver->didAdvance(batched.output, batched.dv, batched.accumulatedTime, batched.stepCount);
+    } else {
+      solver->advance(state, localTime, dt);
+    }
+    batched.time = -1;
+
+    const CGFloat *toValues = vec_data(toVec);
+    CGFloat *values = currentVec->data();
+    CGFloat *velocities = vec_data(velocityVec);
+
+    for (size_t idx = 0; idx < state.p.size(); idx++) {
+      values[idx] = (toValues ? toValues[idx] : 0) - state.p(idx);
+
+      // flip velocity back to user perspective
+      if (velocities) {
+        velocities[idx] = -state.v(idx);
+      }
+    }
+  }
+
+  bool advance(CFTimeInterval time, CFTimeInterval dt, id obj) {
+    // advance past not yet initialized animations
+    if (NULL == currentVec) {
+      return false;
+    }
 
-    if (velocityVec) {
-      *velocityVec = velocity;
+    switch (valueCount) {
+      case 1:
+        advanceSolver<Vector1d>(time, dt);
+        break;
+      case 2:
+        advanceSolver<Vector2d>(time, dt);
+        break;
+      case 3:
+        advanceSolver<Vector3d>(time, dt);
+        break;
+      default:
+        advanceSolver<Vector4d>(time, dt);
+        break;
     }
 
     clampCurrentValue();
@@ -121,10 +287,14 @@ struct _POPSpringAnimationState : _POPPropertyAnimationState
 
   virtual void reset(bool all) {
     _POPPropertyAnimationState::reset(all);
+    batched.time = -1;
+    settlePredicted = false;
+    settleToVec = NULL;
 
     if (solver) {
       solver->setConstants(dynamicsTension, dynamicsFriction, dynamicsMass);
       solver->reset();
+      updatedTransitionTable();
     }
   }
 };
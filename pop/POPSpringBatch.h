@@ -0,0 +1,273 @@
+/**
+ Copyright (c) 2014-present, Facebook, Inc.
+ All rights reserved.
+
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree. An additional grant
+ of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#ifndef __POP__FBSpringBatch__
+#define __POP__FBSpringBatch__
+
+#ifdef __cplusplus
+
+#include <cstddef>
+#include <vector>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define POP_SPRING_BATCH_AVX 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define POP_SPRING_BATCH_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define POP_SPRING_BATCH_NEON 1
+#endif
+
+namespace POP {
+
+  /**
+   Advances many one dimensional springs together.
+   Each lane holds one spring component in structure-of-arrays buffers. Springs are stepped in fixed steps of
+   stepDt using a per lane state transition matrix, carrying leftover time and interpolating between the last
+   two steps exactly like SpringSolver. Lanes are processed with AVX, SSE2 or NEON when available.
+   Plain C++, no platform dependencies.
+   */
+  class SpringBatch
+  {
+#if POP_SPRING_BATCH_AVX
+    static const size_t kWidth = 4;
+#elif POP_SPRING_BATCH_SSE2 || POP_SPRING_BATCH_NEON
+    static const size_t kWidth = 2;
+#else
+    static const size_t kWidth = 1;
+#endif
+
+    double _h;
+    size_t _count;
+
+    // lane state
+    std::vector<double> _p;
+    std::vector<double> _v;
+    std::vector<double> _dv;
+    std::vector<double> _acc;
+    std::vector<double> _dt;
+
+    // lane step transition
+    std::vector<double> _pp;
+    std::vector<double> _pv;
+    std::vector<double> _vp;
+    std::vector<double> _vv;
+
+    void reserveLanes(size_t count)
+    {
+      // pad to a multiple of the vector width; padded lanes never step
+      size_t padded = (count + kWidth - 1) / kWidth * kWidth;
+      if (padded > _p.size()) {
+        size_t capacity = padded * 2;
+        _p.resize(capacity);
+        _v.resize(capacity);
+        _dv.resize(capacity);
+        _acc.resize(capacity);
+        _dt.resize(capacity);
+        _pp.resize(capacity);
+        _pv.resize(capacity);
+        _vp.resize(capacity);
+        _vv.resize(capacity);
+      }
+    }
+
+    void advanceScalar(size_t start, size_t end)
+    {
+      const double h = _h;
+      for (size_t i = start; i < end; i++) {
+        double p = _p[i], v = _v[i], acc = _acc[i] + _dt[i];
+        double pp = p, pv = v;
+        bool stepped = false;
+        while (acc >= h) {
+          pp = p;
+          pv = v;
+          double np = _pp[i] * p + _pv[i] * v;
+          double nv = _vp[i] * p + _vv[i] * v;
+          p = np;
+          v = nv;
+          acc -= h;
+          stepped = true;
+        }
+        if (stepped) {
+          _dv[i] = (v - pv) / h;
+        }
+        double alpha = acc / h;
+        _p[i] = p * alpha + pp * (1 - alpha);
+        _v[i] = v * alpha + pv * (1 - alpha);
+        _acc[i] = acc;
+      }
+    }
+
+#if POP_SPRING_BATCH_AVX
+    void advanceVector(size_t end)
+    {
+      const __m256d h = _mm256_set1_pd(_h);
+      const __m256d one = _mm256_set1_pd(1.);
+      for (size_t i = 0; i < end; i += kWidth) {
+        __m256d p = _mm256_loadu_pd(&_p[i]), v = _mm256_loadu_pd(&_v[i]);
+        __m256d acc = _mm256_add_pd(_mm256_loadu_pd(&_acc[i]), _mm256_loadu_pd(&_dt[i]));
+        __m256d mpp = _mm256_loadu_pd(&_pp[i]), mpv = _mm256_loadu_pd(&_pv[i]);
+        __m256d mvp = _mm256_loadu_pd(&_vp[i]), mvv = _mm256_loadu_pd(&_vv[i]);
+        __m256d pp = p, pv = v;
+        __m256d mask = _mm256_cmp_pd(acc, h, _CMP_GE_OQ);
+        __m256d stepped = mask;
+        while (_mm256_movemask_pd(mask)) {
+          __m256d np = _mm256_add_pd(_mm256_mul_pd(mpp, p), _mm256_mul_pd(mpv, v));
+          __m256d nv = _mm256_add_pd(_mm256_mul_pd(mvp, p), _mm256_mul_pd(mvv, v));
+          pp = _mm256_blendv_pd(pp, p, mask);
+          pv = _mm256_blendv_pd(pv, v, mask);
+          p = _mm256_blendv_pd(p, np, mask);
+          v = _mm256_blendv_pd(v, nv, mask);
+          acc = _mm256_sub_pd(acc, _mm256_and_pd(h, mask));
+          mask = _mm256_cmp_pd(acc, h, _CMP_GE_OQ);
+        }
+        __m256d dv = _mm256_div_pd(_mm256_sub_pd(v, pv), h);
+        _mm256_storeu_pd(&_dv[i], _mm256_blendv_pd(_mm256_loadu_pd(&_dv[i]), dv, stepped));
+        __m256d alpha = _mm256_div_pd(acc, h);
+        __m256d beta = _mm256_sub_pd(one, alpha);
+        _mm256_storeu_pd(&_p[i], _mm256_add_pd(_mm256_mul_pd(p, alpha), _mm256_mul_pd(pp, beta)));
+        _mm256_storeu_pd(&_v[i], _mm256_add_pd(_mm256_mul_pd(v, alpha), _mm256_mul_pd(pv, beta)));
+        _mm256_storeu_pd(&_acc[i], acc);
+      }
+    }
+#elif POP_SPRING_BATCH_SSE2
+    static __m128d blend(__m128d a, __m128d b, __m128d mask)
+    {
+      return _mm_or_pd(_mm_andnot_pd(mask, a), _mm_and_pd(mask, b));
+    }
+
+    void advanceVector(size_t end)
+    {
+      const __m128d h = _mm_set1_pd(_h);
+      const __m128d one = _mm_set1_pd(1.);
+      for (size_t i = 0; i < end; i += kWidth) {
+        __m128d p = _mm_loadu_pd(&_p[i]), v = _mm_loadu_pd(&_v[i]);
+        __m128d acc = _mm_add_pd(_mm_loadu_pd(&_acc[i]), _mm_loadu_pd(&_dt[i]));
+        __m128d mpp = _mm_loadu_pd(&_pp[i]), mpv = _mm_loadu_pd(&_pv[i]);
+        __m128d mvp = _mm_loadu_pd(&_vp[i]), mvv = _mm_loadu_pd(&_vv[i]);
+        __m128d pp = p, pv = v;
+        __m128d mask = _mm_cmpge_pd(acc, h);
+        __m128d stepped = mask;
+        while (_mm_movemask_pd(mask)) {
+          __m128d np = _mm_add_pd(_mm_mul_pd(mpp, p), _mm_mul_pd(mpv, v));
+          __m128d nv = _mm_add_pd(_mm_mul_pd(mvp, p), _mm_mul_pd(mvv, v));
+          pp = blend(pp, p, mask);
+          pv = blend(pv, v, mask);
+          p = blend(p, np, mask);
+          v = blend(v, nv, mask);
+          acc = _mm_sub_pd(acc, _mm_and_pd(h, mask));
+          mask = _mm_cmpge_pd(acc, h);
+        }
+        __m128d dv = _mm_div_pd(_mm_sub_pd(v, pv), h);
+        _mm_storeu_pd(&_dv[i], blend(_mm_loadu_pd(&_dv[i]), dv, stepped));
+        __m128d alpha = _mm_div_pd(acc, h);
+        __m128d beta = _mm_sub_pd(one, alpha);
+        _mm_storeu_pd(&_p[i], _mm_add_pd(_mm_mul_pd(p, alpha), _mm_mul_pd(pp, beta)));
+        _mm_storeu_pd(&_v[i], _mm_add_pd(_mm_mul_pd(v, alpha), _mm_mul_pd(pv, beta)));
+        _mm_storeu_pd(&_acc[i], acc);
+      }
+    }
+#elif POP_SPRING_BATCH_NEON
+    void advanceVector(size_t end)
+    {
+      const float64x2_t h = vdupq_n_f64(_h);
+      const float64x2_t one = vdupq_n_f64(1.);
+      for (size_t i = 0; i < end; i += kWidth) {
+        float64x2_t p = vld1q_f64(&_p[i]), v = vld1q_f64(&_v[i]);
+        float64x2_t acc = vaddq_f64(vld1q_f64(&_acc[i]), vld1q_f64(&_dt[i]));
+        float64x2_t mpp = vld1q_f64(&_pp[i]), mpv = vld1q_f64(&_pv[i]);
+        float64x2_t mvp = vld1q_f64(&_vp[i]), mvv = vld1q_f64(&_vv[i]);
+        float64x2_t pp = p, pv = v;
+        uint64x2_t mask = vcgeq_f64(acc, h);
+        uint64x2_t stepped = mask;
+        while (vgetq_lane_u64(mask, 0) | vgetq_lane_u64(mask, 1)) {
+          float64x2_t np = vaddq_f64(vmulq_f64(mpp, p), vmulq_f64(mpv, v));
+          float64x2_t nv = vaddq_f64(vmulq_f64(mvp, p), vmulq_f64(mvv, v));
+          pp = vbslq_f64(mask, p, pp);
+          pv = vbslq_f64(mask, v, pv);
+          p = vbslq_f64(mask, np, p);
+          v = vbslq_f64(mask, nv, v);
+          acc = vsubq_f64(acc, vbslq_f64(mask, h, vdupq_n_f64(0.)));
+          mask = vcgeq_f64(acc, h);
+        }
+        float64x2_t dv = vdivq_f64(vsubq_f64(v, pv), h);
+        vst1q_f64(&_dv[i], vbslq_f64(stepped, dv, vld1q_f64(&_dv[i])));
+        float64x2_t alpha = vdivq_f64(acc, h);
+        float64x2_t beta = vsubq_f64(one, alpha);
+        vst1q_f64(&_p[i], vaddq_f64(vmulq_f64(p, alpha), vmulq_f64(pp, beta)));
+        vst1q_f64(&_v[i], vaddq_f64(vmulq_f64(v, alpha), vmulq_f64(pv, beta)));
+        vst1q_f64(&_acc[i], acc);
+      }
+    }
+#endif
+
+  public:
+    SpringBatch() : _h(0), _count(0) {}
+
+    // Number of lanes
+    size_t size() const { return _count; }
+
+    // Removes all lanes, retaining storage
+    void clear()
+    {
+      _count = 0;
+    }
+
+    /**
+     Adds a lane, returning its index. The transition advances (p, v) by one step of stepDt:
+     p' = p * pp + v * pv
+     v' = p * vp + v * vv
+     */
+    size_t addLane(double p, double v, double dv, double accumulatedTime, double dt, double pp, double pv, double vp, double vv)
+    {
+      reserveLanes(_count + 1);
+      size_t i = _count++;
+      _p[i] = p;
+      _v[i] = v;
+      _dv[i] = dv;
+      _acc[i] = accumulatedTime;
+      _dt[i] = dt;
+      _pp[i] = pp;
+      _pv[i] = pv;
+      _vp[i] = vp;
+      _vv[i] = vv;
+      return i;
+    }
+
+    // Advances all lanes by their time step, in fixed steps of stepDt
+    void advance(double stepDt)
+    {
+      _h = stepDt;
+      size_t end = _count;
+#if POP_SPRING_BATCH_AVX || POP_SPRING_BATCH_SSE2 || POP_SPRING_BATCH_NEON
+      // clear padded lanes of the last vector
+      size_t padded = (_count + kWidth - 1) / kWidth * kWidth;
+      for (size_t i = _count; i < padded; i++) {
+        _p[i] = _v[i] = _dv[i] = _acc[i] = _dt[i] = 0;
+        _pp[i] = _pv[i] = _vp[i] = _vv[i] = 0;
+      }
+      advanceVector(padded);
+      end = 0;
+#endif
+      advanceScalar(0, end);
+    }
+
+    // Lane results
+    double position(size_t lane) const { return _p[lane]; }
+    double velocity(size_t lane) const { return _v[lane]; }
+    double acceleration(size_t lane) const { return _dv[lane]; }
+    double accumulatedTime(size_t lane) const { return _acc[lane]; }
+  };
+
+}
+
+#endif /* __cplusplus */
+#endif /* defined(__POP__FBSpringBatch__) */
@@ -0,0 +1,106 @@
+/**
+ Copyright (c) 2014-present, Facebook, Inc.
+ All rights reserved.
+
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree. An additional grant
+ of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#ifndef __POP__FBSpringResponseCache__
+#define __POP__FBSpringResponseCache__
+
+#ifdef __cplusplus
+
+#import <pthread.h>
+
+#import <list>
+#import <memory>
+#import <unordered_map>
+
+#import "POPSpringSolver.h"
+
+namespace POP {
+
+  /**
+   Process-wide cache of normalized spring responses.
+   A response is the table of transitions of a unit spring state over 0 to kSteps solverDt steps of RK4
+   integration, shared by every spring of equal constants. Constants are quantized to 2^-16 before lookup,
+   and responses computed from the quantized constants. Least recently used responses are evicted beyond
+   the memory limit; springs retain responses they hold. Thread safe.
+   */
+  class SpringResponseCache
+  {
+  public:
+    // Steps covered by a response, about two frames at 60Hz and beyond the default step budget
+    static const size_t kSteps = 128;
+
+    // Default memory limit, in bytes
+    static const size_t kDefaultMemoryLimit = 1024 * 1024;
+
+    // The shared cache instance
+    static SpringResponseCache &sharedCache();
+
+    /**
+     Returns the response of the spring, computing it on a miss. Returns NULL for springs with non-positive
+     tension or mass or negative friction, which are not cached.
+     */
+    std::shared_ptr<const SSTransitionTable> response(double k, double b, double m);
+
+    // Memory limit, in bytes
+    size_t memoryLimit();
+    void setMemoryLimit(size_t limit);
+
+    // Memory used by cached responses, in bytes
+    size_t memoryUsage();
+
+    // Lookup statistics
+    size_t hitCount();
+    size_t missCount();
+
+    // Removes all responses and resets statistics
+    void clear();
+
+  private:
+    struct Key
+    {
+      int64_t k;
+      int64_t b;
+      int64_t m;
+
+      bool operator==(const Key &other) const { return k == other.k && b == other.b && m == other.m; }
+    };
+
+    struct KeyHash
+    {
+      size_t operator()(const Key &key) const
+      {
+        size_t h = std::hash<int64_t>()(key.k);
+        h = h * 31 + std::hash<int64_t>()(key.b);
+        return h * 31 + std::hash<int64_t>()(key.m);
+      }
+    };
+
+    typedef std::pair<Key, std::shared_ptr<const SSTransitionTable>> Entry;
+    typedef std::list<Entry> EntryList;
+
+    pthread_mutex_t _lock;
+    EntryList _entries; // most recently used first
+    std::unordered_map<Key, EntryList::iterator, KeyHash> _index;
+    size_t _memoryLimit;
+    size_t _memoryUsage;
+    size_t _hitCount;
+    size_t _missCount;
+
+    SpringResponseCache();
+    SpringResponseCache(const SpringResponseCache &) = delete;
+    SpringResponseCache &operator=(const SpringResponseCache &) = delete;
+
+    static size_t entrySize();
+    void evict(size_t limit);
+  };
+
+}
+
+#endif /* __cplusplus */
+#endif /* defined(__POP__FBSpringResponseCache__) */
@@ -0,0 +1,180 @@
+/**
+ Copyright (c) 2014-present, Facebook, Inc.
+ All rights reserved.
+
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree. An additional grant
+ of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "POPSpringResponseCache.h"
+
+#import <cmath>
+
+namespace POP
+{
+
+  // quantization of spring constants, 2^-16
+  static const double kQuantization = 65536.;
+
+  SpringResponseCache &SpringResponseCache::sharedCache()
+  {
+    // constructed on first use, never destroyed
+    static SpringResponseCache *cache = new SpringResponseCache();
+    return *cache;
+  }
+
+  SpringResponseCache::SpringResponseCache() : _memoryLimit(kDefaultMemoryLimit), _memoryUsage(0), _hitCount(0), _missCount(0)
+  {
+    pthread_mutex_init(&_lock, NULL);
+  }
+
+  size_t SpringResponseCache::entrySize()
+  {
+    return sizeof(Entry) + sizeof(SSTransitionTable) + (kSteps + 1) * sizeof(SSTransition);
+  }
+
+  std::shared_ptr<const SSTransitionTable> SpringResponseCache::response(double k, double b, double m)
+  {
+    Key key = {llround(k * kQuantization), llround(b * kQuantization), llround(m * kQuantization)};
+    if (key.k <= 0 || key.b < 0 || key.m <= 0) {
+      return NULL;
+    }
+
+    // lock
+    pthread_mutex_lock(&_lock);
+
+    auto it = _index.find(key);
+    if (it != _index.end()) {
+      _hitCount++;
+
+      // mark most recently used
+      _entries.splice(_entries.begin(), _entries, it->second);
+      std::shared_ptr<const SSTransitionTable> table = it->second->second;
+
+      // unlock
+      pthread_mutex_unlock(&_lock);
+      return table;
+    }
+    _missCount++;
+
+    // unlock
+    pthread_mutex_unlock(&_lock);
+
+    // compute outside the lock, from the quantized constants
+    SpringSolver1d solver(key.k / kQuantization, key.b / kQuantization, key.m / kQuantization);
+    SSTransition step = solver.integratedTransition(solverDt);
+
+    std::shared_ptr<SSTransitionTable> table = std::make_shared<SSTransitionTable>(kSteps + 1);
+    SSTransition &identity = (*table)[0];
+    identity.dt = 0;
+    identity.pp = identity.vv = 1;
+    identity.pv = identity.vp = 0;
+
+    for (size_t idx = 1; idx <= kSteps; idx++) {
+      const SSTransition &p = (*table)[idx - 1];
+      SSTransition &tr = (*table)[idx];
+      tr.dt = idx * solverDt;
+      tr.pp = step.pp * p.pp + step.pv * p.vp;
+      tr.pv = step.pp * p.pv + step.pv * p.vv;
+      tr.vp = step.vp * p.pp + step.vv * p.vp;
+      tr.vv = step.vp * p.pv + step.vv * p.vv;
+    }
+
+    // lock
+    pthread_mutex_lock(&_lock);
+
+    // another thread may have inserted the response meanwhile
+    it = _index.find(key);
+    if (it != _index.end()) {
+      std::shared_ptr<const SSTransitionTable> existing = it->second->second;
+
+      // unlock
+      pthread_mutex_unlock(&_lock);
+      return existing;
+    }
+
+    if (entrySize() <= _memoryLimit) {
+      evict(_memoryLimit - entrySize());
+      _entries.push_front(Entry(key, table));
+      _index[key] = _entries.begin();
+      _memoryUsage += entrySize();
+    }
+
+    // unlock
+    pthread_mutex_unlock(&_lock);
+
+    return table;
+  }
+
+  void SpringResponseCache::evict(size_t limit)
+  {
+    while (_memoryUsage > limit && !_entries.empty()) {
+      _index.erase(_entries.back().first);
+      _entries.pop_back();
+      _memoryUsage -= entrySize();
+    }
+  }
+
+  size_t SpringResponseCache::memoryLimit()
+  {
+    // lock
+    pthread_mutex_lock(&_lock);
+    size_t limit = _memoryLimit;
+    // unlock
+    pthread_mutex_unlock(&_lock);
+    return limit;
+  }
+
+  void SpringResponseCache::setMemoryLimit(size_t limit)
+  {
+    // lock
+    pthread_mutex_lock(&_lock);
+    _memoryLimit = limit;
+    evict(limit);
+    // unlock
+    pthread_mutex_unlock(&_lock);
+  }
+
+  size_t SpringResponseCache::memoryUsage()
+  {
+    // lock
+    pthread_mutex_lock(&_lock);
+    size_t usage = _memoryUsage;
+    // unlock
+    pthread_mutex_unlock(&_lock);
+    return usage;
+  }
+
+  size_t SpringResponseCache::hitCount()
+  {
+    // lock
+    pthread_mutex_lock(&_lock);
+    size_t count = _hitCount;
+    // unlock
+    pthread_mutex_unlock(&_lock);
+    return count;
+  }
+
+  size_t SpringResponseCache::missCount()
+  {
+    // lock
+    pthread_mutex_lock(&_lock);
+    size_t count = _missCount;
+    // unlock
+    pthread_mutex_unlock(&_lock);
+    return count;
+  }
+
+  void SpringResponseCache::clear()
+  {
+    // lock
+    pthread_mutex_lock(&_lock);
+    evict(0);
+    _hitCount = 0;
+    _missCount = 0;
+    // unlock
+    pthread_mutex_unlock(&_lock);
+  }
+
+}
@@ -9,6 +9,9 @@
 
 #import <Foundation/Foundation.h>
 
+#import <memory>
+#import <vector>
+
 #import <pop/POPVector.h>
 
 namespace POP {
@@ -27,14 +30,58 @@ namespace POP {
     T dv;
   };
   
+  typedef SSState<Vector1d> SSState1d;
+  typedef SSState<Vector2d> SSState2d;
   typedef SSState<Vector4d> SSState4d;
   typedef SSDerivative<Vector4d> SSDerivative4d;
   
   const CFTimeInterval solverDt = 0.001f;
   const CFTimeInterval maxSolverDt = 30.0f;
+
+  /**
+   Spring solver evaluation modes.
+   */
+  enum SpringSolverMode
+  {
+    // fixed step RK4 integration at solverDt
+    kSpringSolverModeIntegrated,
+
+    // closed form evaluation of the damped harmonic oscillator
+    // time is consumed in solverDt steps like integration, keeping both modes in lockstep
+    // positions agree with integration to within 1e-6 of the spring displacement
+    kSpringSolverModeAnalytic,
+
+    // Dormand-Prince 5(4) integration, adapting step size to an error tolerance
+    kSpringSolverModeAdaptive,
+
+    // integration evaluated by lookup in a table of transitions over whole solverDt steps
+    // frames exceeding the table are integrated
+    kSpringSolverModeCached,
+  };
+
+  /**
+   Coefficients of the closed form spring state transition over a time step.
+   p' = p * pp + v * pv
+   v' = p * vp + v * vv
+   */
+  struct SSTransition
+  {
+    double dt;
+    double pp;
+    double pv;
+    double vp;
+    double vv;
+  };
+
+  /**
+   Transitions over 0, 1, ... n solverDt steps, indexed by step count.
+   */
+  typedef std::vector<SSTransition> SSTransitionTable;
   
   /**
    Templated spring solver class.
+   Solver state is stored as T. Advancing is specialized on the vector type of the advanced state, which may have
+   fewer components than T, eg a Vector1d for a scalar property advanced by a SpringSolver4d.
    */
   template <typename T>
   class SpringSolver
@@ -51,11 +98,97 @@ namespace POP {
     SSState<T> _lastState;
     T _lastDv;
     bool _started;
+
+    SpringSolverMode _mode;
+    SSTransition _transition; // last analytic transition, reused while dt is unchanged
+
+    NSUInteger _maxSteps;     // step budget per advance, zero if unbounded
+    double _tolerance;        // adaptive local error tolerance
+    double _adaptiveDt;       // adaptive step size, carried across advances
+    NSUInteger _stepCount;    // integration steps attempted by the last advance
+
+    std::shared_ptr<const SSTransitionTable> _table; // cached mode step transitions
+
+    // stores a state component of fewer dimensions, zeroing the remaining ones
+    template <typename V>
+    static void store(T &output, const V &input)
+    {
+      output = T::Zero();
+      for (size_t idx = 0; idx < input.size(); idx++) {
+        output(idx) = input(idx);
+      }
+    }
+
+    static void store(T &output, const T &input)
+    {
+      output = input;
+    }
     
+    // springs predicted to settle later are considered to never settle
+    static constexpr double kMaxSettleTime = 3600.;
+
+    template <typename V>
+    double energy(const SSState<V> &state)
+    {
+      return (_k * state.p.squaredNorm() + _m * state.v.squaredNorm()) / 2.;
+    }
+
+    // returns the magnitude of the first extremum of a component past zero, or zero if none
+    double overshoot(double p, double v)
+    {
+      if (0 == p && 0 == v) {
+        return 0;
+      }
+      double side = 0 != p ? p : v;
+      double w0 = sqrt(_k / _m);
+      double zeta = _b / (2. * sqrt(_k * _m));
+
+      // times of the first velocity zeros after the start
+      double times[2] = {-1, -1};
+      if (fabs(zeta - 1.) < 1e-6) {
+        // critically damped, p = (p0 + c*t) * exp(-w0*t)
+        double c = v + w0 * p;
+        if (0 != c) {
+          times[0] = 1. / w0 - p / c;
+        }
+      } else if (zeta < 1.) {
+        // underdamped, velocity zeros half a period apart
+        double wd = w0 * sqrt(1. - zeta * zeta);
+        double theta = fmod(atan2(v * wd, p * w0 * w0 + v * zeta * w0), M_PI);
+        if (theta <= 0) {
+          theta += M_PI;
+        }
+        times[0] = theta / wd;
+        times[1] = (theta + M_PI) / wd;
+      } else {
+        // overdamped, p = a*exp(r1*t) + (p0 - a)*exp(r2*t)
+        double r = w0 * sqrt(zeta * zeta - 1.);
+        double r1 = -zeta * w0 + r;
+        double r2 = -zeta * w0 - r;
+        double a = (v - r2 * p) / (r1 - r2);
+        double ratio = 0 != a ? -r2 * (p - a) / (r1 * a) : 0;
+        if (ratio > 1) {
+          times[0] = log(ratio) / (r1 - r2);
+        }
+      }
+
+      for (size_t idx = 0; idx < 2; idx++) {
+        if (times[idx] > 0) {
+          SSTransition tr = transition(times[idx]);
+          double x = p * tr.pp + v * tr.pv;
+          if (x * side < 0) {
+            return fabs(x);
+          }
+        }
+      }
+      return 0;
+    }
+
   public:
-    SpringSolver(double k, double b, double m = 1) : _k(k), _b(b), _m(m), _started(false)
+    SpringSolver(double k, double b, double m = 1) : _k(k), _b(b), _m(m), _started(false), _mode(kSpringSolverModeIntegrated), _maxSteps(0), _tolerance(0), _adaptiveDt(0), _stepCount(0)
     {
       _accumulatedTime = 0;
+      _transition.dt = -1;
       _lastState.p = T::Zero();
       _lastState.v = T::Zero();
       _lastDv = T::Zero();
@@ -73,11 +206,120 @@ namespace POP {
     
     void setConstants(double k, double b, double m)
     {
+      if (k != _k || b != _b || m != _m) {
+        _table = NULL;
+      }
       _k = k;
       _b = b;
       _m = m;
+      _transition.dt = -1;
+    }
+
+    SpringSolverMode mode()
+    {
+      return _mode;
+    }
+
+    void setMode(SpringSolverMode mode)
+    {
+      _mode = mode;
+    }
+
+    /**
+     Sets the table of step transitions evaluated by kSpringSolverModeCached, eg shared by identical springs.
+     Cleared when the spring constants change.
+     */
+    void setTransitionTable(const std::shared_ptr<const SSTransitionTable> &table)
+    {
+      _table = table;
+    }
+
+    const std::shared_ptr<const SSTransitionTable> &transitionTable()
+    {
+      return _table;
+    }
+
+    CFTimeInterval accumulatedTime()
+    {
+      return _accumulatedTime;
+    }
+
+    const T &lastDv()
+    {
+      return _lastDv;
+    }
+
+    /**
+     Records the result of an advance performed outside the solver, eg by a SpringBatch.
+     */
+    void didAdvance(const SSState<T> &state, const T &lastDv, CFTimeInterval accumulatedTime, NSUInteger stepCount)
+    {
+      _started = true;
+      _stepCount = stepCount;
+      _lastState = state;
+      _lastDv = lastDv;
+      _accumulatedTime = accumulatedTime;
+    }
+
+    /**
+     Returns true if the constants describe a spring the analytic solution applies to.
+     */
+    bool canSolveAnalytically()
+    {
+      return _k > 0 && _m > 0 && _b >= 0;
     }
     
+    /**
+     Returns the largest RK4 step keeping the spring's modes stable: the stability region reaches about 2.78 along the
+     negative real axis and 2.83 along the imaginary axis, so steps stay within 2.5 over the largest eigenvalue
+     magnitude of m*x'' + b*x' + k*x = 0.
+     */
+    double maxStableDt()
+    {
+      if (_m <= 0) {
+        return solverDt;
+      }
+      double disc = _b * _b - 4. * _m * _k;
+      double maxEigenvalue = disc >= 0 ? (fabs(_b) + sqrt(disc)) / (2. * _m) : sqrt(_k / _m);
+      return maxEigenvalue > 0 ? 2.5 / maxEigenvalue : INFINITY;
+    }
+
+    /**
+     Sets the maximum number of solverDt steps integrated per advance. Advances exceeding the budget, eg after a
+     hitch, are evaluated in closed form, or with the budget of coarser steps for springs without one. Their cost is
+     then independent of dt. Coarse steps are bounded by maxStableDt(); beyond it the spring falls behind rather than
+     diverging. Zero means unbounded, shutting down springs advanced past maxSolverDt.
+     */
+    void setMaxSteps(NSUInteger maxSteps)
+    {
+      _maxSteps = maxSteps;
+    }
+
+    NSUInteger maxSteps()
+    {
+      return _maxSteps;
+    }
+
+    /**
+     Sets the adaptive local error tolerance, in value units. Velocity errors are weighed by the spring's natural
+     frequency, so a single tolerance applies to both. A tolerance of zero derives one from the threshold.
+     */
+    void setTolerance(double tolerance)
+    {
+      _tolerance = tolerance;
+    }
+
+    double tolerance()
+    {
+      return 0 != _tolerance ? _tolerance : _tp / 50;
+    }
+
+    // Integration steps attempted by the last advance, including rejected adaptive steps
+    NSUInteger stepCount()
+    {
+      return _stepCount;
+    }
+
     void setThreshold(double t)
     {
       _tp = t / 2;          // half a unit
@@ -85,73 +327,366 @@ namespace POP {
       _ta = 625.0 * t * t;  // 5 units per second squared, squared for comparison
     }
     
-    T acceleration(const SSState<T> &state, double t)
+    template <typename V>
+    V acceleration(const SSState<V> &state, double t)
     {
       return state.p*(-_k/_m) - state.v*(_b/_m);
     }
     
-    SSDerivative<T> evaluate(const SSState<T> &initial, double t)
+    template <typename V>
+    SSDerivative<V> evaluate(const SSState<V> &initial, double t)
     {
-      SSDerivative<T> output;
+      SSDerivative<V> output;
       output.dp = initial.v;
       output.dv = acceleration(initial, t);
       return output;
     }
     
-    SSDerivative<T> evaluate(const SSState<T> &initial, double t, double dt, const SSDerivative<T> &d)
+    template <typename V>
+    SSDerivative<V> evaluate(const SSState<V> &initial, double t, double dt, const SSDerivative<V> &d)
     {
-      SSState<T> state;
+      SSState<V> state;
       state.p = initial.p + d.dp*dt;
       state.v = initial.v + d.dv*dt;
-      SSDerivative<T> output;
+      SSDerivative<V> output;
       output.dp = state.v;
       output.dv = acceleration(state, t+dt);
       return output;
     }
     
-    void integrate(SSState<T> &state, double t, double dt)
+    // integrates a single RK4 step, returning the step's acceleration
+    template <typename V>
+    V integrateStep(SSState<V> &state, double t, double dt)
     {
-      SSDerivative<T> a = evaluate(state, t);
-      SSDerivative<T> b = evaluate(state, t, dt*0.5, a);
-      SSDerivative<T> c = evaluate(state, t, dt*0.5, b);
-      SSDerivative<T> d = evaluate(state, t, dt, c);
+      SSDerivative<V> a = evaluate(state, t);
+      SSDerivative<V> b = evaluate(state, t, dt*0.5, a);
+      SSDerivative<V> c = evaluate(state, t, dt*0.5, b);
+      SSDerivative<V> d = evaluate(state, t, dt, c);
       
-      T dpdt = (a.dp + (b.dp + c.dp)*2.0 + d.dp) * (1.0/6.0);
-      T dvdt = (a.dv + (b.dv + c.dv)*2.0 + d.dv) * (1.0/6.0);
+      V dpdt = (a.dp + (b.dp + c.dp)*2.0 + d.dp) * (1.0/6.0);
+      V dvdt = (a.dv + (b.dv + c.dv)*2.0 + d.dv) * (1.0/6.0);
       
       state.p = state.p + dpdt*dt;
       state.v = state.v + dvdt*dt;
       
-      _lastDv = dvdt;
+      return dvdt;
+    }
+
+    template <typename V>
+    void integrate(SSState<V> &state, double t, double dt)
+    {
+      store(_lastDv, integrateStep(state, t, dt));
     }
     
-    SSState<T> interpolate(const SSState<T> &previous, const SSState<T> &current, double alpha)
+    template <typename V>
+    SSState<V> interpolate(const SSState<V> &previous, const SSState<V> &current, double alpha)
     {
-      SSState<T> state;
+      SSState<V> state;
       state.p = current.p*alpha + previous.p*(1-alpha);
       state.v = current.v*alpha + previous.v*(1-alpha);
       return state;
     }
     
-    void advance(SSState<T> &state, double t, double dt)
+    /**
+     Computes the exact state transition of the damped harmonic oscillator m*x'' + b*x' + k*x = 0 over dt.
+     The transition is linear in the initial state, so the same scalar coefficients apply to every component.
+     */
+    SSTransition transition(double dt)
+    {
+      SSTransition tr;
+      tr.dt = dt;
+
+      double w0 = sqrt(_k / _m);                 // undamped angular frequency
+      double zeta = _b / (2. * sqrt(_k * _m));   // damping ratio
+
+      if (fabs(zeta - 1.) < 1e-6) {
+        // critically damped
+        double e = exp(-w0 * dt);
+        tr.pp = e * (1. + w0 * dt);
+        tr.pv = e * dt;
+        tr.vp = -e * w0 * w0 * dt;
+        tr.vv = e * (1. - w0 * dt);
+      } else if (zeta < 1.) {
+        // underdamped
+        double wd = w0 * sqrt(1. - zeta * zeta);
+        double e = exp(-zeta * w0 * dt);
+        double c = cos(wd * dt);
+        double s = sin(wd * dt);
+        double a = zeta * w0 / wd;
+        tr.pp = e * (c + a * s);
+        tr.pv = e * s / wd;
+        tr.vp = -e * s * w0 * w0 / wd;
+        tr.vv = e * (c - a * s);
+      } else {
+        // overdamped
+        double r = w0 * sqrt(zeta * zeta - 1.);
+        double r1 = -zeta * w0 + r;
+        double r2 = -zeta * w0 - r;
+        double e1 = exp(r1 * dt);
+        double e2 = exp(r2 * dt);
+        double d = r1 - r2;
+        tr.pp = (r1 * e2 - r2 * e1) / d;
+        tr.pv = (e1 - e2) / d;
+        tr.vp = r1 * r2 * (e2 - e1) / d;
+        tr.vv = (r1 * e1 - r2 * e2) / d;
+      }
+      return tr;
+    }
+
+    /**
+     Computes the state transition of a single RK4 step of dt. As the spring is linear, an RK4 step equals
+     the fourth order Taylor expansion of the exact transition: I + hA + (hA)^2/2 + (hA)^3/6 + (hA)^4/24.
+     */
+    SSTransition integratedTransition(double dt)
+    {
+      // A = [0 1; -k/m -b/m], B = hA
+      double b10 = -_k / _m * dt, b11 = -_b / _m * dt;
+
+      // accumulate powers of B and the Taylor sum, starting at I + B
+      double e00 = 0, e01 = dt, e10 = b10, e11 = b11; // B^n
+      double s00 = 1, s01 = dt, s10 = b10, s11 = 1 + b11;
+      double f = 1;
+      for (int n = 2; n <= 4; n++) {
+        double t00 = e01 * b10, t01 = e00 * dt + e01 * b11;
+        double t10 = e11 * b10, t11 = e10 * dt + e11 * b11;
+        e00 = t00; e01 = t01; e10 = t10; e11 = t11;
+        f /= n;
+        s00 += e00 * f; s01 += e01 * f; s10 += e10 * f; s11 += e11 * f;
+      }
+
+      SSTransition tr;
+      tr.dt = dt;
+      tr.pp = s00;
+      tr.pv = s01;
+      tr.vp = s10;
+      tr.vv = s11;
+      return tr;
+    }
+
+    /**
+     Integrates state over dt using Dormand-Prince 5(4), adapting the step size to the error tolerance.
+     Returns the number of steps attempted.
+     */
+    template <typename V>
+    NSUInteger integrateAdaptive(SSState<V> &state, double t, double dt)
+    {
+      static const double c2 = 1./5, c3 = 3./10, c4 = 4./5, c5 = 8./9;
+      static const double a21 = 1./5;
+      static const double a31 = 3./40, a32 = 9./40;
+      static const double a41 = 44./45, a42 = -56./15, a43 = 32./9;
+      static const double a51 = 19372./6561, a52 = -25360./2187, a53 = 64448./6561, a54 = -212./729;
+      static const double a61 = 9017./3168, a62 = -355./33, a63 = 46732./5247, a64 = 49./176, a65 = -5103./18656;
+      static const double a71 = 35./384, a73 = 500./1113, a74 = 125./192, a75 = -2187./6784, a76 = 11./84;
+      static const double e1 = 71./57600, e3 = -71./16695, e4 = 71./1920, e5 = -17253./339200, e6 = 22./525, e7 = -1./40;
+
+      const double tol = tolerance();
+      const double w = sqrt(_k / _m); // weighs velocity error into value units
+      const double minDt = solverDt / 100;
+
+      double h = 0 != _adaptiveDt ? _adaptiveDt : solverDt;
+      double remaining = dt;
+      NSUInteger steps = 0;
+
+      SSDerivative<V> k1 = evaluate(state, t);
+      V dv = k1.dv;
+      while (remaining > 0) {
+        bool last = h >= remaining;
+        double step = last ? remaining : h;
+
+        SSState<V> s;
+        s.p = state.p + k1.dp*(a21*step);
+        s.v = state.v + k1.dv*(a21*step);
+        SSDerivative<V> k2 = evaluate(s, t + c2*step);
+        s.p = state.p + (k1.dp*a31 + k2.dp*a32)*step;
+        s.v = state.v + (k1.dv*a31 + k2.dv*a32)*step;
+        SSDerivative<V> k3 = evaluate(s, t + c3*step);
+        s.p = state.p + (k1.dp*a41 + k2.dp*a42 + k3.dp*a43)*step;
+        s.v = state.v + (k1.dv*a41 + k2.dv*a42 + k3.dv*a43)*step;
+        SSDerivative<V> k4 = evaluate(s, t + c4*step);
+        s.p = state.p + (k1.dp*a51 + k2.dp*a52 + k3.dp*a53 + k4.dp*a54)*step;
+        s.v = state.v + (k1.dv*a51 + k2.dv*a52 + k3.dv*a53 + k4.dv*a54)*step;
+        SSDerivative<V> k5 = evaluate(s, t + c5*step);
+        s.p = state.p + (k1.dp*a61 + k2.dp*a62 + k3.dp*a63 + k4.dp*a64 + k5.dp*a65)*step;
+        s.v = state.v + (k1.dv*a61 + k2.dv*a62 + k3.dv*a63 + k4.dv*a64 + k5.dv*a65)*step;
+        SSDerivative<V> k6 = evaluate(s, t + step);
+
+        // fifth order solution
+        SSState<V> next;
+        next.p = state.p + (k1.dp*a71 + k3.dp*a73 + k4.dp*a74 + k5.dp*a75 + k6.dp*a76)*step;
+        next.v = state.v + (k1.dv*a71 + k3.dv*a73 + k4.dv*a74 + k5.dv*a75 + k6.dv*a76)*step;
+        SSDerivative<V> k7 = evaluate(next, t + step);
+
+        // embedded error estimate
+        V ep = (k1.dp*e1 + k3.dp*e3 + k4.dp*e4 + k5.dp*e5 + k6.dp*e6 + k7.dp*e7)*step;
+        V ev = (k1.dv*e1 + k3.dv*e3 + k4.dv*e4 + k5.dv*e5 + k6.dv*e6 + k7.dv*e7)*step;
+        double err = 0;
+        for (size_t idx = 0; idx < ep.size(); idx++) {
+          err = MAX(err, MAX(fabs(ep(idx)), fabs(ev(idx)) / w));
+        }
+        err /= tol;
+        steps++;
+
+        // scale step size, growing at most 5x and shrinking at most 5x
+        double scale = 0 == err ? 5. : MIN(5., MAX(0.2, 0.9 * pow(err, -0.2)));
+
+        if (err <= 1 || step <= minDt) {
+          // accept; first same as last
+          state = next;
+          k1 = k7;
+          t += step;
+          remaining = last ? 0 : remaining - step;
+          dv = k7.dv;
+
+          // keep the carried step size across a truncated final step
+          if (step >= h) {
+            h = MAX(minDt, step * scale);
+          }
+        } else {
+          h = MAX(minDt, step * scale);
+        }
+      }
+
+      _adaptiveDt = h;
+      store(_lastDv, dv);
+      return steps;
+    }
+
+    template <typename V>
+    SSState<V> transform(const SSState<V> &state, const SSTransition &tr)
+    {
+      SSState<V> output;
+      output.p = state.p * tr.pp + state.v * tr.pv;
+      output.v = state.p * tr.vp + state.v * tr.vv;
+      return output;
+    }
+
+    /**
+     Predicts the time until the spring settles from state, after which hasConverged holds.
+     The spring's energy k*p^2/2 + m*v^2/2 never increases, so the time it falls to the largest energy within the
+     position, velocity and acceleration thresholds is found by bisecting closed form states. Includes the one
+     step the integrated state lags by. Returns INFINITY for undamped springs and -1 for springs without a closed form.
+     */
+    template <typename V>
+    double settleTime(const SSState<V> &state)
+    {
+      if (!canSolveAnalytically()) {
+        return -1;
+      }
+
+      // |p(i)| <= sqrt(2E/k), |v|^2 <= 2E/m and |a|^2 <= 4E(k + b^2/m)/m^2
+      double maxEnergy = MIN(MIN(_k * _tp * _tp, _m * _tv), _ta * _m * _m / (2. * (_k + _b * _b / _m))) / 2.;
+      if (energy(state) <= maxEnergy) {
+        return 0;
+      }
+      if (0 == _b) {
+        return INFINITY;
+      }
+
+      // bracket, then bisect
+      double lo = 0, hi = solverDt;
+      while (energy(transform(state, transition(hi))) > maxEnergy) {
+        lo = hi;
+        hi *= 2;
+        if (hi > kMaxSettleTime) {
+          return INFINITY;
+        }
+      }
+      while (hi - lo > solverDt / 100) {
+        double mid = (lo + hi) / 2;
+        if (energy(transform(state, transition(mid))) > maxEnergy) {
+          lo = mid;
+        } else {
+          hi = mid;
+        }
+      }
+      return hi + solverDt;
+    }
+
+    /**
+     Predicts the peak overshoot of each component of state, the largest distance it travels past zero on the side
+     opposite to where it starts. Components starting at zero start on the side of their velocity. Returns zero for
+     components that do not overshoot, and for springs without a closed form.
+     */
+    template <typename V>
+    V peakOvershoot(const SSState<V> &state)
+    {
+      V overshoot = V::Zero();
+      if (canSolveAnalytically()) {
+        for (size_t idx = 0; idx < overshoot.size(); idx++) {
+          overshoot(idx) = this->overshoot(state.p(idx), state.v(idx));
+        }
+      }
+      return overshoot;
+    }
+
+    template <typename V>
+    void advance(SSState<V> &state, double t, double dt)
     {
       _started = true;
+      _stepCount = 0;
       
-      if (dt > maxSolverDt) {
+      if (dt > maxSolverDt && 0 == _maxSteps) {
         // excessive time step, force shut down
         _lastDv = _lastState.v = _lastState.p = T::Zero();
       } else {
         _accumulatedTime += dt;
         
-        SSState<T> previousState = state, currentState = state;
-        while (_accumulatedTime >= solverDt) {
+        SSState<V> previousState = state, currentState = state;
+        long steps = (long)floor(_accumulatedTime / solverDt);
+        bool overBudget = 0 != _maxSteps && steps > (long)_maxSteps;
+
+        if ((kSpringSolverModeAnalytic == _mode || overBudget) && canSolveAnalytically()) {
+          // consume time in solverDt steps like the integrator, evaluating the steps in closed form
+          if (steps > 0) {
+            if (solverDt != _transition.dt) {
+              _transition = transition(solverDt);
+            }
+            previousState = transform(state, transition((steps - 1) * solverDt));
+            currentState = transform(previousState, _transition);
+            store(_lastDv, acceleration(currentState, t));
+            _accumulatedTime -= steps * solverDt;
+          }
+        } else if (kSpringSolverModeCached == _mode && _table && steps < (long)_table->size()) {
+          // look up the last two steps, the same states integration computes
+          if (steps > 0) {
+            previousState = transform(state, (*_table)[steps - 1]);
+            currentState = transform(state, (*_table)[steps]);
+            store(_lastDv, (currentState.v - previousState.v) * (1. / solverDt));
+            _accumulatedTime -= steps * solverDt;
+          }
+        } else if (kSpringSolverModeAdaptive == _mode && canSolveAnalytically()) {
+          // integrate to the time represented by the integrator's interpolated state
+          if (steps > 0) {
+            _accumulatedTime -= steps * solverDt;
+            _stepCount = integrateAdaptive(currentState, t, (steps - 1) * solverDt + _accumulatedTime);
+            previousState = currentState;
+          }
+        } else if (overBudget) {
+          // coarse fallback, spreading the budget of steps over the time represented by the interpolated state;
+          // steps beyond the stability limit would diverge, so the spring instead falls behind by the time left over
+          _accumulatedTime -= steps * solverDt;
+          double coarseDt = MIN(((steps - 1) * solverDt + _accumulatedTime) / _maxSteps, maxStableDt());
+          for (NSUInteger idx = 0; idx < _maxSteps; idx++) {
+            this->integrate(currentState, t, coarseDt);
+            t += coarseDt;
+          }
           previousState = currentState;
-          this->integrate(currentState, t, solverDt);
-          t += solverDt;
-          _accumulatedTime -= solverDt;
+          _stepCount = _maxSteps;
+        } else if (_accumulatedTime >= solverDt) {
+          V dv;
+          while (_accumulatedTime >= solverDt) {
+            previousState = currentState;
+            dv = this->integrateStep(currentState, t, solverDt);
+            t += solverDt;
+            _accumulatedTime -= solverDt;
+            _stepCount++;
+          }
+          store(_lastDv, dv);
         }
         CFTimeInterval alpha = _accumulatedTime / solverDt;
-        _lastState = state = this->interpolate(previousState, currentState, alpha);
+        state = this->interpolate(previousState, currentState, alpha);
+        store(_lastState.p, state.p);
+        store(_lastState.v, state.v);
       }
     }
     
@@ -173,6 +708,8 @@ namespace POP {
     void reset()
     {
       _accumulatedTime = 0;
+      _adaptiveDt = 0;
+      _stepCount = 0;
       _lastState.p = T::Zero();
       _lastState.v = T::Zero();
       _lastDv = T::Zero();
@@ -183,6 +720,7 @@ namespace POP {
   /**
    Convenience spring solver type definitions.
    */
+  typedef SpringSolver<Vector1d> SpringSolver1d;
   typedef SpringSolver<Vector2d> SpringSolver2d;
   typedef SpringSolver<Vector3d> SpringSolver3d;
   typedef SpringSolver<Vector4d> SpringSolver4d;
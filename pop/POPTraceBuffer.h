@@ -0,0 +1,246 @@
+/**
+ Copyright (c) 2014-present, Facebook, Inc.
+ All rights reserved.
+
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree. An additional grant
+ of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#ifndef __POP__FBTraceBuffer__
+#define __POP__FBTraceBuffer__
+
+#ifdef __cplusplus
+
+#include <atomic>
+#include <cinttypes>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace POP {
+
+  enum TraceEventType
+  {
+    kTraceEventFrame,   // values[0] is the frame duration
+    kTraceEventAdd,
+    kTraceEventStart,
+    kTraceEventStop,    // values[0] is 1 when finished
+    kTraceEventWrite,   // values are the written value
+    kTraceEventTypeCount,
+  };
+
+  /**
+   Fixed size binary trace event.
+   */
+  struct TraceEvent
+  {
+    double time;            // seconds
+    uint64_t animationId;   // zero for frames
+    uint8_t type;           // TraceEventType
+    uint8_t animationType;
+    uint8_t valueCount;
+    double values[4];
+  };
+
+  /**
+   Lock-free ring buffer of trace events, overwriting the oldest events when full.
+   Any thread records without locking or allocating: a writer claims a slot by sequence number, and readers
+   copy slots optimistically, discarding those changed while read. An event is dropped only when its slot is
+   still being written a full buffer of events earlier. Plain C++, no platform dependencies.
+   */
+  class TraceBuffer
+  {
+    static const size_t kWords = 7;
+
+    struct Slot
+    {
+      std::atomic<uint64_t> sequence; // 2 * position + 1 while written, 2 * position + 2 once written
+      std::atomic<uint64_t> words[kWords];
+    };
+
+    std::unique_ptr<Slot[]> _slots;
+    size_t _mask;
+    std::atomic<uint64_t> _head;    // next position
+    std::atomic<uint64_t> _start;   // first position after the last clear
+    std::atomic<uint64_t> _dropped;
+
+    TraceBuffer(const TraceBuffer &) = delete;
+    TraceBuffer &operator=(const TraceBuffer &) = delete;
+
+    static uint64_t bits(double value)
+    {
+      uint64_t word;
+      memcpy(&word, &value, sizeof(word));
+      return word;
+    }
+
+    static double value(uint64_t word)
+    {
+      double value;
+      memcpy(&value, &word, sizeof(value));
+      return value;
+    }
+
+  public:
+    // Capacity of a buffer created with the specified capacity, the next power of two
+    static size_t roundedCapacity(size_t capacity)
+    {
+      size_t size = 1;
+      while (size < capacity) {
+        size <<= 1;
+      }
+      return size;
+    }
+
+    explicit TraceBuffer(size_t capacity) : _head(0), _start(0), _dropped(0)
+    {
+      size_t size = roundedCapacity(capacity);
+      _slots.reset(new Slot[size]);
+      _mask = size - 1;
+      for (size_t idx = 0; idx < size; idx++) {
+        _slots[idx].sequence.store(0, std::memory_order_relaxed);
+      }
+    }
+
+    size_t capacity() const { return _mask + 1; }
+
+    // Events dropped by lapped writers
+    uint64_t droppedCount() const { return _dropped.load(std::memory_order_relaxed); }
+
+    // Records an event; any thread
+    void record(const TraceEvent &event)
+    {
+      uint64_t position = _head.fetch_add(1, std::memory_order_relaxed);
+      Slot &slot = _slots[position & _mask];
+
+      // claim the slot unless a writer is in it or has lapped this one
+      uint64_t writing = 2 * position + 1;
+      uint64_t sequence = slot.sequence.load(std::memory_order_relaxed);
+      do {
+        if ((sequence & 1) || sequence > writing) {
+          _dropped.fetch_add(1, std::memory_order_relaxed);
+          return;
+        }
+      } while (!slot.sequence.compare_exchange_weak(sequence, writing, std::memory_order_acquire, std::memory_order_relaxed));
+      std::atomic_thread_fence(std::memory_order_release);
+
+      uint64_t header = (uint64_t)event.type | ((uint64_t)event.animationType << 8) | ((uint64_t)event.valueCount << 16);
+      slot.words[0].store(bits(event.time), std::memory_order_relaxed);
+      slot.words[1].store(event.animationId, std::memory_order_relaxed);
+      slot.words[2].store(header, std::memory_order_relaxed);
+      for (size_t idx = 0; idx < 4; idx++) {
+        slot.words[3 + idx].store(bits(event.values[idx]), std::memory_order_relaxed);
+      }
+      slot.sequence.store(writing + 1, std::memory_order_release);
+    }
+
+    // Discards recorded events
+    void clear()
+    {
+      _start.store(_head.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    // Copies recorded events, oldest first, skipping events written meanwhile
+    void copyEvents(std::vector<TraceEvent> &events) const
+    {
+      uint64_t head = _head.load(std::memory_order_acquire);
+      uint64_t start = _start.load(std::memory_order_relaxed);
+      if (head - start > capacity()) {
+        start = head - capacity();
+      }
+
+      for (uint64_t position = start; position < head; position++) {
+        const Slot &slot = _slots[position & _mask];
+        uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence != 2 * position + 2) {
+          continue;
+        }
+
+        uint64_t words[kWords];
+        for (size_t idx = 0; idx < kWords; idx++) {
+          words[idx] = slot.words[idx].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence != slot.sequence.load(std::memory_order_relaxed)) {
+          continue;
+        }
+
+        TraceEvent event;
+        event.time = value(words[0]);
+        event.animationId = words[1];
+        event.type = (uint8_t)words[2];
+        event.animationType = (uint8_t)(words[2] >> 8);
+        event.valueCount = (uint8_t)(words[2] >> 16);
+        for (size_t idx = 0; idx < 4; idx++) {
+          event.values[idx] = value(words[3 + idx]);
+        }
+        events.push_back(event);
+      }
+    }
+  };
+
+  inline double finite(double value)
+  {
+    // JSON has no infinities or NaN
+    return std::isfinite(value) ? value : 0;
+  }
+
+  /**
+   Formats events as Chrome trace event JSON, loadable by chrome://tracing and Perfetto. Frames are complete
+   events; each animation is an async slice from start to stop, named by animation type, with adds and writes
+   as instant events. Times are relative to the first event.
+   */
+  inline std::string chromeTraceJSON(const std::vector<TraceEvent> &events, const char *const *animationTypeNames, size_t animationTypeCount)
+  {
+    std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    double origin = events.empty() ? 0 : events.front().time;
+    char buffer[384];
+
+    for (size_t idx = 0; idx < events.size(); idx++) {
+      const TraceEvent &event = events[idx];
+      double ts = (event.time - origin) * 1e6;
+      const char *name = event.animationType < animationTypeCount ? animationTypeNames[event.animationType] : "animation";
+      int length = 0;
+
+      switch (event.type) {
+        case kTraceEventFrame:
+          length = snprintf(buffer, sizeof(buffer), "{\"name\":\"frame\",\"cat\":\"animator\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f}", ts, event.values[0] * 1e6);
+          break;
+        case kTraceEventAdd:
+          length = snprintf(buffer, sizeof(buffer), "{\"name\":\"add\",\"cat\":\"animation\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"args\":{\"id\":%" PRIu64 ",\"type\":\"%s\"}}", ts, event.animationId, name);
+          break;
+        case kTraceEventStart:
+          length = snprintf(buffer, sizeof(buffer), "{\"name\":\"%s\",\"cat\":\"animation\",\"ph\":\"b\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"id\":\"0x%" PRIx64 "\"}", name, ts, event.animationId);
+          break;
+        case kTraceEventStop:
+          length = snprintf(buffer, sizeof(buffer), "{\"name\":\"%s\",\"cat\":\"animation\",\"ph\":\"e\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"id\":\"0x%" PRIx64 "\",\"args\":{\"finished\":%s}}", name, ts, event.animationId, 0 != event.values[0] ? "true" : "false");
+          break;
+        case kTraceEventWrite:
+          length = snprintf(buffer, sizeof(buffer), "{\"name\":\"write\",\"cat\":\"animation\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"args\":{\"id\":%" PRIu64 ",\"value\":[%g,%g,%g,%g],\"count\":%u}}", ts, event.animationId, finite(event.values[0]), finite(event.values[1]), finite(event.values[2]), finite(event.values[3]), (unsigned)event.valueCount);
+          break;
+        default:
+          continue;
+      }
+
+      if (length > 0) {
+        if (json.back() != '[') {
+          json += ",";
+        }
+        json.append(buffer, (size_t)length < sizeof(buffer) ? (size_t)length : sizeof(buffer) - 1);
+      }
+    }
+
+    json += "]}";
+    return json;
+  }
+
+}
+
+#endif /* __cplusplus */
+#endif /* defined(__POP__FBTraceBuffer__) */
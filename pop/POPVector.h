@@ -12,6 +12,7 @@
 
 #ifdef __cplusplus
 
+#include <cstddef>
 #include <iostream>
 #include <vector>
 
@@ -30,17 +31,94 @@
 #import <UIKit/UIKit.h>
 #endif
 
+#if !defined(POP_VECTOR_NO_SIMD)
+#if defined(__AVX__)
+#include <immintrin.h>
+#define POP_VECTOR_AVX 1
+#endif
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define POP_VECTOR_SSE2 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define POP_VECTOR_NEON 1
+#endif
+#endif
+
 namespace POP {
 
-  /** Fixed two-size vector class */
+  /** Fixed one-size vector class */
   template <typename T>
-  struct Vector2
+  struct Vector1
   {
-  private:
-    typedef T Vector2<T>::* const _data[2];
-    static const _data _v;
+    T x;
 
-  public:
+    // Zero vector
+    static const Vector1 Zero() { return Vector1(0); }
+
+    // Constructors
+    Vector1() {}
+    explicit Vector1(T v) : x(v) {};
+
+    // Copy constructor
+    template<typename U> explicit Vector1(const Vector1<U> &v) : x(v.x) {}
+
+    // Index operators
+    const T& operator[](size_t i) const { return data()[i]; }
+    T& operator[](size_t i) { return data()[i]; }
+    const T& operator()(size_t i) const { return data()[i]; }
+    T& operator()(size_t i) { return data()[i]; }
+
+    // Backing data
+    T * data() { return &x; }
+    const T * data() const { return &x; }
+
+    // Size
+    inline size_t size() const { return 1; }
+
+    // Assignment
+    Vector1 &operator= (T v) { x = v; return *this;}
+    template<typename U> Vector1 &operator= (const Vector1<U> &v) { x = v.x; return *this;}
+
+    // Negation
+    Vector1 operator- (void) const { return Vector1<T>(-x); }
+
+    // Equality
+    bool operator== (T v) const { return (x == v); }
+    bool operator== (const Vector1 &v) const { return (x == v.x); }
+
+    // Inequality
+    bool operator!= (T v) const {return (x != v); }
+    bool operator!= (const Vector1 &v) const { return (x != v.x); }
+
+    // Scalar Math
+    Vector1 operator+ (T v) const { return Vector1(x + v); }
+    Vector1 operator- (T v) const { return Vector1(x - v); }
+    Vector1 operator* (T v) const { return Vector1(x * v); }
+    Vector1 operator/ (T v) const { return Vector1(x / v); }
+    Vector1 &operator+= (T v) { x += v; return *this; };
+    Vector1 &operator-= (T v) { x -= v; return *this; };
+    Vector1 &operator*= (T v) { x *= v; return *this; };
+    Vector1 &operator/= (T v) { x /= v; return *this; };
+
+    // Vector Math
+    Vector1 operator+ (const Vector1 &v) const { return Vector1(x + v.x); }
+    Vector1 operator- (const Vector1 &v) const { return Vector1(x - v.x); }
+    Vector1 &operator+= (const Vector1 &v) { x += v.x; return *this; };
+    Vector1 &operator-= (const Vector1 &v) { x -= v.x; return *this; };
+
+    // Norms
+    CGFloat norm() const { return sqrtr(squaredNorm()); }
+    CGFloat squaredNorm() const { return x * x; }
+
+    // Cast
+    template<typename U> Vector1<U> cast() const { return Vector1<U>(x); }
+  };
+
+  /** Fixed two-size vector class, stored contiguously */
+  template <typename T>
+  struct alignas(2 * sizeof(T)) Vector2
+  {
     T x;
     T y;
 
@@ -58,14 +136,14 @@ namespace POP {
     template<typename U> explicit Vector2(const Vector2<U> &v) : x(v.x), y(v.y) {}
 
     // Index operators
-    const T& operator[](size_t i) const { return this->*_v[i]; }
-    T& operator[](size_t i) { return this->*_v[i]; }
-    const T& operator()(size_t i) const { return this->*_v[i]; }
-    T& operator()(size_t i) { return this->*_v[i]; }
+    const T& operator[](size_t i) const { return data()[i]; }
+    T& operator[](size_t i) { return data()[i]; }
+    const T& operator()(size_t i) const { return data()[i]; }
+    T& operator()(size_t i) { return data()[i]; }
 
     // Backing data
-    T * data() { return &(this->*_v[0]); }
-    const T * data() const { return &(this->*_v[0]); }
+    T * data() { return &x; }
+    const T * data() const { return &x; }
 
     // Size
     inline size_t size() const { return 2; }
@@ -110,18 +188,10 @@ namespace POP {
     CGPoint cg_point() const { return CGPointMake(x, y); };
   };
 
-  template<typename T>
-  const typename Vector2<T>::_data Vector2<T>::_v = { &Vector2<T>::x, &Vector2<T>::y };
-
-  /** Fixed three-size vector class */
+  /** Fixed three-size vector class, stored contiguously */
   template <typename T>
   struct Vector3
   {
-  private:
-    typedef T Vector3<T>::* const _data[3];
-    static const _data _v;
-
-  public:
     T x;
     T y;
     T z;
@@ -138,14 +208,14 @@ namespace POP {
     template<typename U> explicit Vector3(const Vector3<U> &v) : x(v.x), y(v.y), z(v.z) {}
 
     // Index operators
-    const T& operator[](size_t i) const { return this->*_v[i]; }
-    T& operator[](size_t i) { return this->*_v[i]; }
-    const T& operator()(size_t i) const { return this->*_v[i]; }
-    T& operator()(size_t i) { return this->*_v[i]; }
+    const T& operator[](size_t i) const { return data()[i]; }
+    T& operator[](size_t i) { return data()[i]; }
+    const T& operator()(size_t i) const { return data()[i]; }
+    T& operator()(size_t i) { return data()[i]; }
 
     // Backing data
-    T * data() { return &(this->*_v[0]); }
-    const T * data() const { return &(this->*_v[0]); }
+    T * data() { return &x; }
+    const T * data() const { return &x; }
 
     // Size
     inline size_t size() const { return 3; }
@@ -158,7 +228,7 @@ namespace POP {
     Vector3 operator- (void) const { return Vector3<T>(-x, -y, -z); }
 
     // Equality
-    bool operator== (T v) const { return (x == v && y == v && z = v); }
+    bool operator== (T v) const { return (x == v && y == v && z == v); }
     bool operator== (const Vector3 &v) const { return (x == v.x && y == v.y && z == v.z); }
 
     // Inequality
@@ -189,18 +259,182 @@ namespace POP {
     template<typename U> Vector3<U> cast() const { return Vector3<U>(x, y, z); }
   };
 
-  template<typename T>
-  const typename Vector3<T>::_data Vector3<T>::_v = { &Vector3<T>::x, &Vector3<T>::y, &Vector3<T>::z };
-
-  /** Fixed four-size vector class */
+  /**
+   Component-wise arithmetic of four contiguous values, backing Vector4.
+   Specialized for double and float with AVX, SSE2 or NEON when available. Define POP_VECTOR_NO_SIMD to use the
+   scalar loops, eg to compare against them.
+   */
   template <typename T>
-  struct Vector4
+  struct Vector4Ops
   {
-  private:
-    typedef T Vector4<T>::* const _data[4];
-    static const _data _v;
+    static void add(T *r, const T *a, const T *b) { for (size_t i = 0; i < 4; i++) r[i] = a[i] + b[i]; }
+    static void sub(T *r, const T *a, const T *b) { for (size_t i = 0; i < 4; i++) r[i] = a[i] - b[i]; }
+    static void add(T *r, const T *a, T s) { for (size_t i = 0; i < 4; i++) r[i] = a[i] + s; }
+    static void sub(T *r, const T *a, T s) { for (size_t i = 0; i < 4; i++) r[i] = a[i] - s; }
+    static void mul(T *r, const T *a, T s) { for (size_t i = 0; i < 4; i++) r[i] = a[i] * s; }
+    static void div(T *r, const T *a, T s) { for (size_t i = 0; i < 4; i++) r[i] = a[i] / s; }
+    static T squaredNorm(const T *a) { return (a[0] * a[0] + a[1] * a[1]) + (a[2] * a[2] + a[3] * a[3]); }
+  };
 
-  public:
+#if POP_VECTOR_AVX
+  template <>
+  struct Vector4Ops<double>
+  {
+    static void add(double *r, const double *a, const double *b) { _mm256_storeu_pd(r, _mm256_add_pd(_mm256_loadu_pd(a), _mm256_loadu_pd(b))); }
+    static void sub(double *r, const double *a, const double *b) { _mm256_storeu_pd(r, _mm256_sub_pd(_mm256_loadu_pd(a), _mm256_loadu_pd(b))); }
+    static void add(double *r, const double *a, double s) { _mm256_storeu_pd(r, _mm256_add_pd(_mm256_loadu_pd(a), _mm256_set1_pd(s))); }
+    static void sub(double *r, const double *a, double s) { _mm256_storeu_pd(r, _mm256_sub_pd(_mm256_loadu_pd(a), _mm256_set1_pd(s))); }
+    static void mul(double *r, const double *a, double s) { _mm256_storeu_pd(r, _mm256_mul_pd(_mm256_loadu_pd(a), _mm256_set1_pd(s))); }
+    static void div(double *r, const double *a, double s) { _mm256_storeu_pd(r, _mm256_div_pd(_mm256_loadu_pd(a), _mm256_set1_pd(s))); }
+    static double squaredNorm(const double *a)
+    {
+      __m256d v = _mm256_loadu_pd(a);
+      __m256d p = _mm256_mul_pd(v, v);
+      __m128d h = _mm_hadd_pd(_mm256_castpd256_pd128(p), _mm256_extractf128_pd(p, 1));
+      return _mm_cvtsd_f64(_mm_add_sd(h, _mm_unpackhi_pd(h, h)));
+    }
+  };
+#elif POP_VECTOR_SSE2
+  template <>
+  struct Vector4Ops<double>
+  {
+    static void add(double *r, const double *a, const double *b)
+    {
+      _mm_storeu_pd(r, _mm_add_pd(_mm_loadu_pd(a), _mm_loadu_pd(b)));
+      _mm_storeu_pd(r + 2, _mm_add_pd(_mm_loadu_pd(a + 2), _mm_loadu_pd(b + 2)));
+    }
+    static void sub(double *r, const double *a, const double *b)
+    {
+      _mm_storeu_pd(r, _mm_sub_pd(_mm_loadu_pd(a), _mm_loadu_pd(b)));
+      _mm_storeu_pd(r + 2, _mm_sub_pd(_mm_loadu_pd(a + 2), _mm_loadu_pd(b + 2)));
+    }
+    static void add(double *r, const double *a, double s)
+    {
+      __m128d v = _mm_set1_pd(s);
+      _mm_storeu_pd(r, _mm_add_pd(_mm_loadu_pd(a), v));
+      _mm_storeu_pd(r + 2, _mm_add_pd(_mm_loadu_pd(a + 2), v));
+    }
+    static void sub(double *r, const double *a, double s)
+    {
+      __m128d v = _mm_set1_pd(s);
+      _mm_storeu_pd(r, _mm_sub_pd(_mm_loadu_pd(a), v));
+      _mm_storeu_pd(r + 2, _mm_sub_pd(_mm_loadu_pd(a + 2), v));
+    }
+    static void mul(double *r, const double *a, double s)
+    {
+      __m128d v = _mm_set1_pd(s);
+      _mm_storeu_pd(r, _mm_mul_pd(_mm_loadu_pd(a), v));
+      _mm_storeu_pd(r + 2, _mm_mul_pd(_mm_loadu_pd(a + 2), v));
+    }
+    static void div(double *r, const double *a, double s)
+    {
+      __m128d v = _mm_set1_pd(s);
+      _mm_storeu_pd(r, _mm_div_pd(_mm_loadu_pd(a), v));
+      _mm_storeu_pd(r + 2, _mm_div_pd(_mm_loadu_pd(a + 2), v));
+    }
+    static double squaredNorm(const double *a)
+    {
+      __m128d lo = _mm_loadu_pd(a), hi = _mm_loadu_pd(a + 2);
+      lo = _mm_mul_pd(lo, lo);
+      hi = _mm_mul_pd(hi, hi);
+      lo = _mm_add_sd(lo, _mm_unpackhi_pd(lo, lo));
+      hi = _mm_add_sd(hi, _mm_unpackhi_pd(hi, hi));
+      return _mm_cvtsd_f64(_mm_add_sd(lo, hi));
+    }
+  };
+#elif POP_VECTOR_NEON && defined(__aarch64__)
+  template <>
+  struct Vector4Ops<double>
+  {
+    static void add(double *r, const double *a, const double *b)
+    {
+      vst1q_f64(r, vaddq_f64(vld1q_f64(a), vld1q_f64(b)));
+      vst1q_f64(r + 2, vaddq_f64(vld1q_f64(a + 2), vld1q_f64(b + 2)));
+    }
+    static void sub(double *r, const double *a, const double *b)
+    {
+      vst1q_f64(r, vsubq_f64(vld1q_f64(a), vld1q_f64(b)));
+      vst1q_f64(r + 2, vsubq_f64(vld1q_f64(a + 2), vld1q_f64(b + 2)));
+    }
+    static void add(double *r, const double *a, double s)
+    {
+      float64x2_t v = vdupq_n_f64(s);
+      vst1q_f64(r, vaddq_f64(vld1q_f64(a), v));
+      vst1q_f64(r + 2, vaddq_f64(vld1q_f64(a + 2), v));
+    }
+    static void sub(double *r, const double *a, double s)
+    {
+      float64x2_t v = vdupq_n_f64(s);
+      vst1q_f64(r, vsubq_f64(vld1q_f64(a), v));
+      vst1q_f64(r + 2, vsubq_f64(vld1q_f64(a + 2), v));
+    }
+    static void mul(double *r, const double *a, double s)
+    {
+      vst1q_f64(r, vmulq_n_f64(vld1q_f64(a), s));
+      vst1q_f64(r + 2, vmulq_n_f64(vld1q_f64(a + 2), s));
+    }
+    static void div(double *r, const double *a, double s)
+    {
+      float64x2_t v = vdupq_n_f64(s);
+      vst1q_f64(r, vdivq_f64(vld1q_f64(a), v));
+      vst1q_f64(r + 2, vdivq_f64(vld1q_f64(a + 2), v));
+    }
+    static double squaredNorm(const double *a)
+    {
+      float64x2_t lo = vld1q_f64(a), hi = vld1q_f64(a + 2);
+      return vaddvq_f64(vmulq_f64(lo, lo)) + vaddvq_f64(vmulq_f64(hi, hi));
+    }
+  };
+#endif
+
+#if POP_VECTOR_SSE2
+  template <>
+  struct Vector4Ops<float>
+  {
+    static void add(float *r, const float *a, const float *b) { _mm_storeu_ps(r, _mm_add_ps(_mm_loadu_ps(a), _mm_loadu_ps(b))); }
+    static void sub(float *r, const float *a, const float *b) { _mm_storeu_ps(r, _mm_sub_ps(_mm_loadu_ps(a), _mm_loadu_ps(b))); }
+    static void add(float *r, const float *a, float s) { _mm_storeu_ps(r, _mm_add_ps(_mm_loadu_ps(a), _mm_set1_ps(s))); }
+    static void sub(float *r, const float *a, float s) { _mm_storeu_ps(r, _mm_sub_ps(_mm_loadu_ps(a), _mm_set1_ps(s))); }
+    static void mul(float *r, const float *a, float s) { _mm_storeu_ps(r, _mm_mul_ps(_mm_loadu_ps(a), _mm_set1_ps(s))); }
+    static void div(float *r, const float *a, float s) { _mm_storeu_ps(r, _mm_div_ps(_mm_loadu_ps(a), _mm_set1_ps(s))); }
+    static float squaredNorm(const float *a)
+    {
+      __m128 v = _mm_loadu_ps(a);
+      __m128 p = _mm_mul_ps(v, v);
+      __m128 h = _mm_add_ps(p, _mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 3, 0, 1)));
+      return _mm_cvtss_f32(_mm_add_ss(h, _mm_movehl_ps(h, h)));
+    }
+  };
+#elif POP_VECTOR_NEON
+  template <>
+  struct Vector4Ops<float>
+  {
+    static void add(float *r, const float *a, const float *b) { vst1q_f32(r, vaddq_f32(vld1q_f32(a), vld1q_f32(b))); }
+    static void sub(float *r, const float *a, const float *b) { vst1q_f32(r, vsubq_f32(vld1q_f32(a), vld1q_f32(b))); }
+    static void add(float *r, const float *a, float s) { vst1q_f32(r, vaddq_f32(vld1q_f32(a), vdupq_n_f32(s))); }
+    static void sub(float *r, const float *a, float s) { vst1q_f32(r, vsubq_f32(vld1q_f32(a), vdupq_n_f32(s))); }
+    static void mul(float *r, const float *a, float s) { vst1q_f32(r, vmulq_n_f32(vld1q_f32(a), s)); }
+    static void div(float *r, const float *a, float s)
+    {
+#if defined(__aarch64__)
+      vst1q_f32(r, vdivq_f32(vld1q_f32(a), vdupq_n_f32(s)));
+#else
+      for (size_t i = 0; i < 4; i++) r[i] = a[i] / s;
+#endif
+    }
+    static float squaredNorm(const float *a)
+    {
+      float32x4_t v = vld1q_f32(a);
+      float32x2_t p = vpadd_f32(vget_low_f32(vmulq_f32(v, v)), vget_high_f32(vmulq_f32(v, v)));
+      return vget_lane_f32(p, 0) + vget_lane_f32(p, 1);
+    }
+  };
+#endif
+
+  /** Fixed four-size vector class, stored contiguously */
+  template <typename T>
+  struct alignas(4 * sizeof(T) < 16 ? 4 * sizeof(T) : 16) Vector4
+  {
     T x;
     T y;
     T z;
@@ -218,14 +452,14 @@ namespace POP {
     template<typename U> explicit Vector4(const Vector4<U> &v) : x(v.x), y(v.y), z(v.z), w(v.w) {}
 
     // Index operators
-    const T& operator[](size_t i) const { return this->*_v[i]; }
-    T& operator[](size_t i) { return this->*_v[i]; }
-    const T& operator()(size_t i) const { return this->*_v[i]; }
-    T& operator()(size_t i) { return this->*_v[i]; }
+    const T& operator[](size_t i) const { return data()[i]; }
+    T& operator[](size_t i) { return data()[i]; }
+    const T& operator()(size_t i) const { return data()[i]; }
+    T& operator()(size_t i) { return data()[i]; }
 
     // Backing data
-    T * data() { return &(this->*_v[0]); }
-    const T * data() const { return &(this->*_v[0]); }
+    T * data() { return &x; }
+    const T * data() const { return &x; }
 
     // Size
     inline size_t size() const { return 4; }
@@ -238,7 +472,7 @@ namespace POP {
     Vector4 operator- (void) const { return Vector4<T>(-x, -y, -z, -w); }
 
     // Equality
-    bool operator== (T v) const { return (x == v && y == v && z = v, w = v); }
+    bool operator== (T v) const { return (x == v && y == v && z == v && w == v); }
     bool operator== (const Vector4 &v) const { return (x == v.x && y == v.y && z == v.z && w == v.w); }
 
     // Inequality
@@ -246,33 +480,33 @@ namespace POP {
     bool operator!= (const Vector4 &v) const { return (x != v.x || y != v.y || z != v.z || w != v.w); }
 
     // Scalar Math
-    Vector4 operator+ (T v) const { return Vector4(x + v, y + v, z + v, w + v); }
-    Vector4 operator- (T v) const { return Vector4(x - v, y - v, z - v, w - v); }
-    Vector4 operator* (T v) const { return Vector4(x * v, y * v, z * v, w * v); }
-    Vector4 operator/ (T v) const { return Vector4(x / v, y / v, z / v, w / v); }
-    Vector4 &operator+= (T v) { x += v; y += v; z += v; w += v; return *this; };
-    Vector4 &operator-= (T v) { x -= v; y -= v; z -= v; w -= v; return *this; };
-    Vector4 &operator*= (T v) { x *= v; y *= v; z *= v; w *= v; return *this; };
-    Vector4 &operator/= (T v) { x /= v; y /= v; z /= v; w /= v; return *this; };
+    Vector4 operator+ (T v) const { Vector4 r; Vector4Ops<T>::add(r.data(), data(), v); return r; }
+    Vector4 operator- (T v) const { Vector4 r; Vector4Ops<T>::sub(r.data(), data(), v); return r; }
+    Vector4 operator* (T v) const { Vector4 r; Vector4Ops<T>::mul(r.data(), data(), v); return r; }
+    Vector4 operator/ (T v) const { Vector4 r; Vector4Ops<T>::div(r.data(), data(), v); return r; }
+    Vector4 &operator+= (T v) { Vector4Ops<T>::add(data(), data(), v); return *this; };
+    Vector4 &operator-= (T v) { Vector4Ops<T>::sub(data(), data(), v); return *this; };
+    Vector4 &operator*= (T v) { Vector4Ops<T>::mul(data(), data(), v); return *this; };
+    Vector4 &operator/= (T v) { Vector4Ops<T>::div(data(), data(), v); return *this; };
 
     // Vector Math
-    Vector4 operator+ (const Vector4 &v) const { return Vector4(x + v.x, y + v.y, z + v.z, w + v.w); }
-    Vector4 operator- (const Vector4 &v) const { return Vector4(x - v.x, y - v.y, z - v.z, w - v.w); }
-    Vector4 &operator+= (const Vector4 &v) { x += v.x; y += v.y; z += v.z; w += v.w; return *this; };
-    Vector4 &operator-= (const Vector4 &v) { x -= v.x; y -= v.y; z -= v.z; w -= v.w; return *this; };
+    Vector4 operator+ (const Vector4 &v) const { Vector4 r; Vector4Ops<T>::add(r.data(), data(), v.data()); return r; }
+    Vector4 operator- (const Vector4 &v) const { Vector4 r; Vector4Ops<T>::sub(r.data(), data(), v.data()); return r; }
+    Vector4 &operator+= (const Vector4 &v) { Vector4Ops<T>::add(data(), data(), v.data()); return *this; };
+    Vector4 &operator-= (const Vector4 &v) { Vector4Ops<T>::sub(data(), data(), v.data()); return *this; };
 
     // Norms
     CGFloat norm() const { return sqrtr(squaredNorm()); }
-    CGFloat squaredNorm() const { return x * x + y * y + z * z + w * w; }
+    CGFloat squaredNorm() const { return Vector4Ops<T>::squaredNorm(data()); }
 
     // Cast
     template<typename U> Vector4<U> cast() const { return Vector4<U>(x, y, z, w); }
   };
 
-  template<typename T>
-  const typename Vector4<T>::_data Vector4<T>::_v = { &Vector4<T>::x, &Vector4<T>::y, &Vector4<T>::z, &Vector4<T>::w };
-
   /** Convenience typedefs */
+  typedef Vector1<float> Vector1f;
+  typedef Vector1<double> Vector1d;
+  typedef Vector1<CGFloat> Vector1r;
   typedef Vector2<float> Vector2f;
   typedef Vector2<double> Vector2d;
   typedef Vector2<CGFloat> Vector2r;
@@ -283,27 +517,38 @@ namespace POP {
   typedef Vector4<double> Vector4d;
   typedef Vector4<CGFloat> Vector4r;
 
-  /** Variable-sized vector class */
+  // components are indexed as contiguous arrays
+  static_assert(sizeof(Vector2d) == 2 * sizeof(double) && sizeof(Vector3d) == 3 * sizeof(double) && sizeof(Vector4d) == 4 * sizeof(double), "unexpected vector padding");
+  static_assert(sizeof(Vector2f) == 2 * sizeof(float) && sizeof(Vector3f) == 3 * sizeof(float) && sizeof(Vector4f) == 4 * sizeof(float), "unexpected vector padding");
+
+  /** Variable-sized vector class, storing up to kCapacity values inline */
   class Vector
   {
-    size_t _count;
-    CGFloat *_values;
+  public:
+    // Maximal number of values, enough for a 4x4 matrix
+    static const size_t kCapacity = 16;
 
   private:
-    Vector(size_t);
-    Vector(const Vector& other);
+    size_t _count;
+    CGFloat _values[kCapacity];
 
   public:
-    ~Vector();
+    // Creates an empty vector
+    Vector() : _count(0) {}
+
+    // Creates a vector of count zero values
+    explicit Vector(size_t count);
+
+    Vector(const Vector& other);
 
-    // Creates a new vector instance of count with values. Initializing a vector of size 0 returns NULL.
-    static Vector *new_vector(NSUInteger count, const CGFloat *values);
+    // Creates a vector of count with values, zero when values is NULL. Initializing a vector of size 0 returns an empty vector.
+    static Vector new_vector(NSUInteger count, const CGFloat *values);
 
-    // Creates a new vector given a pointer to another. Can return NULL.
-    static Vector *new_vector(const Vector * const other);
+    // Creates a vector given a pointer to another. Returns an empty vector for NULL.
+    static Vector new_vector(const Vector * const other);
 
     // Creates a variable size vector given a static vector and count.
-    static Vector *new_vector(NSUInteger count, Vector4r vec);
+    static Vector new_vector(NSUInteger count, Vector4r vec);
 
     // Size of vector
     NSUInteger size() const { return _count; }
@@ -319,46 +564,50 @@ namespace POP {
     Vector4r vector4r() const;
 
     // CGFloat support
-    static Vector *new_cg_float(CGFloat f);
+    static Vector new_cg_float(CGFloat f);
 
     // CGPoint support
     CGPoint cg_point() const;
-    static Vector *new_cg_point(const CGPoint &p);
+    static Vector new_cg_point(const CGPoint &p);
 
     // CGSize support
     CGSize cg_size() const;
-    static Vector *new_cg_size(const CGSize &s);
+    static Vector new_cg_size(const CGSize &s);
 
     // CGRect support
     CGRect cg_rect() const;
-    static Vector *new_cg_rect(const CGRect &r);
+    static Vector new_cg_rect(const CGRect &r);
 
 #if TARGET_OS_IPHONE
     // UIEdgeInsets support
     UIEdgeInsets ui_edge_insets() const;
-    static Vector *new_ui_edge_insets(const UIEdgeInsets &i);
+    static Vector new_ui_edge_insets(const UIEdgeInsets &i);
 #endif
 
     // CGAffineTransform support
     CGAffineTransform cg_affine_transform() const;
-    static Vector *new_cg_affine_transform(const CGAffineTransform &t);
+    static Vector new_cg_affine_transform(const CGAffineTransform &t);
 
     // CGColorRef support
     CGColorRef cg_color() const CF_RETURNS_RETAINED;
-    static Vector *new_cg_color(CGColorRef color);
+    static Vector new_cg_color(CGColorRef color);
 
 #if SCENEKIT_SDK_AVAILABLE
     // SCNVector3 support
     SCNVector3 scn_vector3() const;
-    static Vector *new_scn_vector3(const SCNVector3 &vec3);
+    static Vector new_scn_vector3(const SCNVector3 &vec3);
 
     // SCNVector4 support
     SCNVector4 scn_vector4() const;
-    static Vector *new_scn_vector4(const SCNVector4 &vec4);
+    static Vector new_scn_vector4(const SCNVector4 &vec4);
 #endif
 
     // operator overloads
-    CGFloat &operator[](size_t i) const {
+    CGFloat &operator[](size_t i) {
+      NSCAssert(size() > i, @"unexpected vector size:%lu", (unsigned long)size());
+      return _values[i];
+    }
+    const CGFloat &operator[](size_t i) const {
       NSCAssert(size() > i, @"unexpected vector size:%lu", (unsigned long)size());
       return _values[i];
     }
@@ -382,14 +631,39 @@ namespace POP {
       return *this;
     }
     Vector& operator= (const Vector& other);
-    void swap(Vector &first, Vector &second);
     bool operator==(const Vector &other) const;
     bool operator!=(const Vector &other) const;
   };
 
-  /** Convenience typedefs */
-  typedef std::shared_ptr<Vector> VectorRef;
-  typedef std::shared_ptr<const Vector> VectorConstRef;
+  /**
+   Optional vector, stored inline; an empty vector is NULL.
+   Keeps the pointer interface of formerly shared, heap allocated vectors. Copies are deep and never allocate.
+   */
+  class VectorRef
+  {
+    Vector _vector;
+
+  public:
+    VectorRef() {}
+    VectorRef(std::nullptr_t) {}
+    VectorRef(const Vector &vector) : _vector(vector) {}
+
+    // Returns the vector, or NULL when empty
+    Vector *get() { return 0 != _vector.size() ? &_vector : NULL; }
+    const Vector *get() const { return 0 != _vector.size() ? &_vector : NULL; }
+
+    Vector *operator->() { return &_vector; }
+    const Vector *operator->() const { return &_vector; }
+    Vector &operator*() { return _vector; }
+    const Vector &operator*() const { return _vector; }
+
+    explicit operator bool() const { return 0 != _vector.size(); }
+  };
+
+  inline bool operator==(const VectorRef &vec, std::nullptr_t) { return !vec; }
+  inline bool operator==(std::nullptr_t, const VectorRef &vec) { return !vec; }
+  inline bool operator!=(const VectorRef &vec, std::nullptr_t) { return (bool)vec; }
+  inline bool operator!=(std::nullptr_t, const VectorRef &vec) { return (bool)vec; }
 
 }
 #endif /* __cplusplus */
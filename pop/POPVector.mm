@@ -18,39 +18,21 @@ namespace POP
 
   Vector::Vector(const size_t count)
   {
-    _count = count;
-    _values = 0 != count ? (CGFloat *)calloc(count, sizeof(CGFloat)) : NULL;
+    NSCAssert(count <= kCapacity, @"unexpected count %lu", (unsigned long)count);
+    _count = MIN(count, kCapacity);
+    memset(_values, 0, _count * sizeof(CGFloat));
   }
 
   Vector::Vector(const Vector& other)
   {
     _count = other.size();
-    _values = 0 != _count ? (CGFloat *)calloc(_count, sizeof(CGFloat)) : NULL;
-    if (0 != _count) {
-      memcpy(_values, other.data(), _count * sizeof(CGFloat));
-    }
-  }
-
-  Vector::~Vector()
-  {
-    if (NULL != _values) {
-      free(_values);
-      _values = NULL;
-    }
-    _count = 0;
-  }
-
-  void Vector::swap(Vector &first, Vector &second)
-  {
-    using std::swap;
-    swap(first._count, second._count);
-    swap(first._values, second._values);
+    memcpy(_values, other.data(), _count * sizeof(CGFloat));
   }
 
   Vector& Vector::operator=(const Vector& other)
   {
-    Vector temp(other);
-    swap(*this, temp);
+    _count = other.size();
+    memmove(_values, other.data(), _count * sizeof(CGFloat));
     return *this;
   }
 
@@ -71,54 +53,34 @@ namespace POP
   }
 
   bool Vector::operator!=(const Vector &other) const {
-    if (_count == other.size()) {
-      return false;
-    }
-
-    const CGFloat * const values = other.data();
-
-    for (NSUInteger idx = 0; idx < _count; idx++) {
-      if (_values[idx] != values[idx]) {
-        return false;
-      }
-    }
-
-    return true;
+    return !(*this == other);
   }
 
-  Vector *Vector::new_vector(NSUInteger count, const CGFloat *values)
+  Vector Vector::new_vector(NSUInteger count, const CGFloat *values)
   {
-    if (0 == count) {
-      return NULL;
-    }
-
-    Vector *v = new Vector(count);
+    Vector v(count);
     if (NULL != values) {
-      memcpy(v->_values, values, count * sizeof(CGFloat));
+      memcpy(v._values, values, v._count * sizeof(CGFloat));
     }
     return v;
   }
 
-  Vector *Vector::new_vector(const Vector * const other)
+  Vector Vector::new_vector(const Vector * const other)
   {
     if (NULL == other) {
-      return NULL;
+      return Vector();
     }
 
-    return Vector::new_vector(other->size(), other->data());
+    return *other;
   }
 
-  Vector *Vector::new_vector(NSUInteger count, Vector4r vec)
+  Vector Vector::new_vector(NSUInteger count, Vector4r vec)
   {
-    if (0 == count) {
-      return NULL;
-    }
-
-    Vector *v = new Vector(count);
+    Vector v(count);
 
     NSCAssert(count <= 4, @"unexpected count %lu", (unsigned long)count);
     for (NSUInteger i = 0; i < MIN(count, (NSUInteger)4); i++) {
-      v->_values[i] = vec[i];
+      v._values[i] = vec[i];
     }
 
     return v;
@@ -141,10 +103,10 @@ namespace POP
     return v;
   }
 
-  Vector *Vector::new_cg_float(CGFloat f)
+  Vector Vector::new_cg_float(CGFloat f)
   {
-    Vector *v = new Vector(1);
-    v->_values[0] = f;
+    Vector v(1);
+    v._values[0] = f;
     return v;
   }
 
@@ -154,11 +116,11 @@ namespace POP
     return CGPointMake(v(0), v(1));
   }
 
-  Vector *Vector::new_cg_point(const CGPoint &p)
+  Vector Vector::new_cg_point(const CGPoint &p)
   {
-    Vector *v = new Vector(2);
-    v->_values[0] = p.x;
-    v->_values[1] = p.y;
+    Vector v(2);
+    v._values[0] = p.x;
+    v._values[1] = p.y;
     return v;
   }
 
@@ -168,11 +130,11 @@ namespace POP
     return CGSizeMake(v(0), v(1));
   }
 
-  Vector *Vector::new_cg_size(const CGSize &s)
+  Vector Vector::new_cg_size(const CGSize &s)
   {
-    Vector *v = new Vector(2);
-    v->_values[0] = s.width;
-    v->_values[1] = s.height;
+    Vector v(2);
+    v._values[0] = s.width;
+    v._values[1] = s.height;
     return v;
   }
 
@@ -181,13 +143,13 @@ namespace POP
     return _count < 4 ? CGRectZero : CGRectMake(_values[0], _values[1], _values[2], _values[3]);
   }
 
-  Vector *Vector::new_cg_rect(const CGRect &r)
+  Vector Vector::new_cg_rect(const CGRect &r)
   {
-    Vector *v = new Vector(4);
-    v->_values[0] = r.origin.x;
-    v->_values[1] = r.origin.y;
-    v->_values[2] = r.size.width;
-    v->_values[3] = r.size.height;
+    Vector v(4);
+    v._values[0] = r.origin.x;
+    v._values[1] = r.origin.y;
+    v._values[2] = r.size.width;
+    v._values[3] = r.size.height;
     return v;
   }
 
@@ -198,13 +160,13 @@ namespace POP
     return _count < 4 ? UIEdgeInsetsZero : UIEdgeInsetsMake(_values[0], _values[1], _values[2], _values[3]);
   }
 
-  Vector *Vector::new_ui_edge_insets(const UIEdgeInsets &i)
+  Vector Vector::new_ui_edge_insets(const UIEdgeInsets &i)
   {
-    Vector *v = new Vector(4);
-    v->_values[0] = i.top;
-    v->_values[1] = i.left;
-    v->_values[2] = i.bottom;
-    v->_values[3] = i.right;
+    Vector v(4);
+    v._values[0] = i.top;
+    v._values[1] = i.left;
+    v._values[2] = i.bottom;
+    v._values[3] = i.right;
     return v;
   }
 
@@ -227,15 +189,15 @@ namespace POP
     return t;
   }
 
-  Vector *Vector::new_cg_affine_transform(const CGAffineTransform &t)
+  Vector Vector::new_cg_affine_transform(const CGAffineTransform &t)
   {
-    Vector *v = new Vector(6);
-    v->_values[0] = t.a;
-    v->_values[1] = t.b;
-    v->_values[2] = t.c;
-    v->_values[3] = t.d;
-    v->_values[4] = t.tx;
-    v->_values[5] = t.ty;
+    Vector v(6);
+    v._values[0] = t.a;
+    v._values[1] = t.b;
+    v._values[2] = t.c;
+    v._values[3] = t.d;
+    v._values[4] = t.tx;
+    v._values[5] = t.ty;
     return v;
   }
 
@@ -247,7 +209,7 @@ namespace POP
     return POPCGColorRGBACreate(_values);
   }
 
-  Vector *Vector::new_cg_color(CGColorRef color)
+  Vector Vector::new_cg_color(CGColorRef color)
   {
     CGFloat rgba[4];
     POPCGColorGetRGBAComponents(color, rgba);
@@ -260,12 +222,12 @@ namespace POP
     return _count < 3 ? SCNVector3Make(0.0, 0.0, 0.0) : SCNVector3Make(_values[0], _values[1], _values[2]);
   }
 
-  Vector *Vector::new_scn_vector3(const SCNVector3 &vec3)
+  Vector Vector::new_scn_vector3(const SCNVector3 &vec3)
   {
-    Vector *v = new Vector(3);
-    v->_values[0] = vec3.x;
-    v->_values[1] = vec3.y;
-    v->_values[2] = vec3.z;
+    Vector v(3);
+    v._values[0] = vec3.x;
+    v._values[1] = vec3.y;
+    v._values[2] = vec3.z;
     return v;
   }
 
@@ -274,13 +236,13 @@ namespace POP
     return _count < 4 ? SCNVector4Make(0.0, 0.0, 0.0, 0.0) : SCNVector4Make(_values[0], _values[1], _values[2], _values[3]);
   }
 
-  Vector *Vector::new_scn_vector4(const SCNVector4 &vec4)
+  Vector Vector::new_scn_vector4(const SCNVector4 &vec4)
   {
-    Vector *v = new Vector(4);
-    v->_values[0] = vec4.x;
-    v->_values[1] = vec4.y;
-    v->_values[2] = vec4.z;
-    v->_values[3] = vec4.w;
+    Vector v(4);
+    v._values[0] = vec4.x;
+    v._values[1] = vec4.y;
+    v._values[2] = vec4.z;
+    v._values[3] = vec4.w;
     return v;
   }
 #endif
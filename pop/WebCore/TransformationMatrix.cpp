@@ -30,6 +30,19 @@
 
 #include "FloatConversion.h"
 
+#if !defined(POP_TRANSFORM_NO_SIMD)
+#if defined(__AVX__)
+#include <immintrin.h>
+#define POP_TRANSFORM_AVX 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define POP_TRANSFORM_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define POP_TRANSFORM_NEON 1
+#endif
+#endif
+
 inline double deg2rad(double d)  { return d * M_PI / 180.0; }
 inline double rad2deg(double r)  { return r * 180.0 / M_PI; }
 inline double deg2grad(double d) { return d * 400.0 / 360.0; }
@@ -208,7 +221,7 @@ namespace WebCore {
   }
   
   // Returns false if the matrix is not invertible
-  static bool inverse(const TransformationMatrix::Matrix4& matrix, TransformationMatrix::Matrix4& result)
+  bool TransformationMatrix::inverseMatrix4Scalar(const Matrix4& matrix, Matrix4& result)
   {
     // Calculate the adjoint matrix
     adjoint(matrix, result);
@@ -236,7 +249,7 @@ namespace WebCore {
   // From Graphics Gems: unmatrix.c
   
   // Transpose rotation portion of matrix a, return b
-  static void transposeMatrix4(const TransformationMatrix::Matrix4& a, TransformationMatrix::Matrix4& b)
+  void TransformationMatrix::transposeMatrix4Scalar(const Matrix4& a, Matrix4& b)
   {
     for (int i = 0; i < 4; i++)
       for (int j = 0; j < 4; j++)
@@ -244,7 +257,7 @@ namespace WebCore {
   }
   
   // Multiply a homogeneous point by a matrix and return the transformed point
-  static void v4MulPointByMatrix(const Vector4 p, const TransformationMatrix::Matrix4& m, Vector4 result)
+  void TransformationMatrix::mapPoint4Scalar(const double p[4], const Matrix4& m, double result[4])
   {
     result[0] = (p[0] * m[0][0]) + (p[1] * m[1][0]) +
     (p[2] * m[2][0]) + (p[3] * m[3][0]);
@@ -256,6 +269,169 @@ namespace WebCore {
     (p[2] * m[2][3]) + (p[3] * m[3][3]);
   }
   
+  void TransformationMatrix::multiplyMatrix4Scalar(const Matrix4& a, const Matrix4& b, Matrix4& result)
+  {
+    for (int i = 0; i < 4; i++)
+      for (int j = 0; j < 4; j++)
+        result[i][j] = (a[i][0] * b[0][j] + a[i][1] * b[1][j]
+                        + a[i][2] * b[2][j] + a[i][3] * b[3][j]);
+  }
+  
+  //
+  // Vectorized kernels
+  //
+  // Each matrix row is one vector of four doubles: products are sums of rows scaled by broadcast elements,
+  // summed in the order of the scalar versions. Inversion expands cofactors over the 2x2 minors of the row pairs
+  // and combines them a row at a time; matrices with a determinant under SMALL_NUMBER take the scalar path.
+  
+#if POP_TRANSFORM_AVX
+  typedef __m256d Row4;
+  static inline Row4 rowLoad(const double* p) { return _mm256_loadu_pd(p); }
+  static inline void rowStore(double* p, Row4 r) { _mm256_storeu_pd(p, r); }
+  static inline Row4 rowSplat(double s) { return _mm256_set1_pd(s); }
+  static inline Row4 rowSet(double x, double y, double z, double w) { return _mm256_set_pd(w, z, y, x); }
+  static inline Row4 rowAdd(Row4 a, Row4 b) { return _mm256_add_pd(a, b); }
+  static inline Row4 rowSub(Row4 a, Row4 b) { return _mm256_sub_pd(a, b); }
+  static inline Row4 rowMul(Row4 a, Row4 b) { return _mm256_mul_pd(a, b); }
+#elif POP_TRANSFORM_SSE2
+  struct Row4 { __m128d lo, hi; };
+  static inline Row4 rowLoad(const double* p) { Row4 r = {_mm_loadu_pd(p), _mm_loadu_pd(p + 2)}; return r; }
+  static inline void rowStore(double* p, Row4 r) { _mm_storeu_pd(p, r.lo); _mm_storeu_pd(p + 2, r.hi); }
+  static inline Row4 rowSplat(double s) { Row4 r = {_mm_set1_pd(s), _mm_set1_pd(s)}; return r; }
+  static inline Row4 rowSet(double x, double y, double z, double w) { Row4 r = {_mm_set_pd(y, x), _mm_set_pd(w, z)}; return r; }
+  static inline Row4 rowAdd(Row4 a, Row4 b) { Row4 r = {_mm_add_pd(a.lo, b.lo), _mm_add_pd(a.hi, b.hi)}; return r; }
+  static inline Row4 rowSub(Row4 a, Row4 b) { Row4 r = {_mm_sub_pd(a.lo, b.lo), _mm_sub_pd(a.hi, b.hi)}; return r; }
+  static inline Row4 rowMul(Row4 a, Row4 b) { Row4 r = {_mm_mul_pd(a.lo, b.lo), _mm_mul_pd(a.hi, b.hi)}; return r; }
+#elif POP_TRANSFORM_NEON
+  struct Row4 { float64x2_t lo, hi; };
+  static inline Row4 rowLoad(const double* p) { Row4 r = {vld1q_f64(p), vld1q_f64(p + 2)}; return r; }
+  static inline void rowStore(double* p, Row4 r) { vst1q_f64(p, r.lo); vst1q_f64(p + 2, r.hi); }
+  static inline Row4 rowSplat(double s) { Row4 r = {vdupq_n_f64(s), vdupq_n_f64(s)}; return r; }
+  static inline Row4 rowSet(double x, double y, double z, double w) { Row4 r = {vcombine_f64(vdup_n_f64(x), vdup_n_f64(y)), vcombine_f64(vdup_n_f64(z), vdup_n_f64(w))}; return r; }
+  static inline Row4 rowAdd(Row4 a, Row4 b) { Row4 r = {vaddq_f64(a.lo, b.lo), vaddq_f64(a.hi, b.hi)}; return r; }
+  static inline Row4 rowSub(Row4 a, Row4 b) { Row4 r = {vsubq_f64(a.lo, b.lo), vsubq_f64(a.hi, b.hi)}; return r; }
+  static inline Row4 rowMul(Row4 a, Row4 b) { Row4 r = {vmulq_f64(a.lo, b.lo), vmulq_f64(a.hi, b.hi)}; return r; }
+#endif
+  
+#if POP_TRANSFORM_AVX || POP_TRANSFORM_SSE2 || POP_TRANSFORM_NEON
+  // sum of the rows of m scaled by the elements of p
+  static inline Row4 rowCombine(const double p[4], const TransformationMatrix::Matrix4& m)
+  {
+    Row4 r = rowMul(rowSplat(p[0]), rowLoad(m[0]));
+    r = rowAdd(r, rowMul(rowSplat(p[1]), rowLoad(m[1])));
+    r = rowAdd(r, rowMul(rowSplat(p[2]), rowLoad(m[2])));
+    return rowAdd(r, rowMul(rowSplat(p[3]), rowLoad(m[3])));
+  }
+  
+  void TransformationMatrix::multiplyMatrix4(const Matrix4& a, const Matrix4& b, Matrix4& result)
+  {
+    Row4 r0 = rowCombine(a[0], b), r1 = rowCombine(a[1], b), r2 = rowCombine(a[2], b), r3 = rowCombine(a[3], b);
+    rowStore(result[0], r0);
+    rowStore(result[1], r1);
+    rowStore(result[2], r2);
+    rowStore(result[3], r3);
+  }
+  
+  void TransformationMatrix::mapPoint4(const double p[4], const Matrix4& m, double result[4])
+  {
+    rowStore(result, rowCombine(p, m));
+  }
+  
+  void TransformationMatrix::transposeMatrix4(const Matrix4& a, Matrix4& b)
+  {
+#if POP_TRANSFORM_AVX
+    __m256d r0 = _mm256_loadu_pd(a[0]), r1 = _mm256_loadu_pd(a[1]), r2 = _mm256_loadu_pd(a[2]), r3 = _mm256_loadu_pd(a[3]);
+    __m256d t0 = _mm256_unpacklo_pd(r0, r1); // a00 a10 a02 a12
+    __m256d t1 = _mm256_unpackhi_pd(r0, r1); // a01 a11 a03 a13
+    __m256d t2 = _mm256_unpacklo_pd(r2, r3); // a20 a30 a22 a32
+    __m256d t3 = _mm256_unpackhi_pd(r2, r3); // a21 a31 a23 a33
+    _mm256_storeu_pd(b[0], _mm256_permute2f128_pd(t0, t2, 0x20));
+    _mm256_storeu_pd(b[1], _mm256_permute2f128_pd(t1, t3, 0x20));
+    _mm256_storeu_pd(b[2], _mm256_permute2f128_pd(t0, t2, 0x31));
+    _mm256_storeu_pd(b[3], _mm256_permute2f128_pd(t1, t3, 0x31));
+#else
+    // transpose each 2x2 block, swapping the off diagonal ones
+    for (int i = 0; i < 4; i += 2) {
+      for (int j = 0; j < 4; j += 2) {
+#if POP_TRANSFORM_SSE2
+        __m128d u = _mm_loadu_pd(&a[i][j]), v = _mm_loadu_pd(&a[i + 1][j]);
+        _mm_storeu_pd(&b[j][i], _mm_unpacklo_pd(u, v));
+        _mm_storeu_pd(&b[j + 1][i], _mm_unpackhi_pd(u, v));
+#else
+        float64x2_t u = vld1q_f64(&a[i][j]), v = vld1q_f64(&a[i + 1][j]);
+        vst1q_f64(&b[j][i], vzip1q_f64(u, v));
+        vst1q_f64(&b[j + 1][i], vzip2q_f64(u, v));
+#endif
+      }
+    }
+#endif
+  }
+  
+  bool TransformationMatrix::inverseMatrix4(const Matrix4& m, Matrix4& result)
+  {
+    // 2x2 minors of the upper and lower row pairs, shared by all cofactors
+    double s0 = m[0][0] * m[1][1] - m[1][0] * m[0][1];
+    double s1 = m[0][0] * m[1][2] - m[1][0] * m[0][2];
+    double s2 = m[0][0] * m[1][3] - m[1][0] * m[0][3];
+    double s3 = m[0][1] * m[1][2] - m[1][1] * m[0][2];
+    double s4 = m[0][1] * m[1][3] - m[1][1] * m[0][3];
+    double s5 = m[0][2] * m[1][3] - m[1][2] * m[0][3];
+    
+    double c0 = m[2][0] * m[3][1] - m[3][0] * m[2][1];
+    double c1 = m[2][0] * m[3][2] - m[3][0] * m[2][2];
+    double c2 = m[2][0] * m[3][3] - m[3][0] * m[2][3];
+    double c3 = m[2][1] * m[3][2] - m[3][1] * m[2][2];
+    double c4 = m[2][1] * m[3][3] - m[3][1] * m[2][3];
+    double c5 = m[2][2] * m[3][3] - m[3][2] * m[2][3];
+    
+    double det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+    
+    // keep the scalar results, including its adjoint, for singular matrices
+    if (fabs(det) < SMALL_NUMBER)
+      return inverseMatrix4Scalar(m, result);
+    
+    // each row of the adjoint is three rows of matrix elements scaled by minors
+    Row4 c5s5 = rowSet(c5, c5, s5, s5), c4s4 = rowSet(c4, c4, s4, s4), c3s3 = rowSet(c3, c3, s3, s3);
+    Row4 c2s2 = rowSet(c2, c2, s2, s2), c1s1 = rowSet(c1, c1, s1, s1), c0s0 = rowSet(c0, c0, s0, s0);
+    Row4 col0 = rowSet(m[1][0], -m[0][0], m[3][0], -m[2][0]);
+    Row4 col1 = rowSet(m[1][1], -m[0][1], m[3][1], -m[2][1]);
+    Row4 col2 = rowSet(m[1][2], -m[0][2], m[3][2], -m[2][2]);
+    Row4 col3 = rowSet(m[1][3], -m[0][3], m[3][3], -m[2][3]);
+    Row4 scale = rowSplat(1 / det);
+    
+    Row4 r0 = rowAdd(rowSub(rowMul(col1, c5s5), rowMul(col2, c4s4)), rowMul(col3, c3s3));
+    Row4 r1 = rowAdd(rowSub(rowMul(col2, c2s2), rowMul(col0, c5s5)), rowMul(rowSub(rowSplat(0), col3), c1s1));
+    Row4 r2 = rowAdd(rowSub(rowMul(col0, c4s4), rowMul(col1, c2s2)), rowMul(col3, c0s0));
+    Row4 r3 = rowAdd(rowSub(rowMul(col1, c1s1), rowMul(col0, c3s3)), rowMul(rowSub(rowSplat(0), col2), c0s0));
+    
+    rowStore(result[0], rowMul(r0, scale));
+    rowStore(result[1], rowMul(r1, scale));
+    rowStore(result[2], rowMul(r2, scale));
+    rowStore(result[3], rowMul(r3, scale));
+    return true;
+  }
+#else
+  void TransformationMatrix::multiplyMatrix4(const Matrix4& a, const Matrix4& b, Matrix4& result)
+  {
+    multiplyMatrix4Scalar(a, b, result);
+  }
+  
+  void TransformationMatrix::mapPoint4(const double p[4], const Matrix4& m, double result[4])
+  {
+    mapPoint4Scalar(p, m, result);
+  }
+  
+  void TransformationMatrix::transposeMatrix4(const Matrix4& a, Matrix4& b)
+  {
+    transposeMatrix4Scalar(a, b);
+  }
+  
+  bool TransformationMatrix::inverseMatrix4(const Matrix4& matrix, Matrix4& result)
+  {
+    return inverseMatrix4Scalar(matrix, result);
+  }
+#endif
+  
   static double v3Length(Vector3 a)
   {
     return sqrt((a[0] * a[0]) + (a[1] * a[1]) + (a[2] * a[2]));
@@ -294,71 +470,15 @@ namespace WebCore {
     result[2] = (a[0] * b[1]) - (a[1] * b[0]);
   }
   
-  static bool decompose(const TransformationMatrix::Matrix4& mat, TransformationMatrix::DecomposedType& result)
+  // Decomposes a normalized matrix without perspective, after the perspective partition is solved.
+  static void decomposeTranslationScaleShearRotation(const TransformationMatrix::Matrix4& localMatrix, TransformationMatrix::DecomposedType& result)
   {
-    TransformationMatrix::Matrix4 localMatrix;
-    memcpy(localMatrix, mat, sizeof(TransformationMatrix::Matrix4));
-    
-    // Normalize the matrix.
-    if (localMatrix[3][3] == 0)
-      return false;
-    
-    int i, j;
-    for (i = 0; i < 4; i++)
-      for (j = 0; j < 4; j++)
-        localMatrix[i][j] /= localMatrix[3][3];
-    
-    // perspectiveMatrix is used to solve for perspective, but it also provides
-    // an easy way to test for singularity of the upper 3x3 component.
-    TransformationMatrix::Matrix4 perspectiveMatrix;
-    memcpy(perspectiveMatrix, localMatrix, sizeof(TransformationMatrix::Matrix4));
-    for (i = 0; i < 3; i++)
-      perspectiveMatrix[i][3] = 0;
-    perspectiveMatrix[3][3] = 1;
-    
-    if (determinant4x4(perspectiveMatrix) == 0)
-      return false;
-    
-    // First, isolate perspective.  This is the messiest.
-    if (localMatrix[0][3] != 0 || localMatrix[1][3] != 0 || localMatrix[2][3] != 0) {
-      // rightHandSide is the right hand side of the equation.
-      Vector4 rightHandSide;
-      rightHandSide[0] = localMatrix[0][3];
-      rightHandSide[1] = localMatrix[1][3];
-      rightHandSide[2] = localMatrix[2][3];
-      rightHandSide[3] = localMatrix[3][3];
-      
-      // Solve the equation by inverting perspectiveMatrix and multiplying
-      // rightHandSide by the inverse.  (This is the easiest way, not
-      // necessarily the best.)
-      TransformationMatrix::Matrix4 inversePerspectiveMatrix, transposedInversePerspectiveMatrix;
-      inverse(perspectiveMatrix, inversePerspectiveMatrix);
-      transposeMatrix4(inversePerspectiveMatrix, transposedInversePerspectiveMatrix);
-      
-      Vector4 perspectivePoint;
-      v4MulPointByMatrix(rightHandSide, transposedInversePerspectiveMatrix, perspectivePoint);
-      
-      result.perspectiveX = perspectivePoint[0];
-      result.perspectiveY = perspectivePoint[1];
-      result.perspectiveZ = perspectivePoint[2];
-      result.perspectiveW = perspectivePoint[3];
-      
-      // Clear the perspective partition
-      localMatrix[0][3] = localMatrix[1][3] = localMatrix[2][3] = 0;
-      localMatrix[3][3] = 1;
-    } else {
-      // No perspective.
-      result.perspectiveX = result.perspectiveY = result.perspectiveZ = 0;
-      result.perspectiveW = 1;
-    }
+    int i;
     
     // Next take care of translation (easy).
     result.translateX = localMatrix[3][0];
-    localMatrix[3][0] = 0;
     result.translateY = localMatrix[3][1];
-    localMatrix[3][1] = 0;
     result.translateZ = localMatrix[3][2];
-    localMatrix[3][2] = 0;
     
     // Vector4 type and functions need to be added to the common set.
     Vector3 row[3], pdum3;
@@ -457,7 +577,82 @@ namespace WebCore {
     result.quaternionY = y;
     result.quaternionZ = z;
     result.quaternionW = w;
+  }
+  
+  static bool decompose(const TransformationMatrix::Matrix4& mat, TransformationMatrix::DecomposedType& result)
+  {
+    TransformationMatrix::Matrix4 localMatrix;
+    memcpy(localMatrix, mat, sizeof(TransformationMatrix::Matrix4));
+    
+    // Normalize the matrix.
+    if (localMatrix[3][3] == 0)
+      return false;
+    
+    int i, j;
+    for (i = 0; i < 4; i++)
+      for (j = 0; j < 4; j++)
+        localMatrix[i][j] /= localMatrix[3][3];
+    
+    // perspectiveMatrix is used to solve for perspective, but it also provides
+    // an easy way to test for singularity of the upper 3x3 component.
+    TransformationMatrix::Matrix4 perspectiveMatrix;
+    memcpy(perspectiveMatrix, localMatrix, sizeof(TransformationMatrix::Matrix4));
+    for (i = 0; i < 3; i++)
+      perspectiveMatrix[i][3] = 0;
+    perspectiveMatrix[3][3] = 1;
+    
+    if (determinant4x4(perspectiveMatrix) == 0)
+      return false;
+    
+    // First, isolate perspective.  This is the messiest.
+    if (localMatrix[0][3] != 0 || localMatrix[1][3] != 0 || localMatrix[2][3] != 0) {
+      // rightHandSide is the right hand side of the equation.
+      Vector4 rightHandSide;
+      rightHandSide[0] = localMatrix[0][3];
+      rightHandSide[1] = localMatrix[1][3];
+      rightHandSide[2] = localMatrix[2][3];
+      rightHandSide[3] = localMatrix[3][3];
+      
+      // Solve the equation by inverting perspectiveMatrix and multiplying
+      // rightHandSide by the inverse.  (This is the easiest way, not
+      // necessarily the best.)
+      TransformationMatrix::Matrix4 inversePerspectiveMatrix, transposedInversePerspectiveMatrix;
+      TransformationMatrix::inverseMatrix4(perspectiveMatrix, inversePerspectiveMatrix);
+      TransformationMatrix::transposeMatrix4(inversePerspectiveMatrix, transposedInversePerspectiveMatrix);
+      
+      Vector4 perspectivePoint;
+      TransformationMatrix::mapPoint4(rightHandSide, transposedInversePerspectiveMatrix, perspectivePoint);
+      
+      result.perspectiveX = perspectivePoint[0];
+      result.perspectiveY = perspectivePoint[1];
+      result.perspectiveZ = perspectivePoint[2];
+      result.perspectiveW = perspectivePoint[3];
+      
+      // Clear the perspective partition
+      localMatrix[0][3] = localMatrix[1][3] = localMatrix[2][3] = 0;
+      localMatrix[3][3] = 1;
+    } else {
+      // No perspective.
+      result.perspectiveX = result.perspectiveY = result.perspectiveZ = 0;
+      result.perspectiveW = 1;
+    }
     
+    decomposeTranslationScaleShearRotation(localMatrix, result);
+    return true;
+  }
+  
+  // Decomposition of a 2D affine matrix, agreeing exactly with decompose. Such a matrix is already normalized
+  // and has no perspective partition, and its upper 3x3 component is singular only when its upper 2x2 one is;
+  // this skips the normalization, the 4x4 determinant and the perspective solve.
+  static bool decomposeAffine(const TransformationMatrix::Matrix4& mat, TransformationMatrix::DecomposedType& result)
+  {
+    if (determinant2x2(mat[0][0], mat[0][1], mat[1][0], mat[1][1]) == 0)
+      return false;
+    
+    result.perspectiveX = result.perspectiveY = result.perspectiveZ = 0;
+    result.perspectiveW = 1;
+    
+    decomposeTranslationScaleShearRotation(mat, result);
     return true;
   }
   
@@ -841,42 +1036,7 @@ namespace WebCore {
   TransformationMatrix& TransformationMatrix::multiply(const TransformationMatrix& mat)
   {
     Matrix4 tmp;
-    
-    tmp[0][0] = (mat.m_matrix[0][0] * m_matrix[0][0] + mat.m_matrix[0][1] * m_matrix[1][0]
-                 + mat.m_matrix[0][2] * m_matrix[2][0] + mat.m_matrix[0][3] * m_matrix[3][0]);
-    tmp[0][1] = (mat.m_matrix[0][0] * m_matrix[0][1] + mat.m_matrix[0][1] * m_matrix[1][1]
-                 + mat.m_matrix[0][2] * m_matrix[2][1] + mat.m_matrix[0][3] * m_matrix[3][1]);
-    tmp[0][2] = (mat.m_matrix[0][0] * m_matrix[0][2] + mat.m_matrix[0][1] * m_matrix[1][2]
-                 + mat.m_matrix[0][2] * m_matrix[2][2] + mat.m_matrix[0][3] * m_matrix[3][2]);
-    tmp[0][3] = (mat.m_matrix[0][0] * m_matrix[0][3] + mat.m_matrix[0][1] * m_matrix[1][3]
-                 + mat.m_matrix[0][2] * m_matrix[2][3] + mat.m_matrix[0][3] * m_matrix[3][3]);
-    
-    tmp[1][0] = (mat.m_matrix[1][0] * m_matrix[0][0] + mat.m_matrix[1][1] * m_matrix[1][0]
-                 + mat.m_matrix[1][2] * m_matrix[2][0] + mat.m_matrix[1][3] * m_matrix[3][0]);
-    tmp[1][1] = (mat.m_matrix[1][0] * m_matrix[0][1] + mat.m_matrix[1][1] * m_matrix[1][1]
-                 + mat.m_matrix[1][2] * m_matrix[2][1] + mat.m_matrix[1][3] * m_matrix[3][1]);
-    tmp[1][2] = (mat.m_matrix[1][0] * m_matrix[0][2] + mat.m_matrix[1][1] * m_matrix[1][2]
-                 + mat.m_matrix[1][2] * m_matrix[2][2] + mat.m_matrix[1][3] * m_matrix[3][2]);
-    tmp[1][3] = (mat.m_matrix[1][0] * m_matrix[0][3] + mat.m_matrix[1][1] * m_matrix[1][3]
-                 + mat.m_matrix[1][2] * m_matrix[2][3] + mat.m_matrix[1][3] * m_matrix[3][3]);
-    
-    tmp[2][0] = (mat.m_matrix[2][0] * m_matrix[0][0] + mat.m_matrix[2][1] * m_matrix[1][0]
-                 + mat.m_matrix[2][2] * m_matrix[2][0] + mat.m_matrix[2][3] * m_matrix[3][0]);
-    tmp[2][1] = (mat.m_matrix[2][0] * m_matrix[0][1] + mat.m_matrix[2][1] * m_matrix[1][1]
-                 + mat.m_matrix[2][2] * m_matrix[2][1] + mat.m_matrix[2][3] * m_matrix[3][1]);
-    tmp[2][2] = (mat.m_matrix[2][0] * m_matrix[0][2] + mat.m_matrix[2][1] * m_matrix[1][2]
-                 + mat.m_matrix[2][2] * m_matrix[2][2] + mat.m_matrix[2][3] * m_matrix[3][2]);
-    tmp[2][3] = (mat.m_matrix[2][0] * m_matrix[0][3] + mat.m_matrix[2][1] * m_matrix[1][3]
-                 + mat.m_matrix[2][2] * m_matrix[2][3] + mat.m_matrix[2][3] * m_matrix[3][3]);
-    
-    tmp[3][0] = (mat.m_matrix[3][0] * m_matrix[0][0] + mat.m_matrix[3][1] * m_matrix[1][0]
-                 + mat.m_matrix[3][2] * m_matrix[2][0] + mat.m_matrix[3][3] * m_matrix[3][0]);
-    tmp[3][1] = (mat.m_matrix[3][0] * m_matrix[0][1] + mat.m_matrix[3][1] * m_matrix[1][1]
-                 + mat.m_matrix[3][2] * m_matrix[2][1] + mat.m_matrix[3][3] * m_matrix[3][1]);
-    tmp[3][2] = (mat.m_matrix[3][0] * m_matrix[0][2] + mat.m_matrix[3][1] * m_matrix[1][2]
-                 + mat.m_matrix[3][2] * m_matrix[2][2] + mat.m_matrix[3][3] * m_matrix[3][2]);
-    tmp[3][3] = (mat.m_matrix[3][0] * m_matrix[0][3] + mat.m_matrix[3][1] * m_matrix[1][3]
-                 + mat.m_matrix[3][2] * m_matrix[2][3] + mat.m_matrix[3][3] * m_matrix[3][3]);
+    multiplyMatrix4(mat.m_matrix, m_matrix, tmp);
     
     setMatrix(tmp);
     return *this;
@@ -934,7 +1094,7 @@ namespace WebCore {
     }
     
     TransformationMatrix invMat;
-    bool inverted = WebCore::inverse(m_matrix, invMat.m_matrix);
+    bool inverted = inverseMatrix4(m_matrix, invMat.m_matrix);
     if (!inverted)
       return TransformationMatrix();
     
@@ -1006,12 +1166,55 @@ namespace WebCore {
       decomp.scaleZ = 1;
     }
     
+    if (isAffine())
+      return decomposeAffine(m_matrix, decomp);
+    
     if (!WebCore::decompose(m_matrix, decomp))
       return false;
     return true;
   }
   
+  bool TransformationMatrix::decomposeGeneral(DecomposedType& decomp) const
+  {
+    return WebCore::decompose(m_matrix, decomp);
+  }
+  
   void TransformationMatrix::recompose(const DecomposedType& decomp, bool useEulerAngle)
+  {
+    // 2D affine decompositions: no perspective, z translation or z shear, and rotation about z only
+    bool affine = (decomp.perspectiveX == 0 && decomp.perspectiveY == 0 && decomp.perspectiveZ == 0 && decomp.perspectiveW == 1 &&
+                   decomp.translateZ == 0 && decomp.skewXZ == 0 && decomp.skewYZ == 0 &&
+                   (useEulerAngle ? (decomp.rotateX == 0 && decomp.rotateY == 0) : (decomp.quaternionX == 0 && decomp.quaternionY == 0)));
+    if (!affine) {
+      recomposeGeneral(decomp, useEulerAngle);
+      return;
+    }
+    
+    // the 2x2 rotation, as built by the general path
+    double r00, r01, r10, r11;
+    if (!useEulerAngle) {
+      double zz = decomp.quaternionZ * decomp.quaternionZ;
+      double zw = decomp.quaternionZ * decomp.quaternionW;
+      r00 = 1 - 2 * zz;
+      r01 = -(2 * zw);
+      r10 = 2 * zw;
+      r11 = 1 - 2 * zz;
+    } else {
+      double angle = deg2rad(rad2deg(decomp.rotateZ));
+      r00 = cos(angle);
+      r01 = sin(angle);
+      r10 = -r01;
+      r11 = r00;
+    }
+    
+    // scale, then skew, then rotate, then translate
+    setMatrix(decomp.scaleX * r00, decomp.scaleX * r01,
+              decomp.scaleY * (r10 + decomp.skewXY * r00), decomp.scaleY * (r11 + decomp.skewXY * r01),
+              decomp.translateX, decomp.translateY);
+    m_matrix[2][2] = decomp.scaleZ;
+  }
+  
+  void TransformationMatrix::recomposeGeneral(const DecomposedType& decomp, bool useEulerAngle)
   {
     makeIdentity();
     
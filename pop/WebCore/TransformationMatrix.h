@@ -190,9 +190,32 @@ namespace WebCore {
       double perspectiveX, perspectiveY, perspectiveZ, perspectiveW;
     } DecomposedType;
     
+    // 4x4 kernels, vectorized with AVX, SSE2 or NEON when available; the scalar versions are their fallback
+    // and reference. Define POP_TRANSFORM_NO_SIMD to always use the scalar versions.
+    
+    // result = a * b
+    static void multiplyMatrix4(const Matrix4& a, const Matrix4& b, Matrix4& result);
+    static void multiplyMatrix4Scalar(const Matrix4& a, const Matrix4& b, Matrix4& result);
+    
+    // Returns false if the matrix is not invertible
+    static bool inverseMatrix4(const Matrix4& matrix, Matrix4& result);
+    static bool inverseMatrix4Scalar(const Matrix4& matrix, Matrix4& result);
+    
+    static void transposeMatrix4(const Matrix4& a, Matrix4& b);
+    static void transposeMatrix4Scalar(const Matrix4& a, Matrix4& b);
+    
+    // result = p * m, of a homogeneous point
+    static void mapPoint4(const double p[4], const Matrix4& m, double result[4]);
+    static void mapPoint4Scalar(const double p[4], const Matrix4& m, double result[4]);
+    
+    // 2D affine matrices and decompositions take a closed form path
     bool decompose(DecomposedType& decomp) const;
     void recompose(const DecomposedType& decomp, bool useEulerAngle = false);
 
+    // always the general 4x4 algorithm, the reference of the affine path
+    bool decomposeGeneral(DecomposedType& decomp) const;
+    void recomposeGeneral(const DecomposedType& decomp, bool useEulerAngle = false);
+
     void blend(const TransformationMatrix& from, double progress);
 
     bool isAffine() const